@@ -0,0 +1,49 @@
+#ifndef LAB4_SEM3_BENCH_H
+#define LAB4_SEM3_BENCH_H
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Время выполнения func в миллисекундах (лучшее из repeats запусков)
+template<class Func>
+double measure(Func &&func, int repeats = 3) {
+    double best = -1;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto finish = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::milli>(finish - start).count();
+        if (best < 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+// Печатает строку результата: имя замера, время и пропускную способность
+inline void report(const std::string &name, double milliseconds, long long operations = 0) {
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << milliseconds << " ms";
+    if (operations > 0 && milliseconds > 0) {
+        std::cout << std::setw(14) << std::setprecision(1) << operations / milliseconds / 1000.0 << " Mops/s";
+    }
+    std::cout << std::endl;
+}
+
+// Группы замеров; scale — множитель размера входных данных
+void runDynamicArrayBenchmarks(int scale);
+void runAvlTreeBenchmarks(int scale);
+void runShortestPathBenchmarks(int scale);
+void runContractionHierarchyBenchmarks(int scale);
+void runAllPairsBenchmarks(int scale);
+void runIncrementalShortestPathBenchmarks(int scale);
+void runTimeDependentBenchmarks(int scale);
+void runSccBenchmarks(int scale);
+void runReachabilityBenchmarks(int scale);
+void runConnectedComponentsBenchmarks(int scale);
+void runMstBenchmarks(int scale);
+void runColoringBenchmarks(int scale);
+
+#endif //LAB4_SEM3_BENCH_H
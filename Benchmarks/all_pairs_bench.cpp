@@ -0,0 +1,70 @@
+#include <thread>
+#include "Bench.h"
+#include "../include/graph_structures/AllPairsShortestPaths.h"
+#include "../include/graph_structures/CSRGraph.h"
+#include "../include/graph_structures/GraphGenerator.h"
+#include "../include/graph_structures/ShortestPath.h"
+
+// Матрицы расстояний: цикл ShortestPath::dijkstra по источникам против AllPairsShortestPaths
+void runAllPairsBenchmarks(int scale) {
+    unsigned hardware = std::thread::hardware_concurrency();
+    unsigned threadCounts[] = {1u, hardware > 1 ? hardware : 2u};
+    long long checksum = 0;
+
+    // Разреженный случайный граф: средняя степень 8
+    const int sparseVertices = 4000 * scale;
+    CSRGraph<int> sparse(GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, sparseVertices,
+                                                               8.0 / (sparseVertices - 1), 100));
+    long long pairs = (long long) sparseVertices * sparseVertices;
+
+    double ms = measure([&] {
+        for (int source = 0; source < sparseVertices; ++source) {
+            auto result = ShortestPath<int>::dijkstra(sparse, source);
+            checksum += result[sparseVertices - 1 - source].first;
+        }
+    }, 1);
+    report("loop of dijkstra, sparse " + std::to_string(sparseVertices), ms, pairs);
+
+    for (unsigned threads : threadCounts) {
+        ThreadPool pool(threads);
+        ms = measure([&] {
+            auto matrix = AllPairsShortestPaths<int>::allPairs(sparse, pool, AllPairsShortestPaths<int>::DIJKSTRA);
+            checksum += matrix.get(0, sparseVertices - 1);
+        }, 1);
+        report("allPairs DIJKSTRA, " + std::to_string(threads) + " threads", ms, pairs);
+    }
+
+    // Полный граф GraphGenerator::COMPLETE
+    const int denseVertices = 1000 * scale;
+    CSRGraph<int> dense(GraphGenerator::generateUndirectedGraph(GraphGenerator::COMPLETE, denseVertices, 1, 100));
+    pairs = (long long) denseVertices * denseVertices;
+
+    for (unsigned threads : threadCounts) {
+        ThreadPool pool(threads);
+        ms = measure([&] {
+            auto matrix = AllPairsShortestPaths<int>::allPairs(dense, pool, AllPairsShortestPaths<int>::DIJKSTRA);
+            checksum += matrix.get(0, denseVertices - 1);
+        }, 1);
+        report("allPairs DIJKSTRA, complete, " + std::to_string(threads) + " threads", ms, pairs);
+    }
+
+    ThreadPool single(1);
+    ms = measure([&] {
+        auto matrix = AllPairsShortestPaths<int>::floydWarshall(dense, single, denseVertices);
+        checksum += matrix.get(0, denseVertices - 1);
+    }, 1);
+    report("floydWarshall, one block (plain triple loop)", ms, pairs);
+
+    for (unsigned threads : threadCounts) {
+        ThreadPool pool(threads);
+        ms = measure([&] {
+            auto matrix = AllPairsShortestPaths<int>::floydWarshall(dense, pool);
+            checksum += matrix.get(0, denseVertices - 1);
+        }, 1);
+        report("floydWarshall, 256x256 blocks, " + std::to_string(threads) + " threads", ms, pairs);
+    }
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
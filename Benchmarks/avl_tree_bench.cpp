@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "Bench.h"
+#include "../include/data_structures/AVLBinaryTree.h"
+#include "../include/data_structures/IDictionaryBinaryTree.h"
+#include "../include/data_structures/ISetBinaryTree.h"
+#include "../include/graph_structures/DirectedGraph.h"
+
+// Полный обход AVL-дерева и словаря на его основе (1M ключей при scale = 1)
+void runAvlTreeBenchmarks(int scale) {
+    const int count = 1000000 * scale;
+
+    std::vector<int> keys(count);
+    for (int i = 0; i < count; ++i) {
+        keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+    AVLBinaryTree<int> tree;
+    double ms = measure([&] {
+        tree.clear();
+        for (int key : keys) {
+            tree.insert(key);
+        }
+    }, 1);
+    report("AVLBinaryTree<int>::insert (random order)", ms, count);
+
+    long long sum = 0;
+    ms = measure([&] {
+        sum = 0;
+        for (int value : tree) {
+            sum += value;
+        }
+    });
+    report("AVLBinaryTree<int> full in-order scan", ms, count);
+
+    const int queries = 100000;
+    ms = measure([&] {
+        for (int i = 0; i < queries; ++i) {
+            sum += tree.select(keys[i]);
+        }
+    });
+    report("AVLBinaryTree<int>::select (random index)", ms, queries);
+
+    // Узлы, вставленные по возрастанию, лежат в пуле подряд: замер без промахов кэша
+    AVLBinaryTree<int> sortedTree;
+    for (int i = 0; i < count; ++i) {
+        sortedTree.insert(i);
+    }
+    ms = measure([&] {
+        for (int value : sortedTree) {
+            sum += value;
+        }
+    });
+    report("AVLBinaryTree<int> scan (sequential layout)", ms, count);
+
+    IDictionaryBinaryTree<int, int> dictionary;
+    for (int key : keys) {
+        dictionary.Add(key, key);
+    }
+    ms = measure([&] {
+        sum += dictionary.GetKeys().getLength();
+    });
+    report("IDictionaryBinaryTree<int, int>::GetKeys", ms, count);
+
+    ms = measure([&] {
+        AVLBinaryTree<int> built;
+        built.buildSorted(count, [](int i) { return i; });
+        sum += built.getSize();
+    });
+    report("AVLBinaryTree<int>::buildSorted", ms, count);
+
+    ms = measure([&] {
+        DirectedGraph<int> graph(count);
+        sum += graph.getVertexCount();
+    });
+    report("DirectedGraph<int>(vertices) construction", ms, count);
+
+    // Пересечение двух множеств по count элементов (половина общих)
+    ArraySequence<int> evens, multiplesOfThree;
+    for (int i = 0; i < count; ++i) {
+        evens.append(i * 2);
+        multiplesOfThree.append(i * 3);
+    }
+    ISetBinaryTree<int> first(evens), second(multiplesOfThree);
+    ms = measure([&] {
+        AVLBinaryTree<int> result;
+        for (int value : first) {
+            if (second.find(value)) result.insert(value);
+        }
+        sum += result.getSize();
+    }, 1);
+    report("Set intersection, find + insert per element", ms, 2LL * count);
+
+    ms = measure([&] {
+        ISet<int> *result = first.intersection(second);
+        sum += result->size();
+        delete result;
+    }, 1);
+    report("ISetBinaryTree::intersection", ms, 2LL * count);
+
+    ms = measure([&] {
+        AVLBinaryTree<int> result;
+        for (int value : first) result.insert(value);
+        for (int value : second) {
+            if (!result.find(value)) result.insert(value);
+        }
+        sum += result.getSize();
+    }, 1);
+    report("Set union, find + insert per element", ms, 2LL * count);
+
+    ms = measure([&] {
+        ISet<int> *result = first.setUnion(second);
+        sum += result->size();
+        delete result;
+    }, 1);
+    report("ISetBinaryTree::setUnion (join-based)", ms, 2LL * count);
+
+    if (sum == 0) {
+        std::cout << "unexpected empty scan" << std::endl;
+    }
+}
@@ -0,0 +1,77 @@
+#include <thread>
+#include "Bench.h"
+#include "../include/graph_structures/CSRGraph.h"
+#include "../include/graph_structures/GraphColoring.h"
+#include "../include/graph_structures/GraphGenerator.h"
+
+// Жадная раскраска: прежняя реализация против битовых наборов и разных порядков обхода
+void runColoringBenchmarks(int scale) {
+    long long checksum = 0;
+
+    // Прежний путь: массив доступных цветов длины n заново на каждую вершину — O(n^2)
+    {
+        const int vertices = 20000 * scale;
+        UndirectedGraph<int> graph = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, vertices,
+                                                                             20.0 / (vertices - 1), 10);
+        double ms = measure([&] {
+            const int n = graph.getVertexCount();
+            ArraySequence<int> result(-1, n);
+            for (int u = 0; u < n; ++u) {
+                ArraySequence<bool> available(true, n);
+                graph.forEachNeighbor(u, [&](int neighbor, const int &) {
+                    if (result[neighbor] != -1) available[result[neighbor]] = false;
+                });
+                int color = 0;
+                while (color < n && !available[color]) ++color;
+                result[u] = color;
+            }
+            checksum += GraphColoring::colorCount(result);
+        }, 1);
+        report("per-vertex available[n], " + std::to_string(vertices) + " vertices", ms, vertices);
+
+        CSRGraph<int> csr(graph);
+        ms = measure([&] {
+            checksum += GraphColoring::colorCount(GraphColoring::greedyColoring(csr));
+        });
+        report("bitset scratch, " + std::to_string(vertices) + " vertices", ms, vertices);
+    }
+
+    const int vertices = 200000 * scale;
+    CSRGraph<int> graph(GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, vertices,
+                                                                40.0 / (vertices - 1), 10));
+    struct Variant {
+        const char *name;
+        GraphColoring::Ordering ordering;
+    };
+    for (const Variant &variant : {Variant{"natural", GraphColoring::NATURAL},
+                                   Variant{"largest-first", GraphColoring::LARGEST_FIRST},
+                                   Variant{"smallest-last", GraphColoring::SMALLEST_LAST}}) {
+        int colors = 0;
+        double ms = measure([&] {
+            colors = GraphColoring::colorCount(GraphColoring::greedyColoring(graph, variant.ordering));
+        });
+        checksum += colors;
+        report(std::string(variant.name) + ", " + std::to_string(colors) + " colors", ms, vertices);
+    }
+    int colors = 0;
+    double ms = measure([&] {
+        colors = GraphColoring::colorCount(GraphColoring::dsatur(graph));
+    });
+    checksum += colors;
+    report("dsatur, " + std::to_string(colors) + " colors", ms, vertices);
+
+    // Спекулятивная параллельная раскраска: от 1 потока до числа ядер (и не меньше 4)
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned threads = 1; threads <= std::max(hardware, 4u); threads *= 2) {
+        ThreadPool pool(threads);
+        ms = measure([&] {
+            auto coloring = GraphColoring::speculativeColoring(graph, pool);
+            colors = GraphColoring::isValidColoring(graph, coloring) ? GraphColoring::colorCount(coloring) : -1;
+        });
+        checksum += colors;
+        report("speculative, " + std::to_string(threads) + " threads, " + std::to_string(colors) + " colors",
+               ms, vertices);
+    }
+
+    std::cout << "checksum " << checksum << std::endl;
+}
@@ -0,0 +1,105 @@
+#include <random>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "../include/graph_structures/CSRGraph.h"
+#include "../include/graph_structures/ConnectedComponents.h"
+#include "../include/graph_structures/DynamicConnectivity.h"
+#include "../include/graph_structures/GraphGenerator.h"
+
+// Компоненты связности: DisjointSet, параллельное подвешивание и поток рёбер без графа
+void runConnectedComponentsBenchmarks(int scale) {
+    const int vertices = 1000000 * scale;
+    long long checksum = 0;
+
+    // Средняя степень 2: около 20% вершин вне гигантской компоненты
+    UndirectedGraph<int> graph(1);
+    double ms = measure([&] {
+        graph = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, vertices, 2.0 / (vertices - 1), 10);
+    }, 1);
+    report("GraphGenerator RANDOM (undirected, avg degree 2)", ms);
+    CSRGraph<int> csr(graph);
+    long long edges = csr.getEdgeCount() / 2;
+
+    ms = measure([&] {
+        checksum += ConnectedComponents::findComponents(graph).getLength();
+    }, 1);
+    report("findComponents, UndirectedGraph", ms, edges);
+
+    ms = measure([&] {
+        checksum += ConnectedComponents::findComponentIds(csr).componentCount;
+    });
+    report("findComponentIds, CSRGraph", ms, edges);
+
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned threads : {1u, hardware > 1 ? hardware : 2u}) {
+        ThreadPool pool(threads);
+        ms = measure([&] {
+            checksum += ConnectedComponents::findComponentIdsParallel(csr, pool).componentCount;
+        });
+        report("findComponentIdsParallel, " + std::to_string(threads) + " threads", ms, edges);
+    }
+
+    // Поток рёбер: граф не строится, рёбра берутся из плоского списка
+    std::vector<std::pair<int, int>> edgeList;
+    for (int u = 0; u < vertices; ++u) {
+        for (int e = csr.rowBegin(u); e < csr.rowEnd(u); ++e) {
+            if (u < csr.getTarget(e)) edgeList.emplace_back(u, csr.getTarget(e));
+        }
+    }
+    ms = measure([&] {
+        EdgeStreamComponents stream;
+        for (const auto &edge : edgeList) {
+            stream.addEdge(edge.first, edge.second);
+        }
+        checksum += stream.getComponentCount();
+    });
+    report("EdgeStreamComponents, " + std::to_string(edgeList.size()) + " edges", ms, edges);
+
+    // Полностью динамическая связность: вставки и удаления против пересчёта с нуля после каждого изменения
+    const int dynamicVertices = 100000 * scale;
+    const int updates = 200000;
+    std::mt19937 random(3);
+    std::vector<std::pair<int, int>> present;
+    DynamicConnectivity connectivity(dynamicVertices);
+    for (int i = 0; i < dynamicVertices; ++i) {
+        int u = int(random() % dynamicVertices);
+        int v = int(random() % dynamicVertices);
+        if (u != v && !connectivity.hasEdge(u, v)) {
+            connectivity.addEdge(u, v);
+            present.emplace_back(u, v);
+        }
+    }
+    ms = measure([&] {
+        for (int i = 0; i < updates; ++i) {
+            if (i % 2 == 0) {
+                int index = int(random() % present.size());
+                connectivity.removeEdge(present[index].first, present[index].second);
+                present[index] = present.back();
+                present.pop_back();
+            } else {
+                int u = int(random() % dynamicVertices);
+                int v = int(random() % dynamicVertices);
+                if (u == v || connectivity.hasEdge(u, v)) continue;
+                connectivity.addEdge(u, v);
+                present.emplace_back(u, v);
+            }
+            checksum += connectivity.getComponentCount();
+        }
+    }, 1);
+    report("DynamicConnectivity, " + std::to_string(updates) + " updates (levels: "
+           + std::to_string(connectivity.getLevelCount()) + ")", ms, updates);
+
+    ms = measure([&] {
+        EdgeStreamComponents stream(dynamicVertices);
+        for (const auto &edge : present) {
+            stream.addEdge(edge.first, edge.second);
+        }
+        checksum += stream.getComponentCount();
+    });
+    report("recompute from scratch (one update, same graph)", ms, int(present.size()));
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
@@ -0,0 +1,46 @@
+#include <vector>
+#include "Bench.h"
+#include "../include/sequence/ArraySequence.h"
+
+// Пропускная способность append для плоских и вложенных ArraySequence
+void runDynamicArrayBenchmarks(int scale) {
+    const int count = 1000000 * scale;
+    const int outerCount = 20000 * scale;
+    const int innerCount = 50;
+
+    double ms = measure([&] {
+        ArraySequence<int> sequence;
+        for (int i = 0; i < count; ++i) {
+            sequence.append(i);
+        }
+    });
+    report("ArraySequence<int>::append", ms, count);
+
+    ms = measure([&] {
+        std::vector<int> vector;
+        for (int i = 0; i < count; ++i) {
+            vector.push_back(i);
+        }
+    });
+    report("std::vector<int>::push_back (reference)", ms, count);
+
+    ms = measure([&] {
+        ArraySequence<ArraySequence<int>> nested;
+        for (int i = 0; i < outerCount; ++i) {
+            ArraySequence<int> inner;
+            for (int j = 0; j < innerCount; ++j) {
+                inner.append(j);
+            }
+            nested.append(inner);
+        }
+    });
+    report("ArraySequence<ArraySequence<int>>::append", ms, outerCount);
+
+    ms = measure([&] {
+        ArraySequence<Pair<int, int>> pairs;
+        for (int i = 0; i < count; ++i) {
+            pairs.append(Pair<int, int>(i, i));
+        }
+    });
+    report("ArraySequence<Pair<int, int>>::append", ms, count);
+}
@@ -0,0 +1,46 @@
+#include <cstdlib>
+#include <cstring>
+#include "Bench.h"
+
+struct BenchmarkGroup {
+    const char *name;
+    void (*run)(int scale);
+};
+
+static const BenchmarkGroup groups[] = {
+        {"dynamic_array", runDynamicArrayBenchmarks},
+        {"avl_tree", runAvlTreeBenchmarks},
+        {"shortest_path", runShortestPathBenchmarks},
+        {"contraction_hierarchy", runContractionHierarchyBenchmarks},
+        {"all_pairs", runAllPairsBenchmarks},
+        {"incremental_shortest_path", runIncrementalShortestPathBenchmarks},
+        {"time_dependent", runTimeDependentBenchmarks},
+        {"scc", runSccBenchmarks},
+        {"reachability", runReachabilityBenchmarks},
+        {"connected_components", runConnectedComponentsBenchmarks},
+        {"mst", runMstBenchmarks},
+        {"coloring", runColoringBenchmarks},
+};
+
+int main(int argc, char **argv) {
+    const char *filter = argc > 1 ? argv[1] : "all";
+    int scale = argc > 2 ? std::atoi(argv[2]) : 1;
+    if (scale <= 0) {
+        std::cerr << "Scale must be positive" << std::endl;
+        return 1;
+    }
+
+    bool found = false;
+    for (const auto &group : groups) {
+        if (std::strcmp(filter, "all") == 0 || std::strcmp(filter, group.name) == 0) {
+            std::cout << "== " << group.name << " (scale " << scale << ") ==" << std::endl;
+            group.run(scale);
+            found = true;
+        }
+    }
+    if (!found) {
+        std::cerr << "Unknown benchmark group: " << filter << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <memory>
+#include <random>
+#include <thread>
+#include "Bench.h"
+#include "../include/graph_structures/CSRGraph.h"
+#include "../include/graph_structures/DynamicMinimumSpanningTree.h"
+#include "../include/graph_structures/GraphGenerator.h"
+#include "../include/graph_structures/MinimumSpanningTree.h"
+#include "../include/graph_structures/QuickSorter.h"
+
+// Минимальный остов: Крускал, Filter-Kruskal и параллельный Борувка на одном графе
+void runMstBenchmarks(int scale) {
+    const int vertices = 200000 * scale;
+    long long checksum = 0;
+    auto totalWeight = [](const ArraySequence<std::tuple<int, int, int>> &edges) {
+        long long total = 0;
+        for (int i = 0; i < edges.getLength(); ++i) {
+            total += std::get<2>(edges[i]);
+        }
+        return total;
+    };
+
+    // Средняя степень 20, веса до 10^6
+    CSRGraph<int> graph(GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, vertices,
+                                                                20.0 / (vertices - 1), 1000000));
+    long long edges = graph.getEdgeCount() / 2;
+
+    // Прежний путь kruskal: getEdges и рекурсивный QuickSorter
+    double ms = measure([&] {
+        auto list = graph.getEdges();
+        QuickSorter<std::tuple<int, int, int>> sorter([](const std::tuple<int, int, int> &a,
+                                                         const std::tuple<int, int, int> &b) {
+            return std::get<2>(a) < std::get<2>(b);
+        });
+        sorter.sort(&list);
+        checksum += std::get<2>(list[0]);
+    }, 1);
+    report("getEdges + QuickSorter (sort only)", ms, edges);
+
+    ms = measure([&] {
+        checksum += totalWeight(MinimumSpanningTree<int>::kruskal(graph));
+    });
+    report("kruskal", ms, edges);
+
+    ms = measure([&] {
+        checksum += totalWeight(MinimumSpanningTree<int>::filterKruskal(graph));
+    });
+    report("filterKruskal", ms, edges);
+
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned threads : {1u, hardware > 1 ? hardware : 2u}) {
+        ThreadPool pool(threads);
+        ms = measure([&] {
+            checksum += totalWeight(MinimumSpanningTree<int>::boruvka(graph, pool));
+        });
+        report("boruvka, " + std::to_string(threads) + " threads", ms, edges);
+    }
+
+    // Прим против Крускала: от SPARSE (дерево) через случайные графы к COMPLETE
+    const int primVertices = 2000 * scale;
+    struct Input {
+        std::string name;
+        GraphGenerator::GraphType type;
+        double density;
+    };
+    const Input inputs[] = {
+            {"SPARSE", GraphGenerator::SPARSE, 0},
+            {"RANDOM 0.01", GraphGenerator::RANDOM, 0.01},
+            {"RANDOM 0.1", GraphGenerator::RANDOM, 0.1},
+            {"RANDOM 0.5", GraphGenerator::RANDOM, 0.5},
+            {"COMPLETE", GraphGenerator::COMPLETE, 1},
+    };
+    for (const auto &input : inputs) {
+        CSRGraph<int> frozen(GraphGenerator::generateUndirectedGraph(input.type, primVertices, input.density, 1000000));
+        long long count = frozen.getEdgeCount() / 2;
+        std::cout << "-- " << input.name << ", " << primVertices << " vertices, " << count << " edges" << std::endl;
+
+        ms = measure([&] { checksum += totalWeight(MinimumSpanningTree<int>::kruskal(frozen)); });
+        report("kruskal", ms, count);
+        ms = measure([&] { checksum += totalWeight(MinimumSpanningTree<int>::filterKruskal(frozen)); });
+        report("filterKruskal", ms, count);
+        ms = measure([&] { checksum += totalWeight(MinimumSpanningTree<int>::primHeap(frozen)); });
+        report("primHeap", ms, count);
+        ms = measure([&] { checksum += totalWeight(MinimumSpanningTree<int>::primDense(frozen)); });
+        report("primDense", ms, count);
+        ms = measure([&] { checksum += totalWeight(MinimumSpanningTree<int>::prim(frozen)); });
+        report("prim (automatic choice)", ms, count);
+    }
+
+    // Динамический остов: изменения весов против пересчёта kruskal после каждого изменения
+    const int dynamicVertices = 100000 * scale;
+    const int updates = 100000;
+    CSRGraph<int> live(GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, dynamicVertices,
+                                                               10.0 / (dynamicVertices - 1), 1000000));
+    std::vector<std::pair<int, int>> liveEdges;
+    for (int u = 0; u < dynamicVertices; ++u) {
+        for (int e = live.rowBegin(u); e < live.rowEnd(u); ++e) {
+            if (u < live.getTarget(e)) liveEdges.emplace_back(u, live.getTarget(e));
+        }
+    }
+    std::unique_ptr<DynamicMinimumSpanningTree<int>> tree;
+    ms = measure([&] { tree = std::make_unique<DynamicMinimumSpanningTree<int>>(live); }, 1);
+    report("DynamicMinimumSpanningTree, build", ms, (long long) liveEdges.size());
+
+    std::mt19937 random(5);
+    ms = measure([&] {
+        for (int i = 0; i < updates; ++i) {
+            const auto &edge = liveEdges[random() % liveEdges.size()];
+            tree->updateWeight(edge.first, edge.second, int(random() % 1000000));
+            checksum += tree->getTotalWeight() & 1;
+        }
+    }, 1);
+    report("updateWeight, " + std::to_string(updates) + " random updates", ms, updates);
+
+    ms = measure([&] { checksum += totalWeight(MinimumSpanningTree<int>::filterKruskal(live)); });
+    report("filterKruskal recompute (one update)", ms, (long long) liveEdges.size());
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
@@ -0,0 +1,115 @@
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "../include/graph_structures/CSRGraph.h"
+#include "../include/graph_structures/GraphGenerator.h"
+#include "../include/graph_structures/ReachabilityIndex.h"
+#include "../include/graph_structures/StronglyConnectedComponents.h"
+
+// Сильно связанные компоненты: последовательный Тарьян против forward-backward на пуле потоков
+static void compareScc(const std::string &name, const CSRGraph<int> &graph, long long &checksum) {
+    long long edges = graph.getEdgeCount();
+    double ms = measure([&] {
+        checksum += StronglyConnectedComponents<int>::findComponentIds(graph).componentCount;
+    });
+    report(name + ": findComponentIds", ms, edges);
+
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned threads : {1u, hardware > 1 ? hardware : 2u}) {
+        ThreadPool pool(threads);
+        ms = measure([&] {
+            checksum += StronglyConnectedComponents<int>::findComponentIdsParallel(graph, pool).componentCount;
+        });
+        report(name + ": parallel, " + std::to_string(threads) + " threads", ms, edges);
+    }
+}
+
+void runSccBenchmarks(int scale) {
+    long long checksum = 0;
+
+    // GraphGenerator::RANDOM со средней степенью 4: гигантская компонента и много одиночных вершин
+    const int vertices = 1000000 * scale;
+    CSRGraph<int> random(GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, vertices,
+                                                               4.0 / (vertices - 1), 10));
+    compareScc("RANDOM", random, checksum);
+
+    // Много циклов по 100 вершин, соединённых рёбрами «вперёд»: компоненты нетривиальны, обрезка не помогает
+    const int cycleLength = 100;
+    DirectedGraph<int> cycles(vertices);
+    for (int v = 0; v < vertices; ++v) {
+        cycles.addEdge(v, v % cycleLength == cycleLength - 1 ? v - cycleLength + 1 : v + 1, 1);
+        if (v + 3 * cycleLength / 2 < vertices) cycles.addEdge(v, v + 3 * cycleLength / 2, 1);
+    }
+    compareScc("cycles of 100", CSRGraph<int>(cycles), checksum);
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
+
+// Запросы достижимости: ReachabilityIndex против обхода в ширину на каждый запрос
+void runReachabilityBenchmarks(int scale) {
+    const int vertices = 1000000 * scale;
+    long long checksum = 0;
+    // Средняя степень 1.2: гигантской компоненты нет, конденсация почти совпадает с графом
+    CSRGraph<int> graph(GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, vertices,
+                                                              1.2 / (vertices - 1), 10));
+
+    std::unique_ptr<ReachabilityIndex<int>> index;
+    double ms = measure([&] {
+        index = std::make_unique<ReachabilityIndex<int>>(graph);
+    }, 1);
+    report("ReachabilityIndex build", ms, graph.getEdgeCount());
+    std::cout << "  components: " << index->getComponentCount()
+              << ", condensation edges: " << index->getCondensationEdgeCount() << std::endl;
+
+    const int queries = 1000000;
+    std::mt19937 random(3);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    std::vector<int> sources(queries), targets(queries);
+    for (int i = 0; i < queries; ++i) {
+        sources[i] = vertex(random);
+        targets[i] = vertex(random);
+    }
+
+    long long positive = 0;
+    ms = measure([&] {
+        positive = 0;
+        for (int i = 0; i < queries; ++i) {
+            positive += index->reachable(sources[i], targets[i]);
+        }
+    });
+    report("reachable, " + std::to_string(queries) + " random queries", ms, queries);
+    // measure повторяет замер трижды
+    std::cout << "  reachable pairs: " << positive << ", queries answered by search: "
+              << 100.0 * index->getSearchCount() / (3.0 * queries) << "%" << std::endl;
+    checksum += positive;
+
+    const int slowQueries = 200;
+    std::vector<int> seen(vertices, -1);
+    ms = measure([&] {
+        for (int i = 0; i < slowQueries; ++i) {
+            std::vector<int> queue{sources[i]};
+            seen[sources[i]] = i;
+            bool found = false;
+            for (size_t head = 0; head < queue.size() && !found; ++head) {
+                for (int e = graph.rowBegin(queue[head]); e < graph.rowEnd(queue[head]); ++e) {
+                    int next = graph.getTarget(e);
+                    if (next == targets[i]) found = true;
+                    if (seen[next] != i) {
+                        seen[next] = i;
+                        queue.push_back(next);
+                    }
+                }
+            }
+            checksum += found;
+        }
+    }, 1);
+    report("breadth-first search, " + std::to_string(slowQueries) + " queries", ms, slowQueries);
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
@@ -0,0 +1,308 @@
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include "Bench.h"
+#include "../include/graph_structures/CSRGraph.h"
+#include "../include/graph_structures/ContractionHierarchy.h"
+#include "../include/graph_structures/DynamicWeightShortestPath.h"
+#include "../include/graph_structures/GraphGenerator.h"
+#include "../include/graph_structures/IncrementalShortestPath.h"
+#include "../include/graph_structures/LandmarkHeuristic.h"
+#include "../include/graph_structures/ShortestPath.h"
+#include "../include/graph_structures/TimeDependentShortestPath.h"
+
+// Dijkstra и delta-stepping на случайном графе GraphGenerator::RANDOM (1M вершин при scale = 1)
+void runShortestPathBenchmarks(int scale) {
+    const int vertices = 1000000 * scale;
+    const double averageDegree = 8;
+    const double density = averageDegree / (vertices - 1);
+
+    DirectedGraph<int> graph(1);
+    double ms = measure([&] {
+        graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, vertices, density, 100);
+    }, 1);
+    report("GraphGenerator RANDOM (directed, avg degree 8)", ms, (long long) (vertices * averageDegree));
+
+    CSRGraph<int> csr(graph);
+    long long edges = csr.getEdgeCount();
+    long long checksum = 0;
+
+    ms = measure([&] {
+        auto result = ShortestPath<int>::dijkstra(graph, 0);
+        checksum += result[vertices - 1].first;
+    }, 1);
+    report("dijkstra, DirectedGraph", ms, edges);
+
+    ms = measure([&] {
+        auto result = ShortestPath<int>::dijkstra(csr, 0);
+        checksum += result[vertices - 1].first;
+    });
+    report("dijkstra, CSRGraph", ms, edges);
+
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned threads : {1u, hardware > 1 ? hardware : 2u}) {
+        ms = measure([&] {
+            auto result = ShortestPath<int>::deltaStepping(csr, 0, 0, threads);
+            checksum += result[vertices - 1].first;
+        });
+        report("deltaStepping, CSRGraph, " + std::to_string(threads) + " threads", ms, edges);
+    }
+
+    // Запросы «точка-точка»: полный Дейкстра + getPath против поиска с ранней остановкой
+    const int queries = 20;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    int sources[queries], targets[queries];
+    for (int i = 0; i < queries; ++i) {
+        sources[i] = vertex(random);
+        targets[i] = vertex(random);
+    }
+    CSRGraph<int> reverse = csr.getTranspose();
+
+    ms = measure([&] {
+        for (int i = 0; i < queries; ++i) {
+            auto result = ShortestPath<int>::dijkstra(csr, sources[i]);
+            if (result[targets[i]].first != std::numeric_limits<int>::max()) {
+                checksum += ShortestPath<int>::getPath(result, targets[i]).getLength();
+            }
+        }
+    }, 1);
+    report("dijkstra + getPath, " + std::to_string(queries) + " queries", ms);
+
+    long long settled = 0;
+    ms = measure([&] {
+        settled = 0;
+        for (int i = 0; i < queries; ++i) {
+            auto result = ShortestPath<int>::aStar(csr, sources[i], targets[i], ShortestPath<int>::zeroHeuristic);
+            checksum += result.path.getLength();
+            settled += result.settled;
+        }
+    }, 1);
+    report("aStar (zero heuristic), " + std::to_string(queries) + " queries", ms);
+    std::cout << "  settled per query: " << settled / queries << std::endl;
+
+    ms = measure([&] {
+        settled = 0;
+        for (int i = 0; i < queries; ++i) {
+            auto result = ShortestPath<int>::bidirectionalDijkstra(csr, reverse, sources[i], targets[i]);
+            checksum += result.path.getLength();
+            settled += result.settled;
+        }
+    }, 1);
+    report("bidirectionalDijkstra, " + std::to_string(queries) + " queries", ms);
+    std::cout << "  settled per query: " << settled / queries << std::endl;
+
+    const int landmarkCount = 8;
+    std::unique_ptr<LandmarkHeuristic<int>> landmarks;
+    ms = measure([&] {
+        landmarks = std::make_unique<LandmarkHeuristic<int>>(csr, reverse, landmarkCount);
+    }, 1);
+    report("LandmarkHeuristic, " + std::to_string(landmarkCount) + " landmarks", ms);
+
+    ms = measure([&] {
+        settled = 0;
+        for (int i = 0; i < queries; ++i) {
+            landmarks->setTarget(targets[i]);
+            auto result = ShortestPath<int>::aStar(csr, sources[i], targets[i], *landmarks);
+            checksum += result.path.getLength();
+            settled += result.settled;
+        }
+    }, 1);
+    report("aStar (landmarks), " + std::to_string(queries) + " queries", ms);
+    std::cout << "  settled per query: " << settled / queries << std::endl;
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
+
+// Иерархия сжатий на решётке side x side (похожа на дорожную сеть) против поиска без предобработки
+void runContractionHierarchyBenchmarks(int scale) {
+    const int side = 300 * scale;
+    const int vertices = side * side;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> weight(1, 100);
+    DirectedGraph<int> graph(vertices);
+    for (int row = 0; row < side; ++row) {
+        for (int column = 0; column < side; ++column) {
+            int v = row * side + column;
+            if (column + 1 < side) {
+                graph.addEdge(v, v + 1, weight(random));
+                graph.addEdge(v + 1, v, weight(random));
+            }
+            if (row + 1 < side) {
+                graph.addEdge(v, v + side, weight(random));
+                graph.addEdge(v + side, v, weight(random));
+            }
+        }
+    }
+    CSRGraph<int> csr(graph);
+    CSRGraph<int> reverse = csr.getTranspose();
+
+    std::unique_ptr<ContractionHierarchy<int>> hierarchy;
+    double ms = measure([&] {
+        hierarchy = std::make_unique<ContractionHierarchy<int>>(csr);
+    }, 1);
+    report("ContractionHierarchy build, " + std::to_string(side) + "x" + std::to_string(side) + " grid", ms);
+    std::cout << "  shortcuts: " << hierarchy->getShortcutCount() << std::endl;
+
+    std::stringstream stream;
+    ms = measure([&] {
+        stream.str("");
+        hierarchy->save(stream);
+    });
+    report("save", ms);
+    std::cout << "  bytes: " << stream.str().size() << std::endl;
+    ms = measure([&] {
+        stream.seekg(0);
+        hierarchy = std::make_unique<ContractionHierarchy<int>>(ContractionHierarchy<int>::load(stream));
+    });
+    report("load", ms);
+
+    const int queries = 1000;
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    std::vector<int> sources(queries), targets(queries);
+    for (int i = 0; i < queries; ++i) {
+        sources[i] = vertex(random);
+        targets[i] = vertex(random);
+    }
+
+    long long checksum = 0;
+    long long settled = 0;
+    ms = measure([&] {
+        settled = 0;
+        for (int i = 0; i < queries; ++i) {
+            auto result = hierarchy->query(sources[i], targets[i]);
+            checksum += result.distance + result.path.getLength();
+            settled += result.settled;
+        }
+    });
+    report("ContractionHierarchy::query, " + std::to_string(queries) + " queries", ms);
+    std::cout << "  settled per query: " << settled / queries << std::endl;
+
+    ms = measure([&] {
+        for (int i = 0; i < queries; ++i) {
+            checksum += hierarchy->distance(sources[i], targets[i]);
+        }
+    });
+    report("ContractionHierarchy::distance, " + std::to_string(queries) + " queries", ms);
+
+    const int slowQueries = 50;
+    ms = measure([&] {
+        settled = 0;
+        for (int i = 0; i < slowQueries; ++i) {
+            auto result = ShortestPath<int>::bidirectionalDijkstra(csr, reverse, sources[i], targets[i]);
+            checksum += result.distance + result.path.getLength();
+            settled += result.settled;
+        }
+    }, 1);
+    report("bidirectionalDijkstra, " + std::to_string(slowQueries) + " queries", ms);
+    std::cout << "  settled per query: " << settled / slowQueries << std::endl;
+
+    ms = measure([&] {
+        for (int i = 0; i < slowQueries; ++i) {
+            auto result = ShortestPath<int>::dijkstra(csr, sources[i]);
+            checksum += ShortestPath<int>::getPath(result, targets[i]).getLength();
+        }
+    }, 1);
+    report("dijkstra + getPath, " + std::to_string(slowQueries) + " queries", ms);
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
+
+// Поток обновлений весов WeightUpdateModel: ремонт дерева IncrementalShortestPath против пересчёта
+void runIncrementalShortestPathBenchmarks(int scale) {
+    const int vertices = 200000 * scale;
+    const int batches = 20;
+    const int batchSize = 2000;
+    DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, vertices,
+                                                                     8.0 / (vertices - 1), 100);
+    CSRGraph<int> csr(graph);
+    long long checksum = 0;
+
+    std::unique_ptr<IncrementalShortestPath<int>> incremental;
+    double ms = measure([&] {
+        incremental = std::make_unique<IncrementalShortestPath<int>>(csr, 0);
+    }, 1);
+    report("IncrementalShortestPath build", ms);
+
+    ms = measure([&] {
+        checksum += ShortestPath<int>::dijkstra(csr, 0)[vertices - 1].first;
+    });
+    report("dijkstra from scratch (one recomputation)", ms);
+
+    WeightUpdateModel<int> model(csr, 1, 0.01, 0.3);
+    long long touched = 0;
+    ms = measure([&] {
+        for (int i = 0; i < batches; ++i) {
+            incremental->updateEdges(model.nextBatch(batchSize));
+            touched += incremental->getLastTouchedCount();
+            checksum += incremental->getDistance(vertices - 1);
+        }
+    }, 1);
+    report("updateEdges, " + std::to_string(batches) + " batches of " + std::to_string(batchSize), ms,
+           (long long) batches * batchSize);
+    std::cout << "  touched vertices per batch: " << touched / batches << std::endl;
+
+    ms = measure([&] {
+        for (int i = 0; i < 100; ++i) {
+            auto batch = model.nextBatch(1);
+            incremental->updateEdge(std::get<0>(batch[0]), std::get<1>(batch[0]), std::get<2>(batch[0]));
+        }
+    }, 1);
+    report("updateEdge, 100 single updates", ms, 100);
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
+
+// Поиск с наиболее ранним прибытием по профилям «час пик» против статического и «динамического» Дейкстры
+void runTimeDependentBenchmarks(int scale) {
+    const int vertices = 200000 * scale;
+    DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, vertices,
+                                                                     8.0 / (vertices - 1), 100);
+    CSRGraph<int> csr(graph);
+    long long checksum = 0;
+
+    // Время в минутах: утренний пик длиной от 200 до 320 минут, в середине пика проезд вдвое дольше
+    // (спад не круче наклона -1, так как веса не превышают 100)
+    std::unique_ptr<TimeDependentGraph<int>> timed;
+    double ms = measure([&] {
+        timed = std::make_unique<TimeDependentGraph<int>>(csr, [](int from, int to, int weight) {
+            int start = 360 + (from * 31 + to * 17) % 120;
+            int length = 200 + (from + to) % 120;
+            ArraySequence<Pair<int, int>> profile;
+            profile.append(Pair<int, int>(start, weight));
+            profile.append(Pair<int, int>(start + length / 2, 2 * weight));
+            profile.append(Pair<int, int>(start + length, weight));
+            return profile;
+        });
+    }, 1);
+    report("TimeDependentGraph build (3 breakpoints per edge)", ms, timed->getEdgeCount());
+
+    ms = measure([&] {
+        checksum += ShortestPath<int>::dijkstra(csr, 0)[vertices - 1].first;
+    });
+    report("dijkstra, static weights", ms, csr.getEdgeCount());
+
+    for (int departure : {0, 420, 480}) {
+        ms = measure([&] {
+            checksum += TimeDependentShortestPath<int>::earliestArrival(*timed, 0, departure)[vertices - 1].first;
+        });
+        report("earliestArrival, departure " + std::to_string(departure), ms, timed->getEdgeCount());
+    }
+
+    DynamicWeightShortestPath<int> dynamic(0.1, 1);
+    ms = measure([&] {
+        checksum += dynamic.dijkstra(csr, 0)[vertices - 1].first;
+    });
+    report("DynamicWeightShortestPath::dijkstra (wall clock)", ms, csr.getEdgeCount());
+
+    if (checksum == 0) {
+        std::cout << "unexpected zero checksum" << std::endl;
+    }
+}
@@ -97,6 +97,8 @@ void DirectedWindow::onGenerateGraph() {
 
     try {
         GraphType graphType = static_cast<GraphType>(graphTypeComboBox->currentData().toInt());
+        // Индекс прежнего графа недействителен, даже если генерация ниже завершится ошибкой
+        reachability.reset();
         originalGraph = DirectedGraph<int>(vertexCount);
 
         switch (graphType) {
@@ -129,6 +131,9 @@ void DirectedWindow::onGenerateGraph() {
             nodePositions.append(QPointF(x, y));
         }
 
+        // Индекс достижимости строится один раз на граф и отвечает «нет пути» без поиска
+        reachability = std::make_unique<ReachabilityIndex<int>>(originalGraph);
+
         drawGraph(originalScene, originalGraph);
         resultScene->clear();
 
@@ -146,6 +151,10 @@ void DirectedWindow::onRunAlgorithm() {
     AlgorithmType algorithmType = static_cast<AlgorithmType>(algorithmComboBox->currentData().toInt());
 
     try {
+        // Если генерация прервалась, индекс строится по текущему графу
+        if (!reachability) {
+            reachability = std::make_unique<ReachabilityIndex<int>>(originalGraph);
+        }
         switch (algorithmType) {
             case SHORTEST_PATH: {
                 bool ok;
@@ -159,14 +168,15 @@ void DirectedWindow::onRunAlgorithm() {
                                                   originalGraph.getVertexCount() - 1, 1, &ok);
                 if (!ok) return;
 
-                if (!checkPathExists(source, target)) {
-                    QMessageBox::warning(this, "Ошибка", "Между вершинами нет пути");
-                    return;
-                }
-
                 try {
-                    auto data = ShortestPath<int>::dijkstra(originalGraph, source);
-                    auto path = ShortestPath<int>::getPath(data, target);
+                    if (!reachability->reachable(source, target)) {
+                        QMessageBox::warning(this, "Ошибка", "Между вершинами нет пути");
+                        return;
+                    }
+                    // Поиск останавливается, как только извлечена целевая вершина
+                    auto result = ShortestPath<int>::aStar(originalGraph, source, target,
+                                                           ShortestPath<int>::zeroHeuristic);
+                    const auto &path = result.path;
 
                     resultScene->clear();
                     drawGraph(resultScene, originalGraph);
@@ -205,12 +215,12 @@ void DirectedWindow::onRunAlgorithm() {
                                                   originalGraph.getVertexCount() - 1, 1, &ok);
                 if (!ok) return;
 
-                if (!checkPathExists(source, target)) {
-                    QMessageBox::warning(this, "Ошибка", "Между вершинами нет пути");
-                    return;
-                }
-
                 try {
+                    if (!reachability->reachable(source, target)) {
+                        QMessageBox::warning(this, "Ошибка", "Путь не существует");
+                        return;
+                    }
+
                     // Create DynamicWeightShortestPath with time influence factor
                     DynamicWeightShortestPath<int> dynamicSP(0.1); // 10% increase per second
                     auto data = dynamicSP.dijkstra(originalGraph, source);
@@ -274,30 +284,6 @@ void DirectedWindow::onRunAlgorithm() {
     }
 }
 
-// Add implementation to DirectedWindow.cpp:
-bool DirectedWindow::checkPathExists(int source, int target) {
-    ArraySequence<bool> visited;
-    for (int i = 0; i < originalGraph.getVertexCount(); i++) {
-        visited.append(false);
-    }
-
-    std::function<bool(int)> dfs = [&](int v) -> bool {
-        if (v == target) return true;
-        visited[v] = true;
-
-        auto neighbors = originalGraph.getNeighbors(v);
-        for (int i = 0; i < neighbors.getLength(); i++) {
-            int next = neighbors[i].first;
-            if (!visited[next] && dfs(next)) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    return dfs(source);
-}
-
 
 void DirectedWindow::drawHighlightedEdge(QGraphicsScene *scene, int from, int to,
                                          const QString &weightLabel, const QColor &color) {
@@ -10,12 +10,14 @@
 #include <QPushButton>
 #include <QLineEdit>
 #include <QMessageBox>
+#include <memory>
 #include "graph_structures/DirectedGraph.h"
 #include "graph_structures/GraphGenerator.h"
 #include "graph_structures/StronglyConnectedComponents.h"
 #include "graph_structures/Lattice.h"
 #include "graph_structures/DynamicWeightShortestPath.h"
 #include "graph_structures/ShortestPath.h"
+#include "graph_structures/ReachabilityIndex.h"
 #include "GraphTypes.h"
 
 class DirectedWindow : public QWidget {
@@ -37,7 +39,6 @@ private:
     void drawComponents(const ArraySequence<ArraySequence<int>>& components);
     void drawHighlightedEdge(QGraphicsScene *scene, int from, int to, int weight, const QColor& color);
     void drawHighlightedEdge(QGraphicsScene *scene, int from, int to, const QString& weightLabel, const QColor& color);
-    bool checkPathExists(int source, int target);
 
     QGraphicsScene *originalScene;
     QGraphicsView *originalView;
@@ -46,6 +47,7 @@ private:
 
     DirectedGraph<int> originalGraph;
     DirectedGraph<int> resultGraph;
+    std::unique_ptr<ReachabilityIndex<int>> reachability;
     QVector<QPointF> nodePositions;
 
     QComboBox *graphTypeComboBox;
@@ -165,3 +165,102 @@ TEST(ArraySequence, concat) {
     delete s2;
     delete res;
 }
+
+// Перемещение DynamicArray забирает буфер, не копируя элементы
+TEST(DynamicArray, move_semantics) {
+    int data[] = {1, 2, 3};
+    DynamicArray<int> da(data, 3);
+    DynamicArray<int> moved(std::move(da));
+    ASSERT_EQ(3, moved.getSize());
+    ASSERT_EQ(0, da.getSize());
+    ASSERT_EQ(3, moved.get(2));
+
+    DynamicArray<int> assigned;
+    assigned = std::move(moved);
+    ASSERT_EQ(3, assigned.getSize());
+    ASSERT_EQ(0, moved.getSize());
+    ASSERT_EQ(1, assigned[0]);
+}
+
+// Элементы с нетривиальным конструктором корректно переживают перевыделение памяти
+TEST(DynamicArray, non_trivial_elements) {
+    DynamicArray<std::string> da;
+    for (int i = 0; i < 100; ++i) {
+        da.append(std::string(30, static_cast<char>('a' + i % 26)));
+    }
+    da.insertAt(0, "first");
+    da.removeAt(50);
+    ASSERT_EQ(100, da.getSize());
+    ASSERT_EQ("first", da[0]);
+    ASSERT_EQ(std::string(30, 'a'), da[1]);
+    ASSERT_EQ(std::string(30, static_cast<char>('a' + 99 % 26)), da[99]);
+
+    da.resize(2);
+    ASSERT_EQ(2, da.getSize());
+    da.resize(4);
+    ASSERT_EQ("", da[3]);
+}
+
+// Элемент, копирование которого бросает исключение после заданного числа копий
+struct ThrowingCopy {
+    static int live;
+    static int copiesLeft;
+    int value;
+
+    explicit ThrowingCopy(int value = 0) : value(value) { ++live; }
+    ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+        if (copiesLeft-- == 0) throw std::runtime_error("copy failed");
+        ++live;
+    }
+    ThrowingCopy &operator=(const ThrowingCopy &) = default;
+    ~ThrowingCopy() { --live; }
+};
+int ThrowingCopy::live = 0;
+int ThrowingCopy::copiesLeft = 0;
+
+// Исключение при копировании не портит массив и не оставляет живых элементов
+TEST(DynamicArray, throwing_copy_keeps_state) {
+    ThrowingCopy::copiesLeft = 1000;
+    {
+        DynamicArray<ThrowingCopy> da;
+        da.reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            da.append(ThrowingCopy(i));
+        }
+        ThrowingCopy::copiesLeft = 2;
+        ASSERT_THROW(da.reserve(100), std::runtime_error);
+        ASSERT_EQ(4, da.getSize());
+        ASSERT_EQ(4, da.getCapacity());
+        ASSERT_EQ(4, ThrowingCopy::live);
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_EQ(i, da[i].value);
+        }
+
+        ThrowingCopy::copiesLeft = 2;
+        ASSERT_THROW(DynamicArray<ThrowingCopy>(ThrowingCopy(7), 5), std::runtime_error);
+        ThrowingCopy::copiesLeft = 2;
+        ASSERT_THROW(DynamicArray<ThrowingCopy> copy(da), std::runtime_error);
+        ASSERT_EQ(4, ThrowingCopy::live);
+        ThrowingCopy::copiesLeft = 1000;
+    }
+    ASSERT_EQ(0, ThrowingCopy::live);
+}
+
+// Вложенные последовательности перемещаются при росте внешней
+TEST(ArraySequence, nested_append_and_move) {
+    ArraySequence<ArraySequence<int>> nested;
+    for (int i = 0; i < 100; ++i) {
+        ArraySequence<int> inner;
+        for (int j = 0; j <= i; ++j) {
+            inner.append(j);
+        }
+        nested.append(std::move(inner));
+    }
+    ASSERT_EQ(100, nested.getLength());
+    ASSERT_EQ(100, nested[99].getLength());
+    ASSERT_EQ(42, nested[99][42]);
+
+    ArraySequence<ArraySequence<int>> moved(std::move(nested));
+    ASSERT_EQ(100, moved.getLength());
+    ASSERT_EQ(0, nested.getLength());
+}
@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <vector>
 #include "../include/data_structures/AVLBinaryTree.h"
 #include "../include/data_structures/ISetBinaryTree.h"
 #include "../include/data_structures/IDictionaryBinaryTree.h"
 #include "../include/data_structures/ISortedSequenceBinaryTree.h"
+#include "../include/data_structures/ThreadPool.h"
+#include "../include/data_structures/DisjointSet.h"
 #include "../include/information_processing/Index.h"
 #include "../include/information_processing/Histogram.h"
 
@@ -70,6 +75,222 @@ TEST(BinaryTree, Iterator) {
     ASSERT_EQ(values, expected);
 }
 
+TEST(BinaryTree, IteratorAfterInsertAndRemove) {
+    AVLBinaryTree<int> tree;
+    std::multiset<int> reference;
+    for (int i = 0; i < 200; ++i) {
+        tree.insert((i * 37) % 200);
+        tree.insert(i % 10);  // Duplicates
+        reference.insert((i * 37) % 200);
+        reference.insert(i % 10);
+    }
+    for (int i = 0; i < 200; i += 3) {
+        tree.remove((i * 37) % 200);
+        reference.erase(reference.find((i * 37) % 200));
+    }
+    std::vector<int> expected(reference.begin(), reference.end());
+
+    std::vector<int> values;
+    for (int value : tree) {
+        values.push_back(value);
+    }
+    ASSERT_EQ(values, expected);
+
+    AVLBinaryTree<int> copy(tree);
+    values.clear();
+    for (int value : copy) {
+        values.push_back(value);
+    }
+    ASSERT_EQ(values, expected);
+}
+
+TEST(BinaryTree, OrderStatistics) {
+    AVLBinaryTree<int> tree;
+    for (int i = 0; i < 100; ++i) {
+        tree.insert((i * 53) % 100 * 2);  // Even values 0..198
+    }
+    tree.insert(50);
+    tree.insert(50);
+    tree.remove(100);
+
+    ASSERT_EQ(tree.select(0), 0);
+    ASSERT_EQ(tree.select(25), 50);
+    ASSERT_EQ(tree.select(26), 50);
+    ASSERT_EQ(tree.select(27), 50);
+    ASSERT_EQ(tree.select(100), 198);
+    ASSERT_THROW(tree.select(101), std::out_of_range);
+
+    ASSERT_EQ(tree.rank(0), 0);
+    ASSERT_EQ(tree.rank(50), 25);
+    ASSERT_EQ(tree.rank(51), 28);
+    ASSERT_EQ(tree.rank(1000), 101);
+
+    ASSERT_EQ(tree.countInRange(50, 50), 3);
+    ASSERT_EQ(tree.countInRange(90, 110), 10);
+    ASSERT_EQ(tree.countInRange(10, 0), 0);
+    ASSERT_EQ(*tree.iteratorAt(28), 52);
+}
+
+TEST(BinaryTree, BuildSorted) {
+    AVLBinaryTree<int> tree;
+    tree.insert(42);
+    tree.buildSorted(1000, [](int i) { return i / 2; });  // Duplicates included
+
+    ASSERT_EQ(tree.getSize(), 1000);
+    ASSERT_TRUE(tree.find(499));
+    ASSERT_FALSE(tree.find(500));
+    ASSERT_EQ(tree.height(), 10);
+    ASSERT_EQ(tree.select(501), 250);
+    ASSERT_EQ(tree.rank(250), 500);
+
+    tree.insert(-1);
+    tree.remove(0);
+    tree.remove(0);
+    ASSERT_EQ(tree.getMin(), -1);
+    ASSERT_EQ(tree.select(1), 1);
+
+    ASSERT_THROW(tree.buildSorted(3, [](int i) { return 2 - i; }), std::invalid_argument);
+    ASSERT_EQ(tree.getSize(), 0);
+}
+
+TEST(BinaryTree, ConstructFromUnsortedSequence) {
+    ArraySequence<int> sequence;
+    for (int i = 0; i < 100; ++i) {
+        sequence.append((i * 31) % 100);
+    }
+    AVLBinaryTree<int> tree(sequence);
+
+    int expected = 0;
+    for (int value : tree) {
+        ASSERT_EQ(value, expected++);
+    }
+    ASSERT_EQ(expected, 100);
+
+    sequence.append(5);
+    sequence.append(5);
+    ISetBinaryTree<int> set(sequence);
+    ASSERT_EQ(set.size(), 100);
+    ASSERT_TRUE(set.find(99));
+}
+
+TEST(BinaryTree, SharedPoolReusesFreedNodes) {
+    auto pool = std::make_shared<AVLBinaryTree<int>::Pool>();
+    AVLBinaryTree<int> first(pool);
+    AVLBinaryTree<int> second(pool);
+    for (int i = 0; i < 100; ++i) {
+        first.insert(i);
+        second.insert(-i);
+    }
+    ASSERT_EQ(pool->getLiveCount(), 200);
+    int slabs = pool->getSlabCount();
+
+    first.clear();
+    ASSERT_EQ(pool->getLiveCount(), 100);
+    for (int i = 0; i < 100; ++i) {
+        first.insert(i * 2);
+    }
+    ASSERT_EQ(pool->getSlabCount(), slabs);
+    ASSERT_TRUE(first.find(198));
+    ASSERT_TRUE(second.find(-99));
+}
+
+TEST(BinaryTree, CopyAndMoveWithPools) {
+    auto pool = std::make_shared<AVLBinaryTree<std::string>::Pool>();
+    AVLBinaryTree<std::string> shared(pool);
+    shared.insert("b");
+    shared.insert("a");
+
+    AVLBinaryTree<std::string> sharedCopy(shared);
+    ASSERT_EQ(sharedCopy.getPool(), pool);
+    ASSERT_EQ(pool->getLiveCount(), 4);
+
+    AVLBinaryTree<std::string> own;
+    own.insert("c");
+    own = shared;
+    ASSERT_EQ(own.getPool(), pool);
+    ASSERT_EQ(pool->getLiveCount(), 6);
+
+    AVLBinaryTree<std::string> moved(std::move(own));
+    ASSERT_TRUE(moved.find("a"));
+    ASSERT_EQ(own.getSize(), 0);
+    moved.clear();
+    sharedCopy.clear();
+    ASSERT_EQ(pool->getLiveCount(), 2);
+    ASSERT_TRUE(shared.find("b"));
+}
+
+TEST(BinaryTree, MoveAssignmentKeepsSharedPool) {
+    auto pool = std::make_shared<AVLBinaryTree<int>::Pool>();
+    AVLBinaryTree<int> row(pool);
+    row.insert(1);
+
+    // Узлы из собственного пула источника копируются в общий пул
+    AVLBinaryTree<int> fresh;
+    fresh.insert(5);
+    fresh.insert(6);
+    row = std::move(fresh);
+    ASSERT_EQ(row.getPool(), pool);
+    ASSERT_EQ(pool->getLiveCount(), 2);
+    ASSERT_TRUE(row.find(6));
+    ASSERT_FALSE(row.find(1));
+    ASSERT_EQ(fresh.getSize(), 0);
+
+    // Узлы того же пула переходят без копирования
+    AVLBinaryTree<int> sibling(pool);
+    sibling.insert(9);
+    row = std::move(sibling);
+    ASSERT_EQ(row.getPool(), pool);
+    ASSERT_EQ(pool->getLiveCount(), 1);
+    ASSERT_TRUE(row.find(9));
+    ASSERT_EQ(sibling.getSize(), 0);
+
+    row = AVLBinaryTree<int>();
+    ASSERT_EQ(row.getPool(), pool);
+    ASSERT_EQ(pool->getLiveCount(), 0);
+}
+
+
+TEST(BinaryTree, JoinBasedSetOperations) {
+    std::mt19937 random(7);
+    for (int size : {0, 1, 50, 100000}) {
+        std::set<int> a, b;
+        for (int i = 0; i < size; ++i) {
+            a.insert((int) (random() % (size * 3)));
+            b.insert((int) (random() % (size * 3)));
+        }
+        b.insert(-5);
+        std::set<int> expectedUnion(a), expectedIntersection, expectedDifference;
+        expectedUnion.insert(b.begin(), b.end());
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                              std::inserter(expectedIntersection, expectedIntersection.end()));
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                            std::inserter(expectedDifference, expectedDifference.end()));
+
+        auto check = [](const AVLBinaryTree<int> &tree, const std::set<int> &expected) {
+            ASSERT_EQ(tree.getSize(), (int) expected.size());
+            ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+            if (!expected.empty()) {
+                int heightBound = 1;
+                while ((1 << heightBound) <= (int) expected.size()) heightBound++;
+                ASSERT_LE(tree.height(), heightBound * 3 / 2 + 1);
+            }
+        };
+
+        AVLBinaryTree<int> united(a);
+        united.unionWith(AVLBinaryTree<int>(b), 4);
+        check(united, expectedUnion);
+
+        AVLBinaryTree<int> intersected(a);
+        intersected.intersectWith(AVLBinaryTree<int>(b), 4);
+        check(intersected, expectedIntersection);
+
+        auto pool = std::make_shared<AVLBinaryTree<int>::Pool>();
+        AVLBinaryTree<int> difference(AVLBinaryTree<int>(a), pool);
+        difference.differenceWith(AVLBinaryTree<int>(AVLBinaryTree<int>(b), pool), 1);
+        check(difference, expectedDifference);
+        ASSERT_EQ(pool->getLiveCount(), (int) expectedDifference.size());
+    }
+}
 
 TEST(SetBinaryTree, InsertAndFind) {
     ISetBinaryTree<int> set;
@@ -146,6 +367,37 @@ TEST(SetBinaryTree, Difference) {
     delete result;
 }
 
+TEST(SetBinaryTree, OperationsWithSmallOperand) {
+    ArraySequence<int> large;
+    for (int i = 0; i < 10000; ++i) {
+        large.append(i * 2);
+    }
+    ISetBinaryTree<int> set1(large);
+    ISetBinaryTree<int> set2;
+    set2.insert(4);
+    set2.insert(5);
+
+    ISet<int>* intersection = set1.intersection(set2);
+    ASSERT_EQ(intersection->size(), 1);
+    ASSERT_TRUE(intersection->find(4));
+    delete intersection;
+
+    ISet<int>* difference = set2.difference(set1);
+    ASSERT_EQ(difference->size(), 1);
+    ASSERT_TRUE(difference->find(5));
+    delete difference;
+
+    difference = set1.difference(set2);
+    ASSERT_EQ(difference->size(), 9999);
+    ASSERT_FALSE(difference->find(4));
+    ASSERT_TRUE(difference->find(6));
+    delete difference;
+
+    ISet<int>* united = set2.setUnion(set1);
+    ASSERT_EQ(united->size(), 10001);
+    delete united;
+}
+
 TEST(SetBinaryTree, SubSet) {
     ISetBinaryTree<int> set1;
     set1.insert(1);
@@ -183,6 +435,35 @@ TEST(IDictionaryBinaryTree, AddAndGet) {
     ASSERT_EQ(dict.Get(2), "two");
 }
 
+TEST(IDictionaryBinaryTree, SharedPoolAndClear) {
+    auto pool = std::make_shared<IDictionaryBinaryTree<int, int>::Pool>();
+    IDictionaryBinaryTree<int, int> first(pool);
+    IDictionaryBinaryTree<int, int> second(pool);
+    first.Add(1, 10);
+    second.Add(2, 20);
+    ASSERT_EQ(pool->getLiveCount(), 2);
+
+    first.Clear();
+    ASSERT_EQ(first.GetCount(), 0);
+    ASSERT_EQ(pool->getLiveCount(), 1);
+    first.Add(3, 30);
+    ASSERT_EQ(first.Get(3), 30);
+    ASSERT_EQ(second.Get(2), 20);
+}
+
+TEST(IDictionaryBinaryTree, BuildFromSorted) {
+    IDictionaryBinaryTree<int, std::string> dict;
+    dict.BuildFromSorted(100, [](int i) { return i * 2; }, [](int i) { return std::to_string(i); });
+    ASSERT_EQ(dict.GetCount(), 100);
+    ASSERT_EQ(dict.Get(42), "21");
+    ASSERT_FALSE(dict.ContainsKey(43));
+    dict.Add(43, "x");
+    ASSERT_EQ(dict.GetKeys().get(22), 43);
+
+    ASSERT_THROW(dict.BuildFromSorted(2, [](int) { return 1; }, [](int) { return std::string(); }),
+                 std::invalid_argument);
+}
+
 TEST(IDictionaryBinaryTree, Remove) {
     IDictionaryBinaryTree<int, std::string> dict;
     dict.Add(1, "one");
@@ -271,6 +552,26 @@ TEST(ISortedSequenceBinaryTree, GetSubsequence) {
     delete subseq;
 }
 
+TEST(ISortedSequenceBinaryTree, PercentilesAndRanges) {
+    ISortedSequenceBinaryTree<int> seq;
+    for (int i = 1000; i > 0; --i) {
+        seq.Add(i % 2 == 0 ? i : 1000 - i);
+    }
+
+    ASSERT_EQ(seq.Get(0), 1);
+    ASSERT_EQ(seq.Get(499), 500);
+    ASSERT_EQ(seq.Get(999), 1000);
+    ASSERT_EQ(seq.IndexOf(501), 500);
+    ASSERT_EQ(seq.IndexOf(0), -1);
+    ASSERT_EQ(seq.CountInRange(10, 19), 10);
+
+    auto *subsequence = seq.GetSubsequence(10, 19);
+    ASSERT_EQ(subsequence->GetLength(), 10);
+    ASSERT_EQ(subsequence->GetFirst(), 11);
+    ASSERT_EQ(subsequence->GetLast(), 20);
+    delete subsequence;
+}
+
 TEST(ISortedSequenceBinaryTree, IsEmptyAndGetLength) {
     ISortedSequenceBinaryTree<int> seq;
     ASSERT_TRUE(seq.IsEmpty());
@@ -554,3 +855,73 @@ TEST(IndexTest, GetAllKeysAndValues) {
     ASSERT_EQ(allValues[2].value, 30);
 }
 
+TEST(ThreadPoolTest, RunsAllTasksWithWorkerIndices) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4u);
+
+    std::vector<int> hits(1000, 0);
+    std::atomic<bool> badWorker{false};
+    pool.parallelFor(1000, 7, [&](int i, unsigned worker) {
+        if (worker >= 4) badWorker = true;
+        ++hits[i];
+    });
+    EXPECT_FALSE(badWorker);
+    for (int hit : hits) {
+        ASSERT_EQ(hit, 1);
+    }
+
+    // Tasks submitted from workers land in their own deques and may be stolen
+    std::atomic<int> leaves{0};
+    for (int i = 0; i < 8; ++i) {
+        pool.submit([&pool, &leaves](unsigned) {
+            for (int j = 0; j < 50; ++j) {
+                pool.submit([&leaves](unsigned) { ++leaves; });
+            }
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(leaves, 400);
+}
+
+TEST(ThreadPoolTest, WaitRethrowsTaskException) {
+    ThreadPool pool(2);
+    std::atomic<int> finished{0};
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([i, &finished](unsigned) {
+            if (i == 3) throw std::runtime_error("task failed");
+            ++finished;
+        });
+    }
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(finished, 9);
+    EXPECT_NO_THROW(pool.wait());
+}
+
+TEST(DisjointSetTest, UniteFindAndGrow) {
+    DisjointSet sets(6);
+    EXPECT_EQ(sets.getSetCount(), 6);
+    EXPECT_TRUE(sets.unite(0, 1));
+    EXPECT_TRUE(sets.unite(2, 3));
+    EXPECT_TRUE(sets.unite(1, 3));
+    EXPECT_FALSE(sets.unite(0, 2));
+    EXPECT_TRUE(sets.connected(0, 3));
+    EXPECT_FALSE(sets.connected(0, 4));
+    EXPECT_EQ(sets.getSetCount(), 3);
+
+    EXPECT_EQ(sets.addElement(), 6);
+    sets.ensureSize(10);
+    EXPECT_EQ(sets.getSize(), 10);
+    EXPECT_EQ(sets.getSetCount(), 7);
+    EXPECT_TRUE(sets.unite(9, 5));
+    EXPECT_EQ(sets.find(9), sets.find(5));
+    EXPECT_THROW(sets.find(10), std::out_of_range);
+    EXPECT_THROW(sets.unite(-1, 0), std::out_of_range);
+
+    // Длинная цепочка объединений не делает поиск глубоким
+    DisjointSet chain(100000);
+    for (int i = 1; i < 100000; ++i) {
+        chain.unite(i - 1, i);
+    }
+    EXPECT_EQ(chain.getSetCount(), 1);
+    EXPECT_TRUE(chain.connected(0, 99999));
+}
@@ -1,4 +1,6 @@
+#include <atomic>
 #include <queue>
+#include <sstream>
 #include "gtest/gtest.h"
 #include "../include/graph_structures/DirectedGraph.h"
 #include "../include/graph_structures/ConnectedComponents.h"
@@ -10,6 +12,15 @@
 #include "../include/graph_structures/GraphGenerator.h"
 #include "../include/graph_structures/UndirectedGraph.h"
 #include "../include/graph_structures/DynamicWeightShortestPath.h"
+#include "../include/graph_structures/CSRGraph.h"
+#include "../include/graph_structures/LandmarkHeuristic.h"
+#include "../include/graph_structures/ContractionHierarchy.h"
+#include "../include/graph_structures/AllPairsShortestPaths.h"
+#include "../include/graph_structures/IncrementalShortestPath.h"
+#include "../include/graph_structures/TimeDependentShortestPath.h"
+#include "../include/graph_structures/ReachabilityIndex.h"
+#include "../include/graph_structures/DynamicConnectivity.h"
+#include "../include/graph_structures/DynamicMinimumSpanningTree.h"
 
 
 TEST(DirectedGraphTest, Constructor) {
@@ -43,6 +54,32 @@ TEST(DirectedGraphTest, RemoveEdge) {
     EXPECT_EQ(graph.getDegree(0), 0);
 }
 
+TEST(DirectedGraphTest, MovedFromGraphIsEmpty) {
+    DirectedGraph<int> graph(4);
+    graph.addEdge(0, 1, 5);
+    graph.addEdge(2, 3, 7);
+
+    DirectedGraph<int> moved(std::move(graph));
+    EXPECT_EQ(moved.getVertexCount(), 4);
+    EXPECT_EQ(moved.getEdgeWeight(2, 3), 7);
+    EXPECT_EQ(graph.getVertexCount(), 0);
+    EXPECT_EQ(graph.getEdges().getLength(), 0);
+    EXPECT_THROW(graph.addEdge(0, 1, 1), std::out_of_range);
+
+    DirectedGraph<int> assigned(2);
+    assigned.addEdge(1, 0, 3);
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.getVertexCount(), 4);
+    EXPECT_TRUE(assigned.hasEdge(0, 1));
+    EXPECT_EQ(moved.getVertexCount(), 0);
+
+    // Опустевший граф снова пригоден после присваивания
+    moved = assigned;
+    moved.addEdge(1, 2, 4);
+    EXPECT_EQ(moved.getEdges().getLength(), 3);
+    EXPECT_EQ(assigned.getEdges().getLength(), 2);
+}
+
 TEST(DirectedGraphTest, RemoveEdgeNotFound) {
     DirectedGraph<int> graph(2);
     EXPECT_THROW(graph.removeEdge(0, 1), std::invalid_argument);
@@ -166,6 +203,119 @@ TEST(UndirectedGraphTest, HasEdge) {
     EXPECT_TRUE(graph.hasEdge(1, 0));
 }
 
+TEST(GraphTest, ForEachNeighborMatchesGetNeighbors) {
+    UndirectedGraph<int> graph(4);
+    graph.addEdge(0, 3, 9);
+    graph.addEdge(0, 1, 4);
+    graph.addEdge(2, 0, 6);
+    CSRGraph<int> csr(graph);
+
+    for (const Graph<int>* g : {static_cast<const Graph<int>*>(&graph), static_cast<const Graph<int>*>(&csr)}) {
+        for (int u = 0; u < 4; ++u) {
+            auto expected = g->getNeighbors(u);
+            int index = 0;
+            g->forEachNeighbor(u, [&](int neighbor, const int& weight) {
+                ASSERT_LT(index, expected.getLength());
+                EXPECT_EQ(neighbor, expected[index].first);
+                EXPECT_EQ(weight, expected[index].second);
+                ++index;
+            });
+            EXPECT_EQ(index, expected.getLength());
+        }
+    }
+}
+
+// Тесты для CSRGraph
+TEST(CSRGraphTest, FreezeDirectedGraph) {
+    DirectedGraph<int> graph(4);
+    graph.addEdge(0, 2, 14);
+    graph.addEdge(0, 1, 7);
+    graph.addEdge(2, 3, 5);
+    graph.addEdge(3, 0, 1);
+
+    CSRGraph<int> csr(graph);
+    EXPECT_EQ(csr.getVertexCount(), 4);
+    EXPECT_EQ(csr.getEdgeCount(), 4);
+    EXPECT_TRUE(csr.isDirected());
+    for (int u = 0; u < 4; ++u) {
+        EXPECT_EQ(csr.getDegree(u), graph.getDegree(u));
+        for (int v = 0; v < 4; ++v) {
+            EXPECT_EQ(csr.hasEdge(u, v), graph.hasEdge(u, v));
+        }
+    }
+    auto neighbors = csr.getNeighbors(0);
+    ASSERT_EQ(neighbors.getLength(), 2);
+    EXPECT_EQ(neighbors[0].first, 1);
+    EXPECT_EQ(neighbors[0].second, 7);
+    EXPECT_EQ(neighbors[1].first, 2);
+    EXPECT_EQ(neighbors[1].second, 14);
+    EXPECT_EQ(csr.getEdgeWeight(2, 3), 5);
+    EXPECT_THROW(csr.getEdgeWeight(1, 0), std::invalid_argument);
+    EXPECT_THROW(csr.addEdge(1, 0, 1), std::invalid_argument);
+    EXPECT_THROW(csr.removeEdge(0, 1), std::invalid_argument);
+    EXPECT_THROW(csr.getDegree(4), std::out_of_range);
+}
+
+TEST(CSRGraphTest, Transpose) {
+    DirectedGraph<int> graph(3);
+    graph.addEdge(0, 1, 3);
+    graph.addEdge(2, 1, 4);
+    graph.addEdge(1, 0, 5);
+
+    CSRGraph<int> transposed = CSRGraph<int>(graph).getTranspose();
+    EXPECT_TRUE(transposed.hasEdge(1, 0));
+    EXPECT_TRUE(transposed.hasEdge(1, 2));
+    EXPECT_TRUE(transposed.hasEdge(0, 1));
+    EXPECT_FALSE(transposed.hasEdge(2, 1));
+    EXPECT_EQ(transposed.getEdgeWeight(1, 2), 4);
+    EXPECT_EQ(transposed.getDegree(1), 2);
+}
+
+TEST(CSRGraphTest, FreezeUndirectedGraphForAlgorithms) {
+    UndirectedGraph<int> graph(5);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(0, 2, 3);
+    graph.addEdge(1, 2, 2);
+    graph.addEdge(3, 4, 7);
+
+    CSRGraph<int> csr(graph);
+    EXPECT_FALSE(csr.isDirected());
+    EXPECT_EQ(csr.getEdges().getLength(), 4);
+
+    auto components = ConnectedComponents::findComponents(csr);
+    EXPECT_EQ(components.getLength(), 2);
+
+    auto mst = MinimumSpanningTree<int>::kruskal(csr);
+    ASSERT_EQ(mst.getLength(), 3);
+    int totalWeight = 0;
+    for (int i = 0; i < mst.getLength(); ++i) {
+        totalWeight += std::get<2>(mst[i]);
+    }
+    EXPECT_EQ(totalWeight, 1 + 2 + 7);
+
+    auto colors = GraphColoring::greedyColoring(csr);
+    for (int u = 0; u < 5; ++u) {
+        auto neighbors = csr.getNeighbors(u);
+        for (int i = 0; i < neighbors.getLength(); ++i) {
+            EXPECT_NE(colors[u], colors[neighbors[i].first]);
+        }
+    }
+}
+
+TEST(CSRGraphTest, ShortestPathAndSCCMatchDirectedGraph) {
+    DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 30, 0.2, 20);
+    CSRGraph<int> csr(graph);
+
+    auto expected = ShortestPath<int>::dijkstra(graph, 0);
+    auto actual = ShortestPath<int>::dijkstra(csr, 0);
+    for (int v = 0; v < graph.getVertexCount(); ++v) {
+        EXPECT_EQ(actual[v].first, expected[v].first);
+    }
+
+    EXPECT_EQ(StronglyConnectedComponents<int>::findSCC(csr).getLength(),
+              StronglyConnectedComponents<int>::findSCC(graph).getLength());
+}
+
 // Тесты для ConnectedComponents
 TEST(ConnectedComponentsTest, EmptyGraph) {
     UndirectedGraph<int> graph(0);
@@ -209,6 +359,111 @@ TEST(ConnectedComponentsTest, FullyConnectedGraph) {
     EXPECT_TRUE(components[0].find(2));
 }
 
+TEST(ConnectedComponentsTest, ParallelAndStreamingMatchSerial) {
+    UndirectedGraph<int> graph = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 3000, 0.0005, 5);
+    auto serial = ConnectedComponents::findComponentIds(graph);
+    auto components = ConnectedComponents::findComponents(graph);
+    ASSERT_EQ(components.getLength(), serial.componentCount);
+    EXPECT_EQ(components[0][0], 0);
+
+    ThreadPool pool(4);
+    auto parallel = ConnectedComponents::findComponentIdsParallel(graph, pool);
+    EdgeStreamComponents stream(graph.getVertexCount());
+    auto edges = graph.getEdges();
+    for (int i = 0; i < edges.getLength(); ++i) {
+        stream.addEdge(std::get<0>(edges[i]), std::get<1>(edges[i]));
+    }
+    auto streamed = stream.getComponentIds();
+    ASSERT_EQ(parallel.componentCount, serial.componentCount);
+    ASSERT_EQ(streamed.componentCount, serial.componentCount);
+    for (int v = 0; v < graph.getVertexCount(); ++v) {
+        ASSERT_EQ(parallel.componentOf[v], serial.componentOf[v]);
+        ASSERT_EQ(streamed.componentOf[v], serial.componentOf[v]);
+    }
+
+    // Ориентированный граф: компоненты слабой связности
+    DirectedGraph<int> directed(4);
+    directed.addEdge(1, 0, 1);
+    directed.addEdge(3, 2, 1);
+    EXPECT_EQ(ConnectedComponents::findComponentIds(directed).componentCount, 2);
+    EXPECT_EQ(ConnectedComponents::findComponentIdsParallel(directed, pool).componentCount, 2);
+}
+
+TEST(ConnectedComponentsTest, EdgeStreamFromInput) {
+    std::istringstream input("0 1\n1 2\n5 6  7 5\n");
+    EdgeStreamComponents stream;
+    EXPECT_EQ(stream.readEdges(input), 4);
+    EXPECT_EQ(stream.getVertexCount(), 8);
+    EXPECT_EQ(stream.getComponentCount(), 4);
+    EXPECT_TRUE(stream.connected(0, 2));
+    EXPECT_TRUE(stream.connected(6, 7));
+    EXPECT_FALSE(stream.connected(2, 5));
+    EXPECT_THROW(stream.connected(0, 8), std::out_of_range);
+    EXPECT_THROW(stream.addEdge(-1, 0), std::out_of_range);
+
+    std::istringstream odd("0 1 2");
+    EXPECT_THROW(stream.readEdges(odd), std::invalid_argument);
+    std::istringstream garbage("0 1 x y");
+    EXPECT_THROW(stream.readEdges(garbage), std::invalid_argument);
+}
+
+TEST(ConnectedComponentsTest, DynamicConnectivityMatchesRecomputation) {
+    // Плотная случайная смесь вставок и удалений на небольшом графе, чтобы рёбра поднимались по уровням
+    const int vertices = 60;
+    ConnectivityTrackingGraph<int> graph(vertices);
+    std::mt19937 random(7);
+    std::vector<std::pair<int, int>> present;
+    for (int step = 0; step < 4000; ++step) {
+        bool insert = present.size() < 40 || (present.size() < 120 && random() % 2 == 0);
+        if (insert) {
+            int u = int(random() % vertices);
+            int v = int(random() % vertices);
+            if (u == v || graph.hasEdge(u, v)) continue;
+            graph.addEdge(u, v, 1);
+            present.emplace_back(u, v);
+        } else {
+            int index = int(random() % present.size());
+            graph.removeEdge(present[index].first, present[index].second);
+            present[index] = present.back();
+            present.pop_back();
+        }
+
+        if (step % 20 != 0) continue;
+        auto expected = ConnectedComponents::findComponentIds(graph);
+        ASSERT_EQ(graph.getComponentCount(), expected.componentCount) << "step " << step;
+        for (int v = 0; v < vertices; ++v) {
+            ASSERT_EQ(graph.connected(0, v), expected.componentOf[v] == expected.componentOf[0]);
+        }
+    }
+    EXPECT_EQ(graph.getConnectivity().getEdgeCount(), int(present.size()));
+    EXPECT_LE(graph.getConnectivity().getLevelCount(), 7);
+}
+
+TEST(ConnectedComponentsTest, DynamicConnectivityEdgeCases) {
+    DynamicConnectivity connectivity(4);
+    EXPECT_TRUE(connectivity.addEdge(0, 1));
+    EXPECT_TRUE(connectivity.addEdge(1, 2));
+    EXPECT_FALSE(connectivity.addEdge(2, 0));
+    EXPECT_EQ(connectivity.getComponentCount(), 2);
+    EXPECT_EQ(connectivity.getComponentSize(1), 3);
+
+    // Удаление ребра дерева с заменой ребром вне дерева
+    EXPECT_FALSE(connectivity.removeEdge(1, 0));
+    EXPECT_TRUE(connectivity.connected(0, 1));
+    EXPECT_TRUE(connectivity.removeEdge(0, 2));
+    EXPECT_FALSE(connectivity.connected(0, 1));
+    EXPECT_EQ(connectivity.getComponentCount(), 3);
+
+    EXPECT_FALSE(connectivity.addEdge(3, 3));
+    EXPECT_THROW(connectivity.addEdge(1, 2), std::invalid_argument);
+    EXPECT_THROW(connectivity.removeEdge(0, 3), std::invalid_argument);
+    EXPECT_THROW(connectivity.connected(0, 4), std::out_of_range);
+
+    ConnectivityTrackingGraph<int> graph(3);
+    EXPECT_THROW(graph.addEdge(0, 5, 1), std::out_of_range);
+    EXPECT_EQ(graph.getComponentCount(), 3);
+}
+
 // Тесты для GraphColoring
 TEST(GraphColoringTest, EmptyGraph) {
     UndirectedGraph<int> graph(0);
@@ -264,6 +519,75 @@ TEST(GraphColoringTest, BipartiteGraph) {
     EXPECT_LE(colorSet.size(), 2);
 }
 
+TEST(GraphColoringTest, OrderingsAndDsaturProduceValidColorings) {
+    // Корона: u_i = 2i, v_i = 2i + 1, u_i соединена со всеми v_j при i != j.
+    // Естественный порядок тратит по цвету на пару, DSatur обходится двумя цветами
+    const int pairs = 6;
+    UndirectedGraph<int> crown(2 * pairs);
+    for (int i = 0; i < pairs; ++i) {
+        for (int j = 0; j < pairs; ++j) {
+            if (i != j) crown.addEdge(2 * i, 2 * j + 1, 1);
+        }
+    }
+    auto natural = GraphColoring::greedyColoring(crown);
+    EXPECT_TRUE(GraphColoring::isValidColoring(crown, natural));
+    EXPECT_EQ(GraphColoring::colorCount(natural), pairs);
+    auto saturated = GraphColoring::dsatur(crown);
+    EXPECT_TRUE(GraphColoring::isValidColoring(crown, saturated));
+    EXPECT_EQ(GraphColoring::colorCount(saturated), 2);
+
+    // Дерево вырождено степени 1: порядок smallest-last даёт не больше двух цветов
+    UndirectedGraph<int> tree = GraphGenerator::generateUndirectedGraph(GraphGenerator::TREE, 300, 0.0, 10);
+    auto treeColors = GraphColoring::greedyColoring(tree, GraphColoring::SMALLEST_LAST);
+    EXPECT_TRUE(GraphColoring::isValidColoring(tree, treeColors));
+    EXPECT_LE(GraphColoring::colorCount(treeColors), 2);
+
+    UndirectedGraph<int> random = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 150, 0.2, 10);
+    int maxDegree = 0;
+    for (int v = 0; v < random.getVertexCount(); ++v) {
+        maxDegree = std::max(maxDegree, random.getDegree(v));
+    }
+    for (auto ordering : {GraphColoring::NATURAL, GraphColoring::LARGEST_FIRST, GraphColoring::SMALLEST_LAST}) {
+        auto colors = GraphColoring::greedyColoring(random, ordering);
+        EXPECT_TRUE(GraphColoring::isValidColoring(random, colors));
+        EXPECT_LE(GraphColoring::colorCount(colors), maxDegree + 1);
+    }
+    EXPECT_TRUE(GraphColoring::isValidColoring(random, GraphColoring::dsatur(random)));
+
+    CSRGraph<int> csr(random);
+    EXPECT_THROW(GraphColoring::colorInOrder(csr, DynamicArray<int>(3)), std::invalid_argument);
+}
+
+TEST(GraphColoringTest, SpeculativeColoringIsValid) {
+    UndirectedGraph<int> graph = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 5000, 0.01, 10);
+    int maxDegree = 0;
+    for (int v = 0; v < graph.getVertexCount(); ++v) {
+        maxDegree = std::max(maxDegree, graph.getDegree(v));
+    }
+    int serial = GraphColoring::colorCount(GraphColoring::greedyColoring(graph));
+
+    for (unsigned threads : {1u, 4u}) {
+        ThreadPool pool(threads);
+        auto colors = GraphColoring::speculativeColoring(graph, pool);
+        EXPECT_TRUE(GraphColoring::isValidColoring(graph, colors));
+        EXPECT_LE(GraphColoring::colorCount(colors), maxDegree + 1);
+        EXPECT_LE(GraphColoring::colorCount(colors), serial + 3);
+
+        auto ordered = GraphColoring::speculativeColoring(graph, pool, GraphColoring::SMALLEST_LAST);
+        EXPECT_TRUE(GraphColoring::isValidColoring(graph, ordered));
+    }
+
+    ArraySequence<int> broken = GraphColoring::greedyColoring(graph);
+    int u = 0;
+    while (graph.getDegree(u) == 0) ++u;
+    int v = -1;
+    graph.forEachNeighbor(u, [&v, u](int neighbor, const int&) { if (neighbor != u) v = neighbor; });
+    broken[u] = broken[v];
+    EXPECT_FALSE(GraphColoring::isValidColoring(graph, broken));
+    broken[u] = -1;
+    EXPECT_FALSE(GraphColoring::isValidColoring(graph, broken));
+}
+
 TEST(MinimumSpanningTreeTest, EmptyGraph) {
     UndirectedGraph<int> graph(0);
     auto mst = MinimumSpanningTree<int>::kruskal(graph);
@@ -329,6 +653,163 @@ TEST(MinimumSpanningTreeTest, GraphWithMultipleMinimumSpanningTrees) {
     }
 }
 
+TEST(MinimumSpanningTreeTest, FilterKruskalAndBoruvkaMatchKruskal) {
+    ThreadPool pool(4);
+    // Малый разброс весов даёт много равных рёбер; при средней степени 3 граф несвязен
+    for (int maxWeight : {3, 1000}) {
+        UndirectedGraph<int> graph = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 4000, 0.00075,
+                                                                             maxWeight);
+        auto totalWeight = [](const ArraySequence<std::tuple<int, int, int>>& edges) {
+            long long total = 0;
+            for (int i = 0; i < edges.getLength(); ++i) {
+                total += std::get<2>(edges[i]);
+            }
+            return total;
+        };
+        auto expected = MinimumSpanningTree<int>::kruskal(graph);
+        auto filtered = MinimumSpanningTree<int>::filterKruskal(graph);
+        auto parallel = MinimumSpanningTree<int>::boruvka(graph, pool);
+        int components = ConnectedComponents::findComponentIds(graph).componentCount;
+        ASSERT_EQ(expected.getLength(), graph.getVertexCount() - components);
+        EXPECT_EQ(filtered.getLength(), expected.getLength());
+        EXPECT_EQ(parallel.getLength(), expected.getLength());
+        EXPECT_EQ(totalWeight(filtered), totalWeight(expected));
+        EXPECT_EQ(totalWeight(parallel), totalWeight(expected));
+
+        // Рёбра Борувки образуют лес
+        DisjointSet forest(graph.getVertexCount());
+        for (int i = 0; i < parallel.getLength(); ++i) {
+            EXPECT_TRUE(graph.hasEdge(std::get<0>(parallel[i]), std::get<1>(parallel[i])));
+            EXPECT_TRUE(forest.unite(std::get<0>(parallel[i]), std::get<1>(parallel[i])));
+        }
+    }
+
+    UndirectedGraph<int> empty(0);
+    EXPECT_EQ(MinimumSpanningTree<int>::filterKruskal(empty).getLength(), 0);
+    EXPECT_EQ(MinimumSpanningTree<int>::boruvka(empty, pool).getLength(), 0);
+
+    // Ориентированный граф отвергается: иначе дуги u->v с u > v молча терялись бы
+    DirectedGraph<int> arcs(3);
+    arcs.addEdge(2, 0, 1);
+    arcs.addEdge(2, 1, 1);
+    CSRGraph<int> directed(arcs);
+    EXPECT_THROW(MinimumSpanningTree<int>::kruskal(directed), std::invalid_argument);
+    EXPECT_THROW(MinimumSpanningTree<int>::filterKruskal(directed), std::invalid_argument);
+    EXPECT_THROW(MinimumSpanningTree<int>::boruvka(directed, pool), std::invalid_argument);
+    EXPECT_THROW(MinimumSpanningTree<int>::prim(directed), std::invalid_argument);
+    EXPECT_THROW(DynamicMinimumSpanningTree<int>{directed}, std::invalid_argument);
+}
+
+TEST(MinimumSpanningTreeTest, PrimVariantsMatchKruskal) {
+    auto totalWeight = [](const ArraySequence<std::tuple<int, int, int>>& edges) {
+        long long total = 0;
+        for (int i = 0; i < edges.getLength(); ++i) {
+            total += std::get<2>(edges[i]);
+        }
+        return total;
+    };
+    UndirectedGraph<int> complete = GraphGenerator::generateUndirectedGraph(GraphGenerator::COMPLETE, 120, 1, 50);
+    UndirectedGraph<int> sparse = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 2000, 0.001, 50);
+    for (const UndirectedGraph<int>* graph : {&complete, &sparse}) {
+        auto expected = MinimumSpanningTree<int>::kruskal(*graph);
+        auto heap = MinimumSpanningTree<int>::primHeap(*graph);
+        auto dense = MinimumSpanningTree<int>::primDense(*graph);
+        auto chosen = MinimumSpanningTree<int>::prim(*graph);
+        ASSERT_EQ(heap.getLength(), expected.getLength());
+        ASSERT_EQ(dense.getLength(), expected.getLength());
+        ASSERT_EQ(chosen.getLength(), expected.getLength());
+        EXPECT_EQ(totalWeight(heap), totalWeight(expected));
+        EXPECT_EQ(totalWeight(dense), totalWeight(expected));
+        EXPECT_EQ(totalWeight(chosen), totalWeight(expected));
+        for (int i = 0; i < dense.getLength(); ++i) {
+            EXPECT_LT(std::get<0>(dense[i]), std::get<1>(dense[i]));
+            EXPECT_TRUE(graph->hasEdge(std::get<0>(dense[i]), std::get<1>(dense[i])));
+        }
+    }
+
+    // Несвязный граф: остовный лес
+    UndirectedGraph<int> forest(5);
+    forest.addEdge(0, 1, 4);
+    forest.addEdge(3, 4, 2);
+    EXPECT_EQ(MinimumSpanningTree<int>::primHeap(forest).getLength(), 2);
+    EXPECT_EQ(MinimumSpanningTree<int>::primDense(forest).getLength(), 2);
+    EXPECT_EQ(MinimumSpanningTree<int>::prim(UndirectedGraph<int>(0)).getLength(), 0);
+}
+
+TEST(MinimumSpanningTreeTest, DynamicForestMatchesKruskal) {
+    const int vertices = 40;
+    MinimumSpanningTrackingGraph<int> graph(vertices);
+    std::mt19937 random(11);
+    std::vector<std::pair<int, int>> present;
+    for (int step = 0; step < 3000; ++step) {
+        int action = int(random() % 3);
+        if (present.size() < 30 || (action == 0 && present.size() < 150)) {
+            int u = int(random() % vertices);
+            int v = int(random() % vertices);
+            if (u == v || graph.hasEdge(u, v)) continue;
+            graph.addEdge(u, v, int(random() % 20));
+            present.emplace_back(u, v);
+        } else if (action == 1) {
+            int index = int(random() % present.size());
+            graph.removeEdge(present[index].first, present[index].second);
+            present[index] = present.back();
+            present.pop_back();
+        } else {
+            const auto& edge = present[random() % present.size()];
+            graph.updateEdgeWeight(edge.first, edge.second, int(random() % 20));
+        }
+
+        if (step % 10 != 0) continue;
+        const auto& tree = graph.getSpanningTree();
+        auto expected = MinimumSpanningTree<int>::kruskal(graph);
+        long long expectedWeight = 0;
+        for (int i = 0; i < expected.getLength(); ++i) {
+            expectedWeight += std::get<2>(expected[i]);
+        }
+        ASSERT_EQ(tree.getTotalWeight(), expectedWeight) << "step " << step;
+        ASSERT_EQ(tree.getForestEdgeCount(), expected.getLength());
+        ASSERT_EQ(tree.getComponentCount(), vertices - expected.getLength());
+
+        auto forest = tree.getForest();
+        DisjointSet check(vertices);
+        for (int i = 0; i < forest.getLength(); ++i) {
+            int u = std::get<0>(forest[i]);
+            int v = std::get<1>(forest[i]);
+            ASSERT_EQ(graph.getEdgeWeight(u, v), std::get<2>(forest[i]));
+            ASSERT_TRUE(check.unite(u, v));
+        }
+    }
+}
+
+TEST(MinimumSpanningTreeTest, DynamicForestFromGraph) {
+    UndirectedGraph<int> graph(4);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 2, 2);
+    graph.addEdge(0, 2, 3);
+    DynamicMinimumSpanningTree<int> tree(graph);
+    EXPECT_EQ(tree.getTotalWeight(), 3);
+    EXPECT_FALSE(tree.inForest(0, 2));
+    EXPECT_EQ(tree.getComponentCount(), 2);
+
+    // Подешевевшее ребро вне леса вытесняет самое тяжёлое ребро цикла
+    tree.updateWeight(0, 2, 0);
+    EXPECT_TRUE(tree.inForest(0, 2));
+    EXPECT_FALSE(tree.inForest(1, 2));
+    EXPECT_EQ(tree.getTotalWeight(), 1);
+
+    // Удаление ребра леса: замена — самое лёгкое ребро через разрез
+    tree.removeEdge(0, 1);
+    EXPECT_TRUE(tree.inForest(1, 2));
+    EXPECT_EQ(tree.getTotalWeight(), 2);
+    tree.addEdge(2, 3, 5);
+    EXPECT_EQ(tree.getComponentCount(), 1);
+
+    EXPECT_THROW(tree.addEdge(0, 2, 1), std::invalid_argument);
+    EXPECT_THROW(tree.removeEdge(0, 3), std::invalid_argument);
+    EXPECT_THROW(tree.updateWeight(0, 4, 1), std::out_of_range);
+    EXPECT_THROW(DynamicMinimumSpanningTree<int>(-1), std::invalid_argument);
+}
+
 // Вспомогательная функция для сортировки компонентов
 template<typename T>
 void sortSCC(ArraySequence<ArraySequence<T>>& sccList) {
@@ -456,6 +937,162 @@ TEST(StronglyConnectedComponentsTest, FullyConnectedGraph) {
     EXPECT_EQ(actual, expected);
 }
 
+TEST(StronglyConnectedComponentsTest, ComponentIdsMatchReachability) {
+    for (int round = 0; round < 5; ++round) {
+        DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 60, 0.03, 5);
+        auto ids = StronglyConnectedComponents<int>::findComponentIds(graph);
+        int n = graph.getVertexCount();
+
+        std::vector<std::vector<bool>> reachable(n, std::vector<bool>(n, false));
+        for (int s = 0; s < n; ++s) {
+            std::queue<int> queue;
+            queue.push(s);
+            reachable[s][s] = true;
+            while (!queue.empty()) {
+                int u = queue.front();
+                queue.pop();
+                graph.forEachNeighbor(u, [&](int v, const int&) {
+                    if (!reachable[s][v]) {
+                        reachable[s][v] = true;
+                        queue.push(v);
+                    }
+                });
+            }
+        }
+        for (int u = 0; u < n; ++u) {
+            ASSERT_GE(ids.componentOf[u], 0);
+            ASSERT_LT(ids.componentOf[u], ids.componentCount);
+            for (int v = 0; v < n; ++v) {
+                bool sameComponent = reachable[u][v] && reachable[v][u];
+                ASSERT_EQ(ids.componentOf[u] == ids.componentOf[v], sameComponent);
+            }
+            // Топологический порядок компонент
+            graph.forEachNeighbor(u, [&](int v, const int&) {
+                EXPECT_LE(ids.componentOf[u], ids.componentOf[v]);
+            });
+        }
+        EXPECT_EQ(StronglyConnectedComponents<int>::findSCC(graph).getLength(), ids.componentCount);
+    }
+}
+
+TEST(StronglyConnectedComponentsTest, LongChainsWithoutRecursion) {
+    const int n = 300000;
+    DirectedGraph<int> chain(n);
+    for (int v = 0; v + 1 < n; ++v) {
+        chain.addEdge(v, v + 1, 1);
+    }
+    CSRGraph<int> chainCsr(chain);
+    chain.addEdge(n - 1, 0, 1);
+    CSRGraph<int> cycle(chain);
+
+    auto cycleIds = StronglyConnectedComponents<int>::findComponentIds(cycle);
+    EXPECT_EQ(cycleIds.componentCount, 1);
+    EXPECT_EQ(StronglyConnectedComponents<int>::findSCC(chain).getLength(), 1);
+    auto chainIds = StronglyConnectedComponents<int>::findComponentIds(chainCsr);
+    ASSERT_EQ(chainIds.componentCount, n);
+    for (int v = 0; v < n; ++v) {
+        ASSERT_EQ(chainIds.componentOf[v], v);
+    }
+}
+
+TEST(StronglyConnectedComponentsTest, ParallelMatchesSerial) {
+    // Циклы длины 50, связанные рёбрами «вперёд», и случайный граф с гигантской компонентой
+    DirectedGraph<int> cycles(2000);
+    for (int v = 0; v < 2000; ++v) {
+        cycles.addEdge(v, v % 50 == 49 ? v - 49 : v + 1, 1);
+        if (v + 75 < 2000) cycles.addEdge(v, v + 75, 1);
+    }
+    cycles.addEdge(1999, 10, 1);
+    DirectedGraph<int> random = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 1500, 0.0015, 5);
+
+    ThreadPool pool(4);
+    for (const DirectedGraph<int>* graph : {&cycles, &random}) {
+        auto serial = StronglyConnectedComponents<int>::findComponentIds(*graph);
+        for (int cutoff : {0, 16, 100000}) {
+            auto parallel = StronglyConnectedComponents<int>::findComponentIdsParallel(*graph, pool, cutoff);
+            ASSERT_EQ(parallel.componentCount, serial.componentCount);
+            std::vector<int> serialToParallel(serial.componentCount, -1);
+            int previousNew = -1;
+            for (int v = 0; v < graph->getVertexCount(); ++v) {
+                int& mapped = serialToParallel[serial.componentOf[v]];
+                if (mapped == -1) {
+                    mapped = parallel.componentOf[v];
+                    // Нумерация по наименьшей вершине компоненты
+                    EXPECT_EQ(mapped, previousNew + 1);
+                    previousNew = mapped;
+                }
+                ASSERT_EQ(parallel.componentOf[v], mapped);
+            }
+        }
+    }
+    EXPECT_EQ(StronglyConnectedComponents<int>::findComponentIdsParallel(DirectedGraph<int>(0), pool).componentCount, 0);
+}
+
+// Матрица достижимости обходом в ширину от каждой вершины
+static std::vector<std::vector<bool>> reachabilityMatrix(const Graph<int>& graph) {
+    int n = graph.getVertexCount();
+    std::vector<std::vector<bool>> reachable(n, std::vector<bool>(n, false));
+    for (int s = 0; s < n; ++s) {
+        std::queue<int> queue;
+        queue.push(s);
+        reachable[s][s] = true;
+        while (!queue.empty()) {
+            int u = queue.front();
+            queue.pop();
+            graph.forEachNeighbor(u, [&](int v, const int&) {
+                if (!reachable[s][v]) {
+                    reachable[s][v] = true;
+                    queue.push(v);
+                }
+            });
+        }
+    }
+    return reachable;
+}
+
+TEST(ReachabilityIndexTest, MatchesBreadthFirstSearch) {
+    for (double density : {0.005, 0.01, 0.03}) {
+        DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 150, density, 5);
+        ReachabilityIndex<int> index(graph, 3);
+        auto expected = reachabilityMatrix(graph);
+        for (int u = 0; u < 150; ++u) {
+            for (int v = 0; v < 150; ++v) {
+                ASSERT_EQ(index.reachable(u, v), expected[u][v]) << u << " -> " << v;
+            }
+        }
+        EXPECT_EQ(index.getComponentCount(), StronglyConnectedComponents<int>::findSCC(graph).getLength());
+    }
+    EXPECT_THROW(ReachabilityIndex<int>(DirectedGraph<int>(3), 0), std::invalid_argument);
+    ReachabilityIndex<int> empty{DirectedGraph<int>(2)};
+    EXPECT_FALSE(empty.reachable(0, 1));
+    EXPECT_THROW(empty.reachable(0, 2), std::out_of_range);
+}
+
+TEST(ReachabilityIndexTest, AddEdgeKeepsIndexExact) {
+    const int n = 80;
+    DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, n, 0.004, 5);
+    ReachabilityIndex<int> index(graph);
+    std::mt19937 random(5);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    for (int step = 0; step < 60; ++step) {
+        int from = vertex(random);
+        int to = vertex(random);
+        bool wasReachable = index.reachable(from, to);
+        EXPECT_EQ(index.addEdge(from, to), !wasReachable);
+        if (from != to && !graph.hasEdge(from, to)) graph.addEdge(from, to, 1);
+
+        if (step % 10 == 9) {
+            auto expected = reachabilityMatrix(graph);
+            for (int u = 0; u < n; ++u) {
+                for (int v = 0; v < n; ++v) {
+                    ASSERT_EQ(index.reachable(u, v), expected[u][v]) << "step " << step;
+                }
+            }
+            EXPECT_EQ(index.getComponentCount(), StronglyConnectedComponents<int>::findSCC(graph).getLength());
+        }
+    }
+}
+
 // Вспомогательная функция для разделения ArraySequence<Pair<Weight, Vertex>> на отдельные массивы
 template<typename Weight, typename Vertex>
 std::pair<ArraySequence<Weight>, ArraySequence<Vertex>> splitResult(const ArraySequence<Pair<Weight, Vertex>>& result) {
@@ -523,6 +1160,420 @@ TEST(ShortestPathTest, UnreachableVertex) {
 }
 
 
+TEST(ShortestPathTest, QueueImplementationsAgree) {
+    DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 40, 0.15, 50);
+    for (int source = 0; source < 5; ++source) {
+        auto tree = ShortestPath<int>::dijkstra(graph, source, DijkstraQueue::AVL_TREE);
+        auto heap = ShortestPath<int>::dijkstra(graph, source, DijkstraQueue::INDEXED_HEAP);
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            EXPECT_EQ(tree[v].first, heap[v].first);
+            if (heap[v].first != std::numeric_limits<int>::max()) {
+                EXPECT_NO_THROW(ShortestPath<int>::getPath(heap, v));
+            }
+        }
+    }
+}
+
+TEST(ShortestPathTest, DeltaSteppingMatchesDijkstra) {
+    DirectedGraph<int> directed = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 300, 0.02, 50);
+    UndirectedGraph<int> undirected = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 300, 0.02, 50);
+    CSRGraph<int> csr(directed);
+    const Graph<int> *graphs[] = {&directed, &undirected, &csr};
+    for (const Graph<int> *graph : graphs) {
+        auto expected = ShortestPath<int>::dijkstra(*graph, 0);
+        for (unsigned threads : {1u, 4u}) {
+            for (int delta : {0, 1, 7, 1000}) {
+                auto result = ShortestPath<int>::deltaStepping(*graph, 0, delta, threads);
+                for (int v = 0; v < graph->getVertexCount(); ++v) {
+                    ASSERT_EQ(result[v].first, expected[v].first);
+                    if (v != 0 && result[v].first != std::numeric_limits<int>::max()) {
+                        int predecessor = result[v].second;
+                        ASSERT_EQ(result[predecessor].first + graph->getEdgeWeight(predecessor, v), result[v].first);
+                        EXPECT_NO_THROW(ShortestPath<int>::getPath(result, v));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(ShortestPathTest, DeltaSteppingZeroWeightsAndUnreachable) {
+    DirectedGraph<double> graph(6);
+    graph.addEdge(0, 1, 0.0);
+    graph.addEdge(1, 2, 0.0);
+    graph.addEdge(2, 1, 0.0);
+    graph.addEdge(2, 3, 2.5);
+    graph.addEdge(0, 3, 3.0);
+    graph.addEdge(3, 4, 0.0);
+
+    auto result = ShortestPath<double>::deltaStepping(graph, 0, 1.0, 3);
+    EXPECT_DOUBLE_EQ(result[2].first, 0.0);
+    EXPECT_DOUBLE_EQ(result[4].first, 2.5);
+    EXPECT_EQ(result[5].first, std::numeric_limits<double>::max());
+    auto path = ShortestPath<double>::getPath(result, 4);
+    ASSERT_EQ(path.getLength(), 5);
+    EXPECT_EQ(path.get(3), 3);
+    EXPECT_THROW(ShortestPath<double>::deltaStepping(graph, 6), std::out_of_range);
+}
+
+TEST(ShortestPathTest, PointToPointSearchesMatchDijkstra) {
+    DirectedGraph<int> directed = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 200, 0.02, 50);
+    UndirectedGraph<int> undirected = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 200, 0.02, 50);
+    CSRGraph<int> forward(directed);
+    CSRGraph<int> reverse = forward.getTranspose();
+    const Graph<int> *graphs[][2] = {{&directed, &reverse}, {&undirected, &undirected}};
+    for (auto &pair : graphs) {
+        const Graph<int> &graph = *pair[0];
+        LandmarkHeuristic<int> landmarks(graph, *pair[1], 4);
+        EXPECT_EQ(landmarks.getLandmarks().getLength(), 4);
+        for (int source : {0, 17, 99}) {
+            auto expected = ShortestPath<int>::dijkstra(graph, source);
+            for (int target = 0; target < graph.getVertexCount(); target += 7) {
+                landmarks.setTarget(target);
+                ShortestPath<int>::PathResult results[] = {
+                        ShortestPath<int>::bidirectionalDijkstra(graph, *pair[1], source, target),
+                        ShortestPath<int>::aStar(graph, source, target, ShortestPath<int>::zeroHeuristic),
+                        ShortestPath<int>::aStar(graph, source, target, landmarks)};
+                for (auto &result : results) {
+                    ASSERT_EQ(result.found, expected[target].first != std::numeric_limits<int>::max());
+                    ASSERT_EQ(result.distance, expected[target].first);
+                    if (!result.found) {
+                        EXPECT_EQ(result.path.getLength(), 0);
+                        continue;
+                    }
+                    ASSERT_EQ(result.path.get(0), source);
+                    ASSERT_EQ(result.path.get(result.path.getLength() - 1), target);
+                    int length = 0;
+                    for (int i = 1; i < result.path.getLength(); ++i) {
+                        ASSERT_TRUE(graph.hasEdge(result.path.get(i - 1), result.path.get(i)));
+                        length += graph.getEdgeWeight(result.path.get(i - 1), result.path.get(i));
+                    }
+                    EXPECT_EQ(length, result.distance);
+                }
+            }
+        }
+    }
+}
+
+TEST(ShortestPathTest, PointToPointUnreachableAndTrivial) {
+    DirectedGraph<int> graph(4);
+    graph.addEdge(0, 1, 2);
+    graph.addEdge(1, 2, 3);
+    graph.addEdge(3, 0, 1);
+    DirectedGraph<int> reverse = graph.getTranspose(graph);
+
+    auto result = ShortestPath<int>::bidirectionalDijkstra(graph, reverse, 0, 3);
+    EXPECT_FALSE(result.found);
+    EXPECT_EQ(result.distance, std::numeric_limits<int>::max());
+    EXPECT_EQ(result.path.getLength(), 0);
+
+    LandmarkHeuristic<int> landmarks(graph, reverse, 2);
+    landmarks.setTarget(3);
+    EXPECT_EQ(landmarks(1), std::numeric_limits<int>::max());
+    EXPECT_FALSE(ShortestPath<int>::aStar(graph, 0, 3, landmarks).found);
+
+    result = ShortestPath<int>::aStar(graph, 2, 2, ShortestPath<int>::zeroHeuristic);
+    EXPECT_TRUE(result.found);
+    EXPECT_EQ(result.distance, 0);
+    EXPECT_EQ(result.path.getLength(), 1);
+    result = ShortestPath<int>::bidirectionalDijkstra(graph, reverse, 3, 2);
+    EXPECT_EQ(result.distance, 6);
+    EXPECT_EQ(result.path.getLength(), 4);
+    EXPECT_THROW(ShortestPath<int>::aStar(graph, 0, 4, ShortestPath<int>::zeroHeuristic), std::out_of_range);
+}
+
+
+TEST(ContractionHierarchyTest, QueriesMatchDijkstra) {
+    DirectedGraph<int> directed = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 150, 0.03, 50);
+    UndirectedGraph<int> undirected = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 150, 0.03, 50);
+    const Graph<int> *graphs[] = {&directed, &undirected};
+    for (const Graph<int> *graph : graphs) {
+        ContractionHierarchy<int> hierarchy(*graph);
+        for (int source = 0; source < graph->getVertexCount(); source += 11) {
+            auto expected = ShortestPath<int>::dijkstra(*graph, source);
+            for (int target = 0; target < graph->getVertexCount(); ++target) {
+                ASSERT_EQ(hierarchy.distance(source, target), expected[target].first);
+                if (expected[target].first == std::numeric_limits<int>::max()) {
+                    EXPECT_THROW(hierarchy.getPath(source, target), std::runtime_error);
+                    continue;
+                }
+                auto path = hierarchy.getPath(source, target);
+                ASSERT_EQ(path.get(0), source);
+                ASSERT_EQ(path.get(path.getLength() - 1), target);
+                int length = 0;
+                for (int i = 1; i < path.getLength(); ++i) {
+                    ASSERT_TRUE(graph->hasEdge(path.get(i - 1), path.get(i)));
+                    length += graph->getEdgeWeight(path.get(i - 1), path.get(i));
+                }
+                ASSERT_EQ(length, expected[target].first);
+            }
+        }
+    }
+}
+
+TEST(ContractionHierarchyTest, SaveAndLoad) {
+    DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 80, 0.05, 20);
+    ContractionHierarchy<int> hierarchy(graph);
+    std::stringstream stream;
+    hierarchy.save(stream);
+
+    ContractionHierarchy<int> loaded = ContractionHierarchy<int>::load(stream);
+    EXPECT_EQ(loaded.getVertexCount(), 80);
+    EXPECT_EQ(loaded.getShortcutCount(), hierarchy.getShortcutCount());
+    for (int v = 0; v < 80; ++v) {
+        EXPECT_EQ(loaded.getRank(v), hierarchy.getRank(v));
+        EXPECT_EQ(loaded.distance(3, v), hierarchy.distance(3, v));
+    }
+
+    std::string bytes = stream.str();
+    std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+    EXPECT_THROW(ContractionHierarchy<int>::load(truncated), std::runtime_error);
+    std::stringstream wrongType(bytes);
+    EXPECT_THROW(ContractionHierarchy<double>::load(wrongType), std::runtime_error);
+    EXPECT_THROW(hierarchy.distance(0, 80), std::out_of_range);
+}
+
+TEST(AllPairsShortestPathsTest, MultiSourceAndFloydWarshallMatchDijkstra) {
+    ThreadPool pool(3);
+    DirectedGraph<int> directed = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 130, 0.05, 50);
+    UndirectedGraph<int> complete = GraphGenerator::generateUndirectedGraph(GraphGenerator::COMPLETE, 70, 1, 50);
+    const Graph<int> *graphs[] = {&directed, &complete};
+    for (const Graph<int> *graph : graphs) {
+        int n = graph->getVertexCount();
+        ArraySequence<int> sources;
+        for (int v = n - 1; v >= 0; v -= 3) {
+            sources.append(v);
+        }
+        auto batch = AllPairsShortestPaths<int>::multiSource(*graph, sources, pool);
+        ASSERT_EQ(batch.getRows(), sources.getLength());
+        auto dijkstra = AllPairsShortestPaths<int>::allPairs(*graph, pool, AllPairsShortestPaths<int>::DIJKSTRA);
+        auto automatic = AllPairsShortestPaths<int>::allPairs(*graph, pool);
+        for (int u = 0; u < n; ++u) {
+            auto expected = ShortestPath<int>::dijkstra(*graph, u);
+            for (int v = 0; v < n; ++v) {
+                ASSERT_EQ(dijkstra.get(u, v), expected[v].first);
+                ASSERT_EQ(automatic.get(u, v), expected[v].first);
+            }
+        }
+        for (int blockSize : {1, 16, 64, 1000}) {
+            auto floyd = AllPairsShortestPaths<int>::floydWarshall(*graph, pool, blockSize);
+            for (int u = 0; u < n; ++u) {
+                for (int v = 0; v < n; ++v) {
+                    ASSERT_EQ(floyd.get(u, v), dijkstra.get(u, v));
+                }
+            }
+        }
+        for (int i = 0; i < sources.getLength(); ++i) {
+            for (int v = 0; v < n; ++v) {
+                ASSERT_EQ(batch.get(i, v), dijkstra.get(sources[i], v));
+            }
+        }
+    }
+}
+
+TEST(AllPairsShortestPathsTest, NegativeWeightsAndErrors) {
+    ThreadPool pool(2);
+    DirectedGraph<int> graph(4);
+    graph.addEdge(0, 1, 4);
+    graph.addEdge(0, 2, 1);
+    graph.addEdge(2, 1, -2);
+    graph.addEdge(1, 3, 1);
+
+    auto floyd = AllPairsShortestPaths<int>::floydWarshall(graph, pool, 3);
+    EXPECT_EQ(floyd.get(0, 1), -1);
+    EXPECT_EQ(floyd.get(0, 3), 0);
+    EXPECT_EQ(floyd.get(3, 0), std::numeric_limits<int>::max());
+    EXPECT_THROW(floyd.get(4, 0), std::out_of_range);
+    EXPECT_THROW(AllPairsShortestPaths<int>::floydWarshall(graph, pool, 0), std::invalid_argument);
+
+    ArraySequence<int> sources;
+    sources.append(5);
+    EXPECT_THROW(AllPairsShortestPaths<int>::multiSource(graph, sources, pool), std::out_of_range);
+}
+
+TEST(IncrementalShortestPathTest, BatchesMatchRecomputation) {
+    DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 250, 0.02, 50);
+    IncrementalShortestPath<int> incremental(graph, 0);
+    WeightUpdateModel<int> model(graph, 2024, 0.05, 0.5);
+    WeightUpdateModel<int> sameSeed(graph, 2024, 0.05, 0.5);
+
+    for (int round = 0; round < 30; ++round) {
+        auto batch = model.nextBatch(round % 3 == 0 ? 1 : 40);
+        auto replay = sameSeed.nextBatch(round % 3 == 0 ? 1 : 40);
+        ASSERT_EQ(batch.getLength(), replay.getLength());
+        for (int i = 0; i < batch.getLength(); ++i) {
+            ASSERT_EQ(batch[i], replay[i]);
+            auto [from, to, weight] = batch[i];
+            graph.removeEdge(from, to);
+            graph.addEdge(from, to, weight);
+        }
+        incremental.updateEdges(batch);
+
+        auto expected = ShortestPath<int>::dijkstra(graph, 0);
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            ASSERT_EQ(incremental.getDistance(v), expected[v].first);
+            if (v != 0 && expected[v].first != std::numeric_limits<int>::max()) {
+                int predecessor = incremental.getPredecessor(v);
+                ASSERT_EQ(incremental.getDistance(predecessor) + graph.getEdgeWeight(predecessor, v),
+                          incremental.getDistance(v));
+            }
+        }
+    }
+    EXPECT_EQ(model.getStep(), 30);
+}
+
+TEST(IncrementalShortestPathTest, UndirectedBatchesUpdateBothDirections) {
+    UndirectedGraph<int> graph = GraphGenerator::generateUndirectedGraph(GraphGenerator::RANDOM, 120, 0.05, 50);
+    IncrementalShortestPath<int> incremental(graph, 0);
+    WeightUpdateModel<int> model(graph, 7, 0.05, 0.5);
+
+    for (int round = 0; round < 10; ++round) {
+        auto batch = model.nextBatch(20);
+        ASSERT_EQ(batch.getLength(), 40);
+        for (int i = 0; i < batch.getLength(); i += 2) {
+            auto [from, to, weight] = batch[i];
+            ASSERT_EQ(batch[i + 1], std::make_tuple(to, from, weight));
+            graph.removeEdge(from, to);
+            graph.addEdge(from, to, weight);
+        }
+        incremental.updateEdges(batch);
+
+        auto expected = ShortestPath<int>::dijkstra(graph, 0);
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            ASSERT_EQ(incremental.getDistance(v), expected[v].first);
+        }
+    }
+
+    // Неограниченный рост веса останавливается на максимуме типа
+    UndirectedGraph<int> single(2);
+    single.addEdge(0, 1, std::numeric_limits<int>::max() / 2);
+    WeightUpdateModel<int> growing(single, 1, 10.0, 0.0);
+    for (int round = 0; round < 3; ++round) {
+        auto batch = growing.nextBatch(1);
+        EXPECT_EQ(std::get<2>(batch[0]), std::numeric_limits<int>::max());
+    }
+}
+
+TEST(IncrementalShortestPathTest, SingleUpdatesAndErrors) {
+    DirectedGraph<int> graph(5);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 2, 1);
+    graph.addEdge(0, 2, 5);
+    graph.addEdge(2, 3, 1);
+
+    IncrementalShortestPath<int> incremental(graph, 0);
+    EXPECT_EQ(incremental.getDistance(3), 3);
+    EXPECT_EQ(incremental.getDistance(4), std::numeric_limits<int>::max());
+
+    incremental.updateEdge(1, 2, 10);
+    EXPECT_EQ(incremental.getDistance(3), 6);
+    EXPECT_EQ(incremental.getPredecessor(2), 0);
+    EXPECT_EQ(incremental.getEdgeWeight(1, 2), 10);
+
+    incremental.updateEdge(0, 1, 0);
+    incremental.updateEdge(1, 2, 2);
+    EXPECT_EQ(incremental.getDistance(3), 3);
+    auto path = incremental.getPath(3);
+    ASSERT_EQ(path.getLength(), 4);
+    EXPECT_EQ(path.get(1), 1);
+    EXPECT_EQ(ShortestPath<int>::getPath(incremental.getResult(), 3).getLength(), 4);
+
+    EXPECT_THROW(incremental.updateEdge(3, 4, 1), std::invalid_argument);
+    EXPECT_THROW(incremental.updateEdge(0, 1, -1), std::invalid_argument);
+    EXPECT_THROW(incremental.getPath(4), std::runtime_error);
+    EXPECT_THROW(IncrementalShortestPath<int>(graph, 5), std::out_of_range);
+}
+
+TEST(TimeDependentShortestPathTest, ConstantProfilesMatchDijkstra) {
+    DirectedGraph<int> graph = GraphGenerator::generateDirectedGraph(GraphGenerator::RANDOM, 200, 0.03, 40);
+    TimeDependentGraph<int> timed(graph);
+    EXPECT_EQ(timed.getBreakpointCount(), timed.getEdgeCount());
+
+    auto expected = ShortestPath<int>::dijkstra(graph, 0);
+    auto arrivals = TimeDependentShortestPath<int>::earliestArrival(timed, 0, 100);
+    for (int v = 0; v < graph.getVertexCount(); ++v) {
+        if (expected[v].first == std::numeric_limits<int>::max()) {
+            EXPECT_EQ(arrivals[v].first, std::numeric_limits<int>::max());
+            continue;
+        }
+        ASSERT_EQ(arrivals[v].first - 100, expected[v].first);
+        auto result = TimeDependentShortestPath<int>::query(timed, 0, v, 100);
+        ASSERT_TRUE(result.found);
+        EXPECT_EQ(result.distance, expected[v].first);
+        EXPECT_EQ(result.path.get(result.path.getLength() - 1), v);
+    }
+}
+
+TEST(TimeDependentShortestPathTest, RushHourProfileAndErrors) {
+    DirectedGraph<double> graph(4);
+    graph.addEdge(0, 1, 10);
+    graph.addEdge(0, 2, 6);
+    graph.addEdge(2, 1, 6);
+
+    // Ребро 0 -> 1 загружено около момента 10, объезд через 2 всегда занимает 12
+    TimeDependentGraph<double> timed(graph, [](int from, int to, double weight) {
+        ArraySequence<Pair<double, double>> profile;
+        if (from == 0 && to == 1) {
+            profile.append(Pair<double, double>(0, 10));
+            profile.append(Pair<double, double>(10, 30));
+            profile.append(Pair<double, double>(20, 20));
+        } else {
+            profile.append(Pair<double, double>(0, weight));
+        }
+        return profile;
+    });
+    EXPECT_EQ(timed.getBreakpointCount(), 5);
+    EXPECT_DOUBLE_EQ(timed.travelTime(0, 1, -5), 10);
+    EXPECT_DOUBLE_EQ(timed.travelTime(0, 1, 5), 20);
+    EXPECT_DOUBLE_EQ(timed.travelTime(0, 1, 15), 25);
+    EXPECT_DOUBLE_EQ(timed.travelTime(0, 1, 50), 20);
+
+    auto early = TimeDependentShortestPath<double>::query(timed, 0, 1, 0);
+    EXPECT_DOUBLE_EQ(early.distance, 10);
+    EXPECT_EQ(early.path.getLength(), 2);
+    auto rush = TimeDependentShortestPath<double>::query(timed, 0, 1, 10);
+    EXPECT_DOUBLE_EQ(rush.distance, 12);
+    EXPECT_EQ(rush.path.getLength(), 3);
+    EXPECT_FALSE(TimeDependentShortestPath<double>::query(timed, 0, 3, 0).found);
+    auto arrivals = TimeDependentShortestPath<double>::earliestArrival(timed, 0, 10);
+    EXPECT_EQ(ShortestPath<double>::getPath(arrivals, 1).getLength(), 3);
+
+    auto withProfile = [&graph](std::initializer_list<Pair<double, double>> points) {
+        return TimeDependentGraph<double>(graph, [points](int, int, double) {
+            ArraySequence<Pair<double, double>> profile;
+            for (const auto& point : points) profile.append(point);
+            return profile;
+        });
+    };
+    EXPECT_THROW(withProfile({}), std::invalid_argument);
+    EXPECT_THROW(withProfile({{0, 30}, {10, 5}}), std::invalid_argument);
+    EXPECT_THROW(withProfile({{10, 5}, {0, 5}}), std::invalid_argument);
+    EXPECT_THROW(withProfile({{0, -1}}), std::invalid_argument);
+    EXPECT_NO_THROW(withProfile({{0, 30}, {10, 20}}));
+    EXPECT_THROW(timed.travelTime(1, 0, 0), std::invalid_argument);
+    EXPECT_THROW(TimeDependentShortestPath<double>::query(timed, 0, 4, 0), std::out_of_range);
+    EXPECT_THROW(TimeDependentShortestPath<double>::earliestArrival(timed, -1, 0), std::out_of_range);
+}
+
+TEST(TimeDependentShortestPathTest, FullDayProfileInSeconds) {
+    DirectedGraph<int> graph(3);
+    graph.addEdge(0, 1, 600);
+    graph.addEdge(1, 2, 60);
+
+    // Суточный профиль в секундах: произведение интервалов (35400 * 80000) не помещается в int
+    TimeDependentGraph<int> timed(graph, [](int from, int, int weight) {
+        ArraySequence<Pair<int, int>> profile;
+        profile.append(Pair<int, int>(0, weight));
+        if (from == 0) profile.append(Pair<int, int>(86400, 36000));
+        return profile;
+    });
+    EXPECT_EQ(timed.travelTime(0, 1, 80000), 600 + 32777);
+    EXPECT_EQ(timed.travelTime(0, 1, 43200), 600 + 17700);
+
+    auto arrivals = TimeDependentShortestPath<int>::earliestArrival(timed, 0, 80000);
+    EXPECT_EQ(arrivals[1].first, 80000 + 33377);
+    EXPECT_EQ(arrivals[2].first, 80000 + 33377 + 60);
+}
 
 TEST(DynamicWeightShortestPathTest, InvalidSource) {
     DirectedGraph<int> graph(3);
@@ -660,6 +1711,26 @@ TEST(Lattice, InvalidElements) {
 
 }
 
+TEST(Lattice, ConcurrentLessEqual) {
+    ArraySequence<int> elements;
+    for (int i = 1; i <= 24; ++i) {
+        elements.append(i);
+    }
+    // Делимость: a <= b, если a делит b
+    const Lattice<int> lattice(elements, [](const int& a, const int& b) {
+        return b % a == 0;
+    });
+
+    ThreadPool pool(4);
+    std::atomic<int> mismatches{0};
+    pool.parallelFor(24 * 24, 16, [&](int i, unsigned) {
+        int a = i / 24 + 1;
+        int b = i % 24 + 1;
+        if (lattice.lessEqual(a, b) != (b % a == 0)) ++mismatches;
+    });
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
 TEST(GraphGenerator, GenerateTree) {
     int vertices = 7;
     int maxWeight = 50;
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include "../include/sequence/PriorityQueue.h"
+#include "../include/sequence/IndexedPriorityQueue.h"
+#include <random>
 
 // Basic Structure Tests
 TEST(PriorityQueue, BasicStructure) {
@@ -77,6 +79,12 @@ TEST(PriorityQueue, PeekOperations) {
     ASSERT_EQ(pq.PeekLast().first, 1);
     ASSERT_EQ(pq.PeekLast().second, 1);
 
+    // Test Peek by index (ascending priority)
+    ASSERT_EQ(pq.Peek(0).first, 1);
+    ASSERT_EQ(pq.Peek(2).first, 3);
+    ASSERT_THROW(pq.Peek(3), std::out_of_range);
+    ASSERT_THROW(pq.Peek(-1), std::out_of_range);
+
     // Verify size hasn't changed
     ASSERT_EQ(pq.size(), 3);
 }
@@ -139,4 +147,74 @@ TEST(PriorityQueue, StressTest) {
     }
 
     ASSERT_TRUE(pq.isEmpty());
-}
\ No newline at end of file
+}
+
+// IndexedPriorityQueue: извлечение в порядке возрастания приоритета
+TEST(IndexedPriorityQueue, DequeueOrder) {
+    IndexedPriorityQueue<int> pq(10);
+    ASSERT_TRUE(pq.isEmpty());
+
+    pq.Enqueue(3, 30);
+    pq.Enqueue(1, 10);
+    pq.Enqueue(7, 5);
+    ASSERT_EQ(pq.size(), 3);
+    ASSERT_EQ(pq.PeekFirst().first, 7);
+    ASSERT_EQ(pq.PeekFirst().second, 5);
+
+    ASSERT_EQ(pq.Dequeue().first, 7);
+    ASSERT_EQ(pq.Dequeue().first, 1);
+    ASSERT_EQ(pq.Dequeue().first, 3);
+    ASSERT_TRUE(pq.isEmpty());
+    ASSERT_THROW(pq.Dequeue(), std::out_of_range);
+    ASSERT_THROW(pq.PeekFirst(), std::out_of_range);
+}
+
+TEST(IndexedPriorityQueue, DecreaseKeyAndContains) {
+    IndexedPriorityQueue<double, 2> pq;
+    pq.Enqueue(0, 5.0);
+    pq.Enqueue(1, 4.0);
+    pq.Enqueue(25, 3.0); // Ёмкость растёт автоматически
+
+    ASSERT_TRUE(pq.contains(25));
+    ASSERT_FALSE(pq.contains(2));
+    ASSERT_THROW(pq.Enqueue(1, 1.0), std::invalid_argument);
+
+    pq.decreaseKey(0, 1.0);
+    ASSERT_EQ(pq.PeekFirst().first, 0);
+    ASSERT_DOUBLE_EQ(pq.getPriority(0), 1.0);
+    ASSERT_THROW(pq.decreaseKey(1, 10.0), std::invalid_argument);
+    ASSERT_THROW(pq.decreaseKey(2, 0.0), std::out_of_range);
+
+    pq.Dequeue();
+    ASSERT_FALSE(pq.contains(0));
+    pq.clear();
+    ASSERT_TRUE(pq.isEmpty());
+    ASSERT_FALSE(pq.contains(25));
+    pq.Enqueue(25, 7.0);
+    ASSERT_EQ(pq.PeekFirst().first, 25);
+}
+
+TEST(IndexedPriorityQueue, RandomizedAgainstSortedOrder) {
+    const int TEST_SIZE = 2000;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, 100000);
+
+    IndexedPriorityQueue<int, 3> pq(TEST_SIZE);
+    std::vector<int> priority(TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; ++i) {
+        priority[i] = dis(gen);
+        pq.Enqueue(i, priority[i]);
+    }
+    for (int i = 0; i < TEST_SIZE; i += 3) {
+        priority[i] /= 2;
+        pq.decreaseKey(i, priority[i]);
+    }
+
+    std::vector<int> expected = priority;
+    std::sort(expected.begin(), expected.end());
+    for (int i = 0; i < TEST_SIZE; ++i) {
+        auto item = pq.Dequeue();
+        ASSERT_EQ(item.second, expected[i]);
+        ASSERT_EQ(priority[item.first], item.second);
+    }
+}
@@ -4,12 +4,18 @@
 #include <cassert>
 #include <codecvt>
 #include <cstring>
+#include <future>
 #include <iostream>
 #include <locale>
+#include <memory>
 #include <set>
 #include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "../sequence/ArraySequence.h"
+#include "NodePool.h"
 
 using namespace std;
 
@@ -30,19 +36,26 @@ private:
         T value;
         Node *left = nullptr;
         Node *right = nullptr;
+        Node *parent = nullptr;  // Kept up to date by reCalc of the parent
         Node *next = nullptr;
         int height = 1;
         int dis = 0;
+        int count = 1;  // Number of nodes in the subtree (order statistics)
 
+        // Every structural change recalculates the changed nodes bottom-up,
+        // so children get their parent pointer and subtree sizes stay valid here
         void reCalc() {
             int leftHeight = (left!= nullptr) ? left->height : 0;
             int rightHeight = (right!= nullptr) ? right->height : 0;
             height = std::max(leftHeight, rightHeight) + 1;
             dis = leftHeight - rightHeight;
+            count = 1 + (left ? left->count : 0) + (right ? right->count : 0);
+            if (left) left->parent = this;
+            if (right) right->parent = this;
         }
 
         explicit Node(T value, Node *left = nullptr, Node *right = nullptr)
-                : value(value), left(left), right(right) {
+                : value(std::move(value)), left(left), right(right) {
             reCalc();
         }
 
@@ -83,23 +96,66 @@ private:
         }
     };
 
+public:
+    // Slab allocator type for the nodes of this tree (see NodePool)
+    using Pool = NodePool<Node>;
+
+private:
     Node *root = nullptr;
     int size = 0;
-    Node *first;  // For threading
+    Node *first = nullptr;  // For threading
+    std::shared_ptr<Pool> pool;  // Created lazily unless a shared pool is given
+    bool sharedPool = false;     // Pool is shared with other trees
 
     //Private utility methods
+    template<class Value>
+    Node *newNode(Value &&value) {
+        if (!pool) pool = std::make_shared<Pool>();
+        return pool->create(std::forward<Value>(value));
+    }
+
+    // Builds a perfectly balanced subtree from positions [from, to] of the input.
+    // Nodes are created in order, so they also lie in order in the pool.
+    template<class ValueAt>
+    Node *buildBalanced(int from, int to, ValueAt &valueAt, Node *&previous, bool &sorted) {
+        if (from > to) return nullptr;
+        int middle = from + (to - from) / 2;
+        Node *left = buildBalanced(from, middle - 1, valueAt, previous, sorted);
+        Node *n = newNode(valueAt(middle));
+        if (previous && n->value < previous->value) sorted = false;
+        previous = n;
+        n->left = left;
+        n->right = buildBalanced(middle + 1, to, valueAt, previous, sorted);
+        n->reCalc();
+        return n;
+    }
+
     void delTree(Node *tree) {
         if (tree == nullptr) return;
         delTree(tree->left);
         delTree(tree->right);
-        delete tree;
+        pool->destroy(tree);
+    }
+
+    // Releases all nodes; an exclusively owned pool is dropped as a whole
+    void releaseNodes() {
+        if (root != nullptr) {
+            if (!sharedPool && std::is_trivially_destructible_v<T>) {
+                pool.reset();
+            } else {
+                delTree(root);
+            }
+        }
+        root = nullptr;
+        size = 0;
+        first = nullptr;
     }
 
     Node* copyTree(const Node* n) {
         if (n == nullptr) {
             return nullptr;
         }
-        Node* newNode = new Node(n->value);
+        Node* newNode = this->newNode(n->value);
         newNode->left = copyTree(n->left);
         newNode->right = copyTree(n->right);
         newNode->reCalc();
@@ -130,22 +186,17 @@ private:
         }
     }
 
-    Node *copy(Node *n) {
-        if (n == nullptr) return nullptr;
-        return new Node(n->value, copy(n->left), copy(n->right));
-    }
-
     Node *insertTo(Node *n, const T &v) {
         if (v <= n->value) {
             if (n->left)
                 n->left = insertTo(n->left, v);
             else
-                n->left = new Node(v);
+                n->left = newNode(v);
         } else {
             if (n->right)
                 n->right = insertTo(n->right, v);
             else
-                n->right = new Node(v);
+                n->right = newNode(v);
         }
         return balance(n);
     }
@@ -161,6 +212,16 @@ private:
             r->right = removeTo(r->right, v);
             return balance(r);
         }
+        if (!(v == r->value)) {
+            // Equivalent by order but a different value (e.g. Pair with equal priority):
+            // after rotations such values may lie in either subtree
+            int oldSize = size;
+            r->left = removeTo(r->left, v);
+            if (size == oldSize) {
+                r->right = removeTo(r->right, v);
+            }
+            return balance(r);
+        }
 
         // Found the node to remove
         if (r->left && r->right) {
@@ -172,7 +233,7 @@ private:
             Node *toDelete = r;
             r = (r->left) ? r->left : r->right;
             size--;
-            delete toDelete;
+            pool->destroy(toDelete);
         }
         return balance(r);
     }
@@ -189,6 +250,39 @@ private:
         return nullptr;
     }
 
+    // Node with the given in-order index, O(log n)
+    Node *selectNode(int index) const {
+        if (index < 0 || index >= size) throw std::out_of_range("Index out of range");
+        Node *n = root;
+        while (true) {
+            int leftCount = n->left ? n->left->count : 0;
+            if (index < leftCount) {
+                n = n->left;
+            } else if (index == leftCount) {
+                return n;
+            } else {
+                index -= leftCount + 1;
+                n = n->right;
+            }
+        }
+    }
+
+    // Number of elements x with x < v (strict) or !(v < x) (inclusive), O(log n)
+    int countBelow(const T &v, bool inclusive) const {
+        int result = 0;
+        Node *n = root;
+        while (n != nullptr) {
+            bool goRight = inclusive ? !(v < n->value) : n->value < v;
+            if (goRight) {
+                result += 1 + (n->left ? n->left->count : 0);
+                n = n->right;
+            } else {
+                n = n->left;
+            }
+        }
+        return result;
+    }
+
     Node *minimum(Node *n) const {
         if (n == nullptr) throw std::range_error("Empty tree");
         Node *current = n;
@@ -255,6 +349,182 @@ private:
         return rightRotation(a);
     }
 
+    // Join-based set operations (Blelloch, Ferizovic, Sun: "Just Join for Parallel Ordered Sets").
+    // They relink existing nodes only; nodes to be freed are collected in garbage
+    // and released after all parallel tasks have finished, so the pool is never
+    // touched concurrently.
+
+    // Subtrees with more nodes than this (both inputs together) are processed in parallel
+    static constexpr int PARALLEL_GRAIN = 1 << 15;
+
+    static int heightOf(const Node *n) { return n ? n->height : 0; }
+    static int countOf(const Node *n) { return n ? n->count : 0; }
+
+    // Joins l < k < r where l is taller: k is attached at the right spine of l
+    Node *joinRight(Node *l, Node *k, Node *r) {
+        if (heightOf(l->right) <= heightOf(r) + 1) {
+            k->left = l->right;
+            k->right = r;
+            k->reCalc();
+            l->right = k;
+        } else {
+            l->right = joinRight(l->right, k, r);
+        }
+        return balance(l);
+    }
+
+    Node *joinLeft(Node *l, Node *k, Node *r) {
+        if (heightOf(r->left) <= heightOf(l) + 1) {
+            k->left = l;
+            k->right = r->left;
+            k->reCalc();
+            r->left = k;
+        } else {
+            r->left = joinLeft(l, k, r->left);
+        }
+        return balance(r);
+    }
+
+    // Balanced tree of all elements of l, then k, then all elements of r; O(|h(l) - h(r)|)
+    Node *join(Node *l, Node *k, Node *r) {
+        if (heightOf(l) > heightOf(r) + 1) return joinRight(l, k, r);
+        if (heightOf(r) > heightOf(l) + 1) return joinLeft(l, k, r);
+        k->left = l;
+        k->right = r;
+        k->reCalc();
+        return k;
+    }
+
+    // Detaches the maximum of t into last and returns the rest
+    Node *splitLast(Node *t, Node *&last) {
+        if (t->right == nullptr) {
+            last = t;
+            Node *rest = t->left;
+            t->left = nullptr;
+            t->reCalc();
+            return rest;
+        }
+        Node *right = splitLast(t->right, last);
+        return join(t->left, t, right);
+    }
+
+    // Join without a middle element
+    Node *join2(Node *l, Node *r) {
+        if (l == nullptr) return r;
+        Node *last = nullptr;
+        Node *rest = splitLast(l, last);
+        return join(rest, last, r);
+    }
+
+    // Splits t into elements less than key, an element equal to key (or nullptr) and greater ones
+    void split(Node *t, const T &key, Node *&less, Node *&equal, Node *&greater) {
+        if (t == nullptr) {
+            less = equal = greater = nullptr;
+            return;
+        }
+        Node *l = t->left;
+        Node *r = t->right;
+        if (key < t->value) {
+            Node *middle = nullptr;
+            split(l, key, less, equal, middle);
+            greater = join(middle, t, r);
+        } else if (t->value < key) {
+            Node *middle = nullptr;
+            split(r, key, middle, equal, greater);
+            less = join(l, t, middle);
+        } else {
+            less = l;
+            greater = r;
+            equal = t;
+            t->left = t->right = nullptr;
+            t->reCalc();
+        }
+    }
+
+    enum class SetOperation { UNION, INTERSECTION, DIFFERENCE };
+
+    // Runs left and right branches, forking the left one into a new thread for large inputs
+    template<class Left, class Right>
+    void forkJoin(bool parallel, DynamicArray<Node *> &garbage, Left &&left, Right &&right) {
+        if (!parallel) {
+            left(garbage);
+            right(garbage);
+            return;
+        }
+        DynamicArray<Node *> leftGarbage;
+        auto task = std::async(std::launch::async, [&] { left(leftGarbage); });
+        right(garbage);
+        task.get();
+        for (int i = 0; i < leftGarbage.getSize(); ++i) {
+            garbage.append(leftGarbage[i]);
+        }
+    }
+
+    Node *setOperation(Node *a, Node *b, SetOperation operation, int depth, DynamicArray<Node *> &garbage) {
+        if (a == nullptr || b == nullptr) {
+            switch (operation) {
+                case SetOperation::UNION:
+                    return a ? a : b;
+                case SetOperation::INTERSECTION:
+                    if (a) garbage.append(a);
+                    if (b) garbage.append(b);
+                    return nullptr;
+                case SetOperation::DIFFERENCE:
+                    if (b) garbage.append(b);
+                    return a;
+            }
+        }
+        Node *left = a->left;
+        Node *right = a->right;
+        a->left = a->right = nullptr;
+        a->reCalc();
+
+        Node *bLess = nullptr, *bEqual = nullptr, *bGreater = nullptr;
+        split(b, a->value, bLess, bEqual, bGreater);
+
+        bool parallel = depth > 0 && countOf(left) + countOf(right) + countOf(bLess) + countOf(bGreater) > PARALLEL_GRAIN;
+        Node *leftResult = nullptr;
+        Node *rightResult = nullptr;
+        forkJoin(parallel, garbage,
+                 [&](DynamicArray<Node *> &g) { leftResult = setOperation(left, bLess, operation, depth - 1, g); },
+                 [&](DynamicArray<Node *> &g) { rightResult = setOperation(right, bGreater, operation, depth - 1, g); });
+
+        if (bEqual) garbage.append(bEqual);
+        bool keepA = operation == SetOperation::UNION
+                     || (operation == SetOperation::INTERSECTION) == (bEqual != nullptr);
+        if (keepA) return join(leftResult, a, rightResult);
+        garbage.append(a);
+        return join2(leftResult, rightResult);
+    }
+
+    // Applies a set operation with other (consumed) and stores the result in this tree
+    void applySetOperation(AVLBinaryTree &&other, SetOperation operation, unsigned threads) {
+        Node *otherRoot = nullptr;
+        if (other.root != nullptr) {
+            if (pool && other.pool == pool) {
+                otherRoot = other.root;  // Same pool: nodes can be relinked directly
+                other.root = nullptr;
+                other.size = 0;
+            } else {
+                otherRoot = copyTree(other.root);
+                other.clear();
+            }
+        }
+
+        int depth = 0;
+        for (; threads > 1; threads /= 2) {
+            depth += 2;  // Some oversubscription evens out unbalanced splits
+        }
+        DynamicArray<Node *> garbage;
+        root = setOperation(root, otherRoot, operation, depth, garbage);
+        for (int i = 0; i < garbage.getSize(); ++i) {
+            delTree(garbage[i]);
+        }
+        if (root) root->parent = nullptr;
+        size = countOf(root);
+        first = nullptr;
+    }
+
     // Threading operations
     struct Thread : public Operation {
         Node *first = nullptr;
@@ -271,54 +541,141 @@ public:
     // Constructors and destructor
     AVLBinaryTree() = default;
 
-    // Конструктор копирования
+    // Дерево, выделяющее узлы из общего пула (например, один пул на все списки смежности графа)
+    explicit AVLBinaryTree(std::shared_ptr<Pool> sharedPool)
+            : pool(std::move(sharedPool)), sharedPool(pool != nullptr) {}
+
+    // Конструктор копирования (копия дерева с общим пулом использует тот же пул)
     AVLBinaryTree(const AVLBinaryTree& other) {
+        if (other.sharedPool) {
+            pool = other.pool;
+            sharedPool = true;
+        }
         root = copyTree(other.root);
+        if (root) root->parent = nullptr;
         size = other.size;
     }
 
     // Оператор присваивания
     AVLBinaryTree& operator=(const AVLBinaryTree& other) {
         if (this != &other) {
-            delTree(root);
+            releaseNodes();
+            if (!sharedPool && other.sharedPool) {
+                pool = other.pool;
+                sharedPool = true;
+            }
             root = copyTree(other.root);
+            if (root) root->parent = nullptr;
             size = other.size;
         }
         return *this;
     }
 
     // Конструктор перемещения
-    AVLBinaryTree(AVLBinaryTree&& other) noexcept : root(other.root), size(other.size) {
+    AVLBinaryTree(AVLBinaryTree&& other) noexcept
+            : root(other.root), size(other.size), pool(std::move(other.pool)), sharedPool(other.sharedPool) {
         other.root = nullptr;
         other.size = 0;
+        other.first = nullptr;
+        if (other.sharedPool) other.pool = pool;
     }
 
-    // Оператор перемещения
-    AVLBinaryTree& operator=(AVLBinaryTree&& other) noexcept {
+    // Оператор перемещения. Дерево с общим пулом, как при копировании и clear(), остаётся в нём:
+    // узлы из другого пула копируются (поэтому оператор не noexcept), other очищается
+    AVLBinaryTree& operator=(AVLBinaryTree&& other) {
         if (this != &other) {
-            delTree(root);
+            if (sharedPool && other.pool != pool) {
+                Node *copy = copyTree(other.root);
+                releaseNodes();
+                root = copy;
+                if (root) root->parent = nullptr;
+                size = other.size;
+                other.clear();
+                return *this;
+            }
+            releaseNodes();
             root = other.root;
             size = other.size;
+            pool = other.pool;
+            sharedPool = other.sharedPool;
             other.root = nullptr;
             other.size = 0;
+            other.first = nullptr;
+            if (!other.sharedPool) other.pool.reset();
         }
         return *this;
     }
 
+    // Sorts a copy of the sequence (skipped if already sorted) and bulk-loads it
     explicit AVLBinaryTree(const ArraySequence<T> &seq) {
+        std::vector<T> values;
+        values.reserve(seq.getLength());
         for (int i = 0; i < seq.getLength(); i++)
-            insert(seq.get(i));
+            values.push_back(seq.get(i));
+        if (!std::is_sorted(values.begin(), values.end()))
+            std::stable_sort(values.begin(), values.end());
+        buildSorted((int) values.size(), [&values](int i) -> T & { return values[i]; });
     }
     explicit AVLBinaryTree(const std::set<T> &set) {
-        for (T x : set)
-            insert(x);
+        std::vector<T> values(set.begin(), set.end());
+        buildSorted((int) values.size(), [&values](int i) -> T & { return values[i]; });
     }
 
     ~AVLBinaryTree() {
-        delTree(root);
-        root = nullptr;
-        size = 0;
-        first = nullptr;
+        releaseNodes();
+    }
+
+    // Удаляет все элементы, сохраняя режим пула
+    void clear() {
+        releaseNodes();
+    }
+
+    // Заменяет содержимое идеально сбалансированным деревом из значений valueAt(0), ..., valueAt(count - 1),
+    // заданных в неубывающем порядке, за O(n). valueAt вызывается по возрастанию индекса.
+    // @throws std::invalid_argument если значения не отсортированы
+    template<class ValueAt>
+    void buildSorted(int count, ValueAt valueAt) {
+        if (count < 0) throw std::invalid_argument("Count < 0");
+        releaseNodes();
+        Node *previous = nullptr;
+        bool sorted = true;
+        Node *built = buildBalanced(0, count - 1, valueAt, previous, sorted);
+        if (!sorted) {
+            delTree(built);
+            throw std::invalid_argument("Values must be sorted");
+        }
+        root = built;
+        if (root) root->parent = nullptr;
+        size = count;
+    }
+
+    // Копия дерева other, выделяющая узлы из заданного пула (общий режим)
+    AVLBinaryTree(const AVLBinaryTree& other, std::shared_ptr<Pool> sharedPool)
+            : pool(std::move(sharedPool)), sharedPool(pool != nullptr) {
+        root = copyTree(other.root);
+        if (root) root->parent = nullptr;
+        size = other.size;
+    }
+
+    // Операции над множествами для деревьев без повторяющихся элементов.
+    // Результат сохраняется в этом дереве, other поглощается. Работа O(m log(n/m + 1)), m <= n;
+    // большие подзадачи выполняются параллельно в threads потоках. Если other выделяет узлы
+    // из другого пула, они сначала копируются в пул этого дерева.
+    void unionWith(AVLBinaryTree &&other, unsigned threads = std::thread::hardware_concurrency()) {
+        applySetOperation(std::move(other), SetOperation::UNION, threads);
+    }
+
+    void intersectWith(AVLBinaryTree &&other, unsigned threads = std::thread::hardware_concurrency()) {
+        applySetOperation(std::move(other), SetOperation::INTERSECTION, threads);
+    }
+
+    void differenceWith(AVLBinaryTree &&other, unsigned threads = std::thread::hardware_concurrency()) {
+        applySetOperation(std::move(other), SetOperation::DIFFERENCE, threads);
+    }
+
+    // Пул, из которого выделяются узлы (nullptr, пока дерево не выделило ни одного узла)
+    std::shared_ptr<Pool> getPool() const {
+        return pool;
     }
 
     bool find(const T &v) const {
@@ -335,6 +692,7 @@ public:
 
     void remove(const T &v) {
         root = removeTo(root, v);
+        if (root) root->parent = nullptr;
     }
 
     // Basic operations
@@ -346,7 +704,8 @@ public:
         if (root)
             root = insertTo(root, value);
         else
-            root = new Node(value);
+            root = newNode(value);
+        root->parent = nullptr;
     }
 
     // Tree properties
@@ -364,6 +723,24 @@ public:
         return maximum(root)->value;
     }
 
+    // Order statistics
+
+    // k-th smallest element (0-based)
+    const T &select(int index) const {
+        return selectNode(index)->value;
+    }
+
+    // Number of elements strictly less than v, i.e. index of the first element not less than v
+    int rank(const T &v) const {
+        return countBelow(v, false);
+    }
+
+    // Number of elements x with low <= x <= high
+    int countInRange(const T &low, const T &high) const {
+        if (high < low) return 0;
+        return countBelow(high, true) - countBelow(low, false);
+    }
+
     void threadNLR() {
         first = nullptr;
         Thread td;
@@ -386,7 +763,8 @@ public:
         cout << endl;
     }
 
-    // Итератор для AVLBinaryTree с использованием обхода Морриса
+    // Итератор для AVLBinaryTree: переход к следующему узлу по указателям на родителя,
+    // полный обход занимает O(n)
     struct Iterator {
         using iterator_category = std::forward_iterator_tag;
         using difference_type = std::ptrdiff_t;
@@ -394,9 +772,9 @@ public:
         using pointer = T *;
         using reference = T &;
 
-        explicit Iterator(Node *node) : current(node), root(node) {
+        explicit Iterator(Node *node, bool leftmost = true) : current(node) {
             try {
-                moveToLeftmost();
+                if (leftmost) moveToLeftmost();
             } catch (...) {
                 throw std::runtime_error("Error during iterator initialization");
             }
@@ -441,7 +819,6 @@ public:
 
     private:
         Node *current; // Текущий узел
-        Node *root;    // Корень дерева
 
         void moveToLeftmost() {
             while (current && current->left) {
@@ -459,19 +836,13 @@ public:
                     current = current->left;
                 }
             } else {
-                // Ищем ближайшего родителя, у которого текущий узел — левый потомок
-                Node *successor = nullptr;
-                Node *ancestor = root;
-
-                while (ancestor != current) {
-                    if (current->value < ancestor->value) {
-                        successor = ancestor;
-                        ancestor = ancestor->left;
-                    } else {
-                        ancestor = ancestor->right;
-                    }
+                // Поднимаемся к ближайшему предку, для которого текущая ветвь — левое поддерево
+                Node *child = current;
+                current = current->parent;
+                while (current && current->right == child) {
+                    child = current;
+                    current = current->parent;
                 }
-                current = successor;
             }
         }
     };
@@ -491,6 +862,12 @@ public:
         }
     }
 
+    // Iterator positioned at the element with the given index (end() if index == size), O(log n)
+    Iterator iteratorAt(int index) const {
+        if (index == size) return end();
+        return Iterator(selectNode(index), false);
+    }
+
 };
 
 #endif //LAB3_SEM3_AVLBINARYTREE_H
\ No newline at end of file
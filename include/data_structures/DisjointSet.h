@@ -0,0 +1,90 @@
+#ifndef LAB4_SEM3_DISJOINTSET_H
+#define LAB4_SEM3_DISJOINTSET_H
+
+#include <stdexcept>
+#include <utility>
+
+#include "../sequence/DynamicArray.h"
+
+/**
+ * Union-find over elements 0..size-1 with union by rank and path halving.
+ *
+ * Parents and ranks live in two flat arrays, so a find walks a few ints
+ * instead of chasing tree nodes. Elements can be appended at any time,
+ * which lets callers feed edges whose endpoints are not known in advance.
+ */
+class DisjointSet {
+private:
+    DynamicArray<int> parent;
+    DynamicArray<unsigned char> rank;  // Upper bound on tree height, at most log2(size)
+    int setCount = 0;
+
+    void checkElement(int element) const {
+        if (element < 0 || element >= parent.getSize()) {
+            throw std::out_of_range("Element is out of range");
+        }
+    }
+
+public:
+    explicit DisjointSet(int size = 0) : parent(size), rank(size), setCount(size) {
+        for (int i = 0; i < size; ++i) {
+            parent[i] = i;
+        }
+    }
+
+    // Adds a singleton set and returns its element
+    int addElement() {
+        int element = parent.getSize();
+        parent.append(element);
+        rank.append(0);
+        ++setCount;
+        return element;
+    }
+
+    // Grows the universe so that element is valid
+    void ensureSize(int size) {
+        if (size > parent.getSize()) {
+            parent.reserve(size);
+            rank.reserve(size);
+        }
+        while (parent.getSize() < size) {
+            addElement();
+        }
+    }
+
+    // Root of the set containing element; every visited node skips to its grandparent
+    int find(int element) {
+        checkElement(element);
+        while (parent[element] != element) {
+            parent[element] = parent[parent[element]];
+            element = parent[element];
+        }
+        return element;
+    }
+
+    // Merges the sets of a and b; returns false if they were already one set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (rank[a] < rank[b]) std::swap(a, b);
+        parent[b] = a;
+        if (rank[a] == rank[b]) ++rank[a];
+        --setCount;
+        return true;
+    }
+
+    bool connected(int a, int b) {
+        return find(a) == find(b);
+    }
+
+    int getSize() const {
+        return parent.getSize();
+    }
+
+    int getSetCount() const {
+        return setCount;
+    }
+};
+
+#endif //LAB4_SEM3_DISJOINTSET_H
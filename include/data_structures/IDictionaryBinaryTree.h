@@ -37,9 +37,15 @@ class IDictionaryBinaryTree : public IDictionary<TKey, TValue> {
     AVLBinaryTree<KeyValuePair> tree;
 
 public:
+    // Пул узлов, который можно разделить между несколькими словарями
+    using Pool = typename AVLBinaryTree<KeyValuePair>::Pool;
+
     // Конструктор по умолчанию
     IDictionaryBinaryTree() = default;
 
+    // Словарь, выделяющий узлы из общего пула
+    explicit IDictionaryBinaryTree(std::shared_ptr<Pool> pool) : tree(std::move(pool)) {}
+
     // Конструктор копирования
     IDictionaryBinaryTree(const IDictionaryBinaryTree& other) : tree(other.tree) {}
 
@@ -54,8 +60,8 @@ public:
     // Конструктор перемещения
     IDictionaryBinaryTree(IDictionaryBinaryTree&& other) noexcept : tree(std::move(other.tree)) {}
 
-    // Оператор перемещения
-    IDictionaryBinaryTree& operator=(IDictionaryBinaryTree&& other) noexcept {
+    // Оператор перемещения (копирует узлы, если словарь с общим пулом получает узлы другого пула)
+    IDictionaryBinaryTree& operator=(IDictionaryBinaryTree&& other) {
         if (this != &other) {
             tree = std::move(other.tree);
         }
@@ -101,6 +107,20 @@ public:
         tree.insert(KeyValuePair(key, value));
     }
 
+    // Заменяет содержимое парами (keyAt(i), valueAt(i)), i = 0..count-1, за O(n);
+    // ключи должны строго возрастать
+    template<class KeyAt, class ValueAt>
+    void BuildFromSorted(int count, KeyAt keyAt, ValueAt valueAt) {
+        for (int i = 1; i < count; ++i) {
+            if (!(keyAt(i - 1) < keyAt(i))) {
+                throw std::invalid_argument("Keys must be strictly increasing");
+            }
+        }
+        tree.buildSorted(count, [&keyAt, &valueAt](int i) {
+            return KeyValuePair(keyAt(i), valueAt(i));
+        });
+    }
+
     // Удаление по ключу
     void Remove(const TKey &key) override {
         if (!ContainsKey(key)) {
@@ -111,8 +131,7 @@ public:
 
     // Очистка словаря
     void Clear() {
-        tree.~AVLBinaryTree();
-        new (&tree) AVLBinaryTree<KeyValuePair>();
+        tree.clear();
     }
 
     // Получение количества элементов
@@ -4,10 +4,12 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <future>
 #include <iostream>
 #include <vector>
 #include <sstream>
 #include <set>
+#include <thread>
 #include "AVLBinaryTree.h"
 #include "ISet.h"
 #include "../sequence/ArraySequence.h"
@@ -20,9 +22,15 @@ private:
 public:
     // Constructors
     ISetBinaryTree() = default;  // Empty set
-    explicit ISetBinaryTree(const ArraySequence<T>& sequence) {
+    explicit ISetBinaryTree(std::shared_ptr<typename AVLBinaryTree<T>::Pool> pool) : tree(std::move(pool)) {}  // Nodes from a shared pool
+    explicit ISetBinaryTree(const ArraySequence<T>& sequence) {  // Sorted bulk load without duplicates
+        std::vector<T> values;
+        values.reserve(sequence.getLength());
         for (int i = 0; i < sequence.getLength(); i++)
-            insert(sequence.get(i));
+            values.push_back(sequence.get(i));
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        tree.buildSorted((int) values.size(), [&values](int i) -> T& { return values[i]; });
     }
     ISetBinaryTree(const ISetBinaryTree<T>& set) : tree(set.tree) {}
     explicit ISetBinaryTree(std::set<T> set) : tree(set) {}
@@ -48,33 +56,38 @@ public:
         tree.remove(value);
     }
 
-    // Union of sets
+    // Union of sets: copies of both trees are merged by join-based union, O(m log(n/m + 1)) work
     ISet<T>* setUnion(ISet<T> &s)  override{
-        auto* result = new ISetBinaryTree<T>();
-        for (T x : tree) result->insert(x);
-        for (T x : dynamic_cast<ISetBinaryTree<T>&>(s)) result->insert(x);
+        auto *other = dynamic_cast<ISetBinaryTree<T>*>(&s);
+        if (other == nullptr) {
+            throw std::invalid_argument("Operation not supported");
+        }
+        const ISetBinaryTree<T> &smaller = size() <= other->size() ? *this : *other;
+        const ISetBinaryTree<T> &larger = size() <= other->size() ? *other : *this;
+        auto* result = new ISetBinaryTree<T>(larger);
+        result->tree.unionWith(AVLBinaryTree<T>(smaller.tree, result->tree.getPool()));
         return result;
     }
 
-    // Intersection of sets
+    // Intersection of sets: the smaller set is scanned in parallel chunks with lookups in the larger,
+    // so the larger tree is never copied
     ISet<T>* intersection(ISet<T> &s) override {
-        auto* result = new ISetBinaryTree<T>();
-        for (T x : tree) {
-            if (s.find(x)) {
-                result->insert(x);
-            }
+        auto *other = dynamic_cast<ISetBinaryTree<T>*>(&s);
+        if (other == nullptr) {
+            return filter(*this, s, true, false);
         }
-        return result;
+        return size() <= other->size() ? filter(*this, *other, true, true) : filter(*other, *this, true, true);
     }
 
     // Difference of sets
     ISet<T>* difference(ISet<T> &s) override{
-        auto* result = new ISetBinaryTree<T>();
-        for (T x : tree) {
-            if (!s.find(x)) {
-                result->insert(x);
-            }
+        auto *other = dynamic_cast<ISetBinaryTree<T>*>(&s);
+        if (other == nullptr || size() <= other->size()) {
+            return filter(*this, s, false, other != nullptr);
         }
+        // Most of this set survives: relink a copy with join-based difference
+        auto* result = new ISetBinaryTree<T>(*this);
+        result->tree.differenceWith(AVLBinaryTree<T>(other->tree, result->tree.getPool()));
         return result;
     }
 
@@ -92,6 +105,45 @@ public:
         return this->size() == set.size() && this->subSet(set);
     }
 
+private:
+    static constexpr int PARALLEL_FILTER_GRAIN = 1 << 15;  // Elements per parallel chunk at least
+
+    // Elements of source that are (keep == true) or are not contained in s, bulk-loaded in order.
+    // With parallel == true chunks of source are scanned concurrently (s must be safe for concurrent find).
+    static ISetBinaryTree<T>* filter(const ISetBinaryTree<T> &source, const ISet<T> &s, bool keep, bool parallel) {
+        int count = source.size();
+        int chunks = 1;
+        if (parallel) {
+            chunks = std::max(1, std::min((int) std::thread::hardware_concurrency(), count / PARALLEL_FILTER_GRAIN));
+        }
+        std::vector<std::vector<T>> parts(chunks);
+        auto scan = [&](int chunk) {
+            int from = (int) ((long long) count * chunk / chunks);
+            int to = (int) ((long long) count * (chunk + 1) / chunks);
+            auto it = source.tree.iteratorAt(from);
+            for (int i = from; i < to; ++i, ++it) {
+                if (s.find(*it) == keep) parts[chunk].push_back(*it);
+            }
+        };
+        std::vector<std::future<void>> tasks;
+        for (int chunk = 1; chunk < chunks; ++chunk) {
+            tasks.push_back(std::async(std::launch::async, scan, chunk));
+        }
+        scan(0);
+        for (auto &task : tasks) {
+            task.get();
+        }
+
+        std::vector<T> values = std::move(parts[0]);
+        for (int chunk = 1; chunk < chunks; ++chunk) {
+            values.insert(values.end(), parts[chunk].begin(), parts[chunk].end());
+        }
+        auto* result = new ISetBinaryTree<T>();
+        result->tree.buildSorted((int) values.size(), [&values](int i) -> T& { return values[i]; });
+        return result;
+    }
+
+public:
     struct Iterator {
         using iterator_category = std::forward_iterator_tag;
         using difference_type = std::ptrdiff_t;
@@ -25,14 +25,12 @@ public:
         return tree.getSize() == 0;
     }
 
-    // Get element by index (in-order traversal)
+    // Get element by index, O(log n)
     TElement Get(int index)const override {
         if (index < 0 || index >= tree.getSize()) {
             throw std::out_of_range("Index out of range");
         }
-        auto it = tree.begin();
-        std::advance(it, index);
-        return *it;
+        return tree.select(index);
     }
 
     // Add element with automatic sorting
@@ -57,10 +55,10 @@ public:
     }
 
 
-    // Get the index of an element (or -1 if not found)
+    // Get the index of an element (or -1 if not found); scans only elements equivalent by order
     int IndexOf(const TElement& element) const override {
-        int index = 0;
-        for (auto it = tree.begin(); it != tree.end(); ++it, ++index) {
+        int index = tree.rank(element);
+        for (auto it = tree.iteratorAt(index); it != tree.end() && !(element < *it); ++it, ++index) {
             if (*it == element) {
                 return index;
             }
@@ -68,14 +66,18 @@ public:
         return -1;
     }
 
+    // Number of elements x with low <= x <= high
+    int CountInRange(const TElement& low, const TElement& high) const {
+        return tree.countInRange(low, high);
+    }
+
     // Get a subsequence
     ISortedSequence<TElement>* GetSubsequence(int startIndex, int endIndex) const override {
         if (startIndex < 0 || endIndex >= tree.getSize() || startIndex > endIndex) {
             throw std::out_of_range("Invalid subsequence range");
         }
         auto* subsequence = new ISortedSequenceBinaryTree<TElement>();
-        auto it = tree.begin();
-        std::advance(it, startIndex);
+        auto it = tree.iteratorAt(startIndex);
         for (int i = startIndex; i <= endIndex; ++i, ++it) {
             subsequence->Add(*it);
         }
@@ -0,0 +1,104 @@
+#ifndef LAB4_SEM3_NODEPOOL_H
+#define LAB4_SEM3_NODEPOOL_H
+
+#include <new>
+#include <utility>
+
+#include "../sequence/DynamicArray.h"
+
+/**
+ * Slab allocator for fixed-size tree nodes.
+ *
+ * Nodes are carved out of slabs that grow geometrically (8, 16, ... up to
+ * MAX_SLAB_SIZE slots); freed nodes go to an intrusive free list and are
+ * reused first. All slabs are released at once when the pool is destroyed,
+ * so a tree that owns its pool does not need to free nodes one by one.
+ *
+ * A pool may be shared by several trees (e.g. all adjacency lists of one
+ * graph). It is not thread-safe: trees sharing a pool must not be modified
+ * concurrently.
+ */
+template<class Node>
+class NodePool {
+private:
+    static constexpr int MIN_SLAB_SIZE = 8;
+    static constexpr int MAX_SLAB_SIZE = 4096;
+
+    union Slot {
+        Slot *nextFree;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    DynamicArray<Slot *> slabs;  // All allocated slabs, released in the destructor
+    Slot *freeList = nullptr;    // Previously released slots
+    Slot *cursor = nullptr;      // Next never-used slot of the newest slab
+    Slot *cursorEnd = nullptr;
+    int nextSlabSize = MIN_SLAB_SIZE;
+    int liveCount = 0;
+
+    Slot *takeSlot() {
+        if (freeList) {
+            Slot *slot = freeList;
+            freeList = slot->nextFree;
+            return slot;
+        }
+        if (cursor == cursorEnd) {
+            Slot *slab = new Slot[nextSlabSize];
+            slabs.append(slab);
+            cursor = slab;
+            cursorEnd = slab + nextSlabSize;
+            if (nextSlabSize < MAX_SLAB_SIZE) nextSlabSize *= 2;
+        }
+        return cursor++;
+    }
+
+public:
+    NodePool() = default;
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    ~NodePool() {
+        for (int i = 0; i < slabs.getSize(); ++i) {
+            delete[] slabs[i];
+        }
+    }
+
+    // Constructs a node in a pooled slot
+    template<class... Args>
+    Node *create(Args &&... args) {
+        Slot *slot = takeSlot();
+        Node *node;
+        try {
+            node = new(slot->storage) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            slot->nextFree = freeList;
+            freeList = slot;
+            throw;
+        }
+        ++liveCount;
+        return node;
+    }
+
+    // Destroys a node and returns its slot to the free list
+    void destroy(Node *node) {
+        if (node == nullptr) return;
+        node->~Node();
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->nextFree = freeList;
+        freeList = slot;
+        --liveCount;
+    }
+
+    // Number of nodes currently allocated from the pool
+    int getLiveCount() const {
+        return liveCount;
+    }
+
+    // Number of slabs requested from the system allocator
+    int getSlabCount() const {
+        return slabs.getSize();
+    }
+};
+
+#endif //LAB4_SEM3_NODEPOOL_H
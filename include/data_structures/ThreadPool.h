@@ -0,0 +1,174 @@
+#ifndef LAB4_SEM3_THREADPOOL_H
+#define LAB4_SEM3_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size work-stealing thread pool.
+ *
+ * Every worker owns a task deque: it takes its own tasks from the back
+ * (most recently pushed, still warm in cache) and, when it runs dry, steals
+ * from the front of the other workers' deques. Tasks submitted from a worker
+ * go to that worker's deque, other submissions are spread round-robin.
+ *
+ * A task receives the index of the worker that runs it, in [0, getThreadCount()),
+ * so callers can keep per-thread scratch buffers in a plain array.
+ *
+ * wait() blocks until every submitted task has finished and rethrows the first
+ * exception thrown by a task. The pool is meant to be driven by one caller at
+ * a time: wait() does not distinguish between batches of different callers.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void(unsigned worker)>;
+
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) threads = 1;
+        for (unsigned i = 0; i < threads; ++i) {
+            queues.push_back(std::make_unique<WorkerQueue>());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Finishes the queued tasks and joins the workers
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    unsigned getThreadCount() const {
+        return unsigned(workers.size());
+    }
+
+    // Queues a task; it is called as task(workerIndex)
+    void submit(Task task) {
+        unsigned target = currentPool == this ? currentWorker
+                                              : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        {
+            // Taking stateMutex orders the increment with a worker going to sleep
+            std::lock_guard<std::mutex> lock(stateMutex);
+            queued.fetch_add(1, std::memory_order_relaxed);
+        }
+        wake.notify_one();
+    }
+
+    // Blocks until all submitted tasks have finished; rethrows the first task exception
+    void wait() {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        idle.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+        if (failure) {
+            std::exception_ptr error = failure;
+            failure = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Calls func(index, worker) for every index in [0, count) in chunks of grain indices and waits
+    template<class Func>
+    void parallelFor(int count, int grain, Func func) {
+        if (grain < 1) grain = 1;
+        for (int begin = 0; begin < count; begin += grain) {
+            int end = std::min(count, begin + grain);
+            submit([begin, end, &func](unsigned worker) {
+                for (int i = begin; i < end; ++i) {
+                    func(i, worker);
+                }
+            });
+        }
+        wait();
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex stateMutex;
+    std::condition_variable wake;      // Signalled when a task is queued or the pool stops
+    std::condition_variable idle;      // Signalled when pending drops to zero
+    std::atomic<int> queued{0};        // Tasks sitting in deques
+    std::atomic<int> pending{0};       // Tasks submitted but not finished
+    std::atomic<unsigned> nextQueue{0};
+    std::exception_ptr failure;
+    bool stopping = false;
+
+    static inline thread_local ThreadPool *currentPool = nullptr;
+    static inline thread_local unsigned currentWorker = 0;
+
+    bool popOwn(unsigned worker, Task &task) {
+        WorkerQueue &queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned worker, Task &task) {
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            WorkerQueue &queue = *queues[(worker + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void run(unsigned worker) {
+        currentPool = this;
+        currentWorker = worker;
+        while (true) {
+            Task task;
+            if (popOwn(worker, task) || steal(worker, task)) {
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                try {
+                    task(worker);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    if (!failure) failure = std::current_exception();
+                }
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    idle.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+            if (stopping && queued.load(std::memory_order_relaxed) == 0) return;
+        }
+    }
+};
+
+#endif //LAB4_SEM3_THREADPOOL_H
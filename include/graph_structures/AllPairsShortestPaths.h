@@ -0,0 +1,296 @@
+#ifndef ALL_PAIRS_SHORTEST_PATHS_H
+#define ALL_PAIRS_SHORTEST_PATHS_H
+
+#include "Graph.h"
+#include "../data_structures/ThreadPool.h"
+#include "../sequence/ArraySequence.h"
+#include "../sequence/DynamicArray.h"
+#include "../sequence/IndexedPriorityQueue.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Плотная матрица расстояний: строка i хранит расстояния от i-го источника до всех вершин.
+ *
+ * Недостижимые вершины имеют расстояние, равное максимуму типа.
+ *
+ * @tparam T Тип веса рёбер.
+ */
+template<typename T>
+class DistanceMatrix {
+private:
+    int rows = 0;
+    int columns = 0;
+    DynamicArray<T> data;  // Строки подряд: data[row * columns + column]
+
+public:
+    DistanceMatrix() = default;
+
+    DistanceMatrix(int rows, int columns)
+            : rows(rows), columns(columns), data(std::numeric_limits<T>::max(), checkedSize(rows, columns)) {}
+
+    int getRows() const {
+        return rows;
+    }
+
+    int getColumns() const {
+        return columns;
+    }
+
+    /**
+     * @brief Расстояние от источника с номером строки row до вершины column.
+     *
+     * @throws std::out_of_range Если индекс находится вне матрицы.
+     */
+    T get(int row, int column) const {
+        if (row < 0 || row >= rows || column < 0 || column >= columns) {
+            throw std::out_of_range("Matrix index out of range");
+        }
+        return data[row * columns + column];
+    }
+
+    // Непосредственный доступ к строке для заполнения без проверки индексов
+    T* row(int index) {
+        return columns > 0 ? &data[index * columns] : nullptr;
+    }
+
+    const T* row(int index) const {
+        return columns > 0 ? &data[index * columns] : nullptr;
+    }
+
+private:
+    static int checkedSize(int rows, int columns) {
+        if (rows < 0 || columns < 0) {
+            throw std::invalid_argument("Matrix size must be non-negative");
+        }
+        if (columns > 0 && rows > std::numeric_limits<int>::max() / columns) {
+            throw std::length_error("Distance matrix is too large");
+        }
+        return rows * columns;
+    }
+};
+
+/**
+ * @brief Кратчайшие пути от многих источников и между всеми парами вершин.
+ *
+ * Источники распределяются между потоками `ThreadPool`; каждый поток использует собственную
+ * очередь с приоритетом, а расстояния записываются прямо в строку результирующей матрицы,
+ * поэтому при обработке очередного источника память не выделяется.
+ *
+ * Для плотных графов (например, `GraphGenerator::COMPLETE`) предусмотрен блочный алгоритм
+ * Флойда–Уоршелла: матрица обрабатывается квадратными блоками, помещающимися в кэш,
+ * а независимые блоки каждой фазы — параллельно.
+ *
+ * @tparam T Тип веса рёбер графа.
+ */
+template<typename T>
+class AllPairsShortestPaths {
+    static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+
+    /**
+     * @brief Способ вычисления матрицы расстояний между всеми парами.
+     */
+    enum Method {
+        AUTO,            /**< Флойд–Уоршелл для плотных графов, иначе Дейкстра от каждой вершины. */
+        DIJKSTRA,        /**< Алгоритм Дейкстры от каждой вершины. */
+        FLOYD_WARSHALL   /**< Блочный алгоритм Флойда–Уоршелла. */
+    };
+
+    // Граф считается плотным, если рёбер не меньше V^2 / DENSE_GRAPH_RATIO
+    static constexpr int DENSE_GRAPH_RATIO = 4;
+    // Сторона блока Флойда–Уоршелла: три блока int по 256x256 (768 КБ) помещаются в кэш L2
+    static constexpr int DEFAULT_BLOCK_SIZE = 256;
+
+    /**
+     * @brief Расстояния от каждого из заданных источников до всех вершин.
+     *
+     * @param graph Граф с неотрицательными весами рёбер; должен допускать одновременное чтение.
+     * @param sources Источники; строка i результата соответствует sources[i].
+     * @param pool Пул потоков, на котором выполняются поиски.
+     * @return DistanceMatrix<T> Матрица размера sources.getLength() x V.
+     *
+     * @throws std::out_of_range Если источник находится вне допустимого диапазона.
+     */
+    static DistanceMatrix<T> multiSource(const Graph<T>& graph, const ArraySequence<Vertex>& sources,
+                                         ThreadPool& pool) {
+        int n = graph.getVertexCount();
+        for (int i = 0; i < sources.getLength(); ++i) {
+            if (sources[i] < 0 || sources[i] >= n) {
+                throw std::out_of_range("Source vertex is out of range");
+            }
+        }
+
+        DistanceMatrix<T> result(sources.getLength(), n);
+        std::vector<IndexedPriorityQueue<T>> queues(pool.getThreadCount(), IndexedPriorityQueue<T>(n));
+        pool.parallelFor(sources.getLength(), 1, [&](int index, unsigned worker) {
+            dijkstraRow(graph, sources[index], result.row(index), queues[worker]);
+        });
+        return result;
+    }
+
+    /**
+     * @brief Матрица расстояний между всеми парами вершин.
+     *
+     * @param graph Граф; для метода DIJKSTRA веса должны быть неотрицательны,
+     *              для FLOYD_WARSHALL допускаются отрицательные веса без отрицательных циклов.
+     * @param pool Пул потоков.
+     * @param method Алгоритм; AUTO выбирает его по плотности графа.
+     * @return DistanceMatrix<T> Матрица V x V.
+     */
+    static DistanceMatrix<T> allPairs(const Graph<T>& graph, ThreadPool& pool, Method method = AUTO) {
+        if (method == AUTO) {
+            method = isDense(graph) ? FLOYD_WARSHALL : DIJKSTRA;
+        }
+        if (method == FLOYD_WARSHALL) {
+            return floydWarshall(graph, pool);
+        }
+        ArraySequence<Vertex> sources;
+        for (Vertex v = 0; v < graph.getVertexCount(); ++v) {
+            sources.append(v);
+        }
+        return multiSource(graph, sources, pool);
+    }
+
+    /**
+     * @brief Блочный алгоритм Флойда–Уоршелла.
+     *
+     * Для каждого диагонального блока k выполняются три фазы: сам блок (k, k), затем блоки
+     * строки и столбца k, затем все остальные блоки; блоки внутри второй и третьей фаз
+     * независимы и обрабатываются параллельно.
+     *
+     * @param graph Граф без циклов отрицательного веса; модули расстояний должны быть меньше
+     *              четверти максимума типа.
+     * @param pool Пул потоков.
+     * @param blockSize Сторона блока.
+     * @return DistanceMatrix<T> Матрица V x V.
+     *
+     * @throws std::invalid_argument Если сторона блока не положительна.
+     */
+    static DistanceMatrix<T> floydWarshall(const Graph<T>& graph, ThreadPool& pool,
+                                           int blockSize = DEFAULT_BLOCK_SIZE) {
+        if (blockSize <= 0) {
+            throw std::invalid_argument("Block size must be positive");
+        }
+        int n = graph.getVertexCount();
+        DistanceMatrix<T> matrix(n, n);
+        for (Vertex u = 0; u < n; ++u) {
+            T* row = matrix.row(u);
+            row[u] = T(0);
+            graph.forEachNeighbor(u, [row](Vertex v, const T& weight) {
+                if (weight < row[v]) row[v] = weight;
+            });
+        }
+        if (n == 0) return matrix;
+
+        // На время вычислений «бесконечность» уменьшается вдвое: сумма двух таких значений
+        // не переполняет тип, и внутренний цикл обходится без ветвлений
+        T* d = matrix.row(0);
+        const T INF = std::numeric_limits<T>::max();
+        long long cells = (long long) n * n;
+        for (long long i = 0; i < cells; ++i) {
+            if (d[i] == INF) d[i] = UNREACHABLE;
+        }
+
+        int blocks = (n + blockSize - 1) / blockSize;
+        for (int k = 0; k < blocks; ++k) {
+            relaxBlock(d, n, blockSize, k, k, k);
+            // Строка и столбец k: 2 * (blocks - 1) независимых блоков
+            pool.parallelFor(2 * (blocks - 1), 1, [&](int index, unsigned) {
+                int other = index % (blocks - 1);
+                if (other >= k) ++other;
+                if (index < blocks - 1) {
+                    relaxBlock(d, n, blockSize, k, other, k);
+                } else {
+                    relaxBlock(d, n, blockSize, other, k, k);
+                }
+            });
+            // Остальные блоки; задача — одна строка блоков
+            pool.parallelFor(blocks, 1, [&](int i, unsigned) {
+                if (i == k) return;
+                for (int j = 0; j < blocks; ++j) {
+                    if (j != k) relaxBlock(d, n, blockSize, i, j, k);
+                }
+            });
+        }
+
+        for (long long i = 0; i < cells; ++i) {
+            if (d[i] >= UNREACHABLE / 2) d[i] = INF;
+        }
+        return matrix;
+    }
+
+private:
+    static bool isDense(const Graph<T>& graph) {
+        long long n = graph.getVertexCount();
+        long long edges = 0;
+        for (Vertex v = 0; v < n; ++v) {
+            edges += graph.getDegree(v);
+        }
+        return n > 0 && edges * DENSE_GRAPH_RATIO >= n * n;
+    }
+
+    // Дейкстра от source с записью расстояний в distances (V элементов) и переиспользуемой очередью
+    static void dijkstraRow(const Graph<T>& graph, Vertex source, T* distances, IndexedPriorityQueue<T>& queue) {
+        const T INF = std::numeric_limits<T>::max();
+        queue.clear();
+        distances[source] = T(0);
+        queue.Enqueue(source, T(0));
+        while (!queue.isEmpty()) {
+            Pair<int, T> top = queue.Dequeue();
+            T du = top.second;
+            graph.forEachNeighbor(top.first, [&](Vertex v, const T& weight) {
+                if (du > INF - weight || !(du + weight < distances[v])) return;
+                distances[v] = du + weight;
+                if (queue.contains(v)) {
+                    queue.decreaseKey(v, distances[v]);
+                } else {
+                    queue.Enqueue(v, distances[v]);
+                }
+            });
+        }
+    }
+
+    // Значение недостижимости внутри Флойда–Уоршелла
+    static constexpr T UNREACHABLE = std::numeric_limits<T>::max() / 2;
+
+    // rowI[j] = min(rowI[j], dik + rowK[j]); строки различны, а порции фиксированной длины
+    // позволяют компилятору векторизовать цикл и без -O3
+    static void relaxRow(T* __restrict rowI, const T* __restrict rowK, T dik, int begin, int end) {
+        constexpr int CHUNK = 16;
+        int j = begin;
+        for (; j + CHUNK <= end; j += CHUNK) {
+            for (int t = 0; t < CHUNK; ++t) {
+                rowI[j + t] = std::min(rowI[j + t], T(dik + rowK[j + t]));
+            }
+        }
+        for (; j < end; ++j) {
+            rowI[j] = std::min(rowI[j], T(dik + rowK[j]));
+        }
+    }
+
+    // Релаксирует блок (bi, bj) через вершины блока bk: d[i][j] = min(d[i][j], d[i][k] + d[k][j])
+    static void relaxBlock(T* d, int n, int blockSize, int bi, int bj, int bk) {
+        int iEnd = std::min(n, (bi + 1) * blockSize);
+        int jBegin = bj * blockSize;
+        int jEnd = std::min(n, jBegin + blockSize);
+        int kEnd = std::min(n, (bk + 1) * blockSize);
+        for (int k = bk * blockSize; k < kEnd; ++k) {
+            const T* rowK = d + (long long) k * n;
+            for (int i = bi * blockSize; i < iEnd; ++i) {
+                T* rowI = d + (long long) i * n;
+                T dik = rowI[k];
+                // Строка k не меняется через саму себя: d[k][k] >= 0 без отрицательных циклов
+                if (i == k || dik >= UNREACHABLE / 2) continue;
+                relaxRow(rowI, rowK, dik, jBegin, jEnd);
+            }
+        }
+    }
+};
+
+#endif //ALL_PAIRS_SHORTEST_PATHS_H
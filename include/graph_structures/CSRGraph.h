@@ -0,0 +1,390 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <stack>
+#include <tuple>
+#include "Graph.h"
+#include "DirectedGraph.h"
+#include "UndirectedGraph.h"
+#include "../sequence/DynamicArray.h"
+
+/**
+ * @brief Класс для представления неизменяемого графа в формате CSR (compressed sparse row).
+ *
+ * Рёбра хранятся в трёх непрерывных массивах: смещения строк (`offsets`), конечные вершины
+ * (`targets`) и веса (`weights`). Исходящие рёбра вершины `v` занимают диапазон
+ * `[offsets[v], offsets[v + 1])` и отсортированы по номеру конечной вершины.
+ * Граф "замораживается" из существующего `DirectedGraph` или `UndirectedGraph`
+ * и после этого не может быть изменён.
+ *
+ * @tparam T Тип данных, ассоциированный с рёбрами графа (например, вес рёбер).
+ */
+template<class T>
+class CSRGraph : public Graph<T> {
+private:
+    int vertexCount; ///< Количество вершин в графе.
+    bool directed; ///< Флаг ориентированности исходного графа.
+    DynamicArray<int> offsets; ///< Смещения начала списка рёбер каждой вершины (размер vertexCount + 1).
+    DynamicArray<int> targets; ///< Конечные вершины рёбер.
+    DynamicArray<T> weights; ///< Веса рёбер.
+
+    /**
+     * @brief Пустой граф с заданным числом вершин (используется при транспонировании).
+     */
+    CSRGraph(int vertices, bool isDirected, int edges)
+            : vertexCount(vertices), directed(isDirected), offsets(vertices + 1), targets(edges), weights(edges) {}
+
+    /**
+     * @brief Сортирует рёбра одной строки по номеру конечной вершины (сортировка вставками).
+     *
+     * Списки соседей деревьев уже упорядочены, поэтому для них проход линейный.
+     */
+    void sortRow(int vertex) {
+        for (int i = offsets[vertex] + 1; i < offsets[vertex + 1]; ++i) {
+            int target = targets[i];
+            T weight = weights[i];
+            int j = i - 1;
+            while (j >= offsets[vertex] && targets[j] > target) {
+                targets[j + 1] = targets[j];
+                weights[j + 1] = weights[j];
+                --j;
+            }
+            targets[j + 1] = target;
+            weights[j + 1] = weight;
+        }
+    }
+
+    /**
+     * @brief Ищет позицию ребра from -> to двоичным поиском внутри строки.
+     *
+     * @return int Индекс ребра или -1, если ребра нет.
+     */
+    int findEdge(int from, int to) const {
+        if (from < 0 || from >= vertexCount) {
+            return -1;
+        }
+        int low = offsets.get(from);
+        int high = offsets.get(from + 1) - 1;
+        while (low <= high) {
+            int mid = low + (high - low) / 2;
+            int target = targets.get(mid);
+            if (target == to) return mid;
+            if (target < to)
+                low = mid + 1;
+            else
+                high = mid - 1;
+        }
+        return -1;
+    }
+
+public:
+    /**
+     * @brief Замораживает произвольный граф в формат CSR.
+     *
+     * @param graph Исходный граф.
+     * @param isDirected Считать ли граф ориентированным (влияет на `getEdges`).
+     */
+    CSRGraph(const Graph<T> &graph, bool isDirected)
+            : vertexCount(graph.getVertexCount()), directed(isDirected), offsets(graph.getVertexCount() + 1) {
+        offsets[0] = 0;
+        for (int v = 0; v < vertexCount; ++v) {
+            offsets[v + 1] = offsets[v] + graph.getDegree(v);
+        }
+
+        int edgeCount = offsets[vertexCount];
+        targets = DynamicArray<int>(edgeCount);
+        weights = DynamicArray<T>(edgeCount);
+
+        for (int v = 0; v < vertexCount; ++v) {
+            int position = offsets[v];
+            graph.forEachNeighbor(v, [this, &position](int neighbor, const T &weight) {
+                targets[position] = neighbor;
+                weights[position] = weight;
+                ++position;
+            });
+            sortRow(v);
+        }
+    }
+
+    /**
+     * @brief Замораживает ориентированный граф.
+     *
+     * @param graph Ориентированный граф.
+     */
+    explicit CSRGraph(const DirectedGraph<T> &graph) : CSRGraph(graph, true) {}
+
+    /**
+     * @brief Замораживает неориентированный граф.
+     *
+     * Каждое ребро хранится в обоих направлениях, как и в `UndirectedGraph`.
+     *
+     * @param graph Неориентированный граф.
+     */
+    explicit CSRGraph(const UndirectedGraph<T> &graph) : CSRGraph(graph, false) {}
+
+    /**
+     * @brief Граф неизменяем: добавление рёбер не поддерживается.
+     *
+     * @throws std::invalid_argument Всегда.
+     */
+    void addEdge(int from, int to, T weight) override {
+        throw std::invalid_argument("Operation not supported");
+    }
+
+    /**
+     * @brief Граф неизменяем: удаление рёбер не поддерживается.
+     *
+     * @throws std::invalid_argument Всегда.
+     */
+    void removeEdge(int from, int to) override {
+        throw std::invalid_argument("Operation not supported");
+    }
+
+    /**
+     * @brief Проверяет наличие ребра из одной вершины в другую.
+     *
+     * @param from Начальная вершина.
+     * @param to Конечная вершина.
+     * @return true Если ребро существует.
+     * @return false Если ребра нет.
+     */
+    bool hasEdge(int from, int to) const override {
+        return findEdge(from, to) != -1;
+    }
+
+    /**
+     * @brief Возвращает (исходящую) степень вершины.
+     *
+     * @param vertex Вершина.
+     * @return int Степень вершины.
+     * @throws std::out_of_range Если вершина не существует в графе.
+     */
+    int getDegree(int vertex) const override {
+        if (vertex < 0 || vertex >= vertexCount) {
+            throw std::out_of_range("Vertex not found");
+        }
+        return offsets.get(vertex + 1) - offsets.get(vertex);
+    }
+
+    /**
+     * @brief Возвращает список соседних вершин для заданной вершины.
+     *
+     * @param vertex Вершина, для которой необходимо получить список соседей.
+     * @return ArraySequence<Pair<int, T>> Список пар (сосед, вес), упорядоченный по номеру соседа.
+     */
+    ArraySequence<Pair<int, T>> getNeighbors(int vertex) const override {
+        ArraySequence<Pair<int, T>> neighbors;
+        if (vertex >= 0 && vertex < vertexCount) {
+            for (int i = offsets.get(vertex); i < offsets.get(vertex + 1); ++i) {
+                neighbors.append(Pair<int, T>(targets.get(i), weights.get(i)));
+            }
+        }
+        return neighbors;
+    }
+
+    /**
+     * @brief Обходит исходящие рёбра вершины непосредственно по массивам CSR.
+     *
+     * @param vertex Вершина, соседей которой необходимо обойти.
+     * @param visitor Посетитель, вызываемый для каждой пары (сосед, вес).
+     */
+    void visitNeighbors(int vertex, typename Graph<T>::NeighborVisitor &visitor) const override {
+        if (vertex < 0 || vertex >= vertexCount) {
+            return;
+        }
+        for (int i = offsets.get(vertex); i < offsets.get(vertex + 1); ++i) {
+            visitor.apply(targets.get(i), weights.get(i));
+        }
+    }
+
+    /**
+     * @brief Возвращает вес ребра между двумя вершинами.
+     *
+     * @param from Начальная вершина.
+     * @param to Конечная вершина.
+     * @return T Вес ребра.
+     * @throws std::invalid_argument Если ребро не найдено.
+     */
+    T getEdgeWeight(int from, int to) const override {
+        int position = findEdge(from, to);
+        if (position == -1) {
+            throw std::invalid_argument("Edge not found");
+        }
+        return weights.get(position);
+    }
+
+    /**
+     * @brief Выводит все рёбра графа в стандартный поток вывода.
+     */
+    void printGraph() const override {
+        for (int from = 0; from < vertexCount; ++from) {
+            for (int i = offsets.get(from); i < offsets.get(from + 1); ++i) {
+                std::cout << "Edge (" << from << " -> " << targets.get(i) << ") with weight: "
+                          << weights.get(i) << std::endl;
+            }
+        }
+    }
+
+    /**
+     * @brief Возвращает количество вершин в графе.
+     *
+     * @return int Количество вершин.
+     */
+    int getVertexCount() const override {
+        return vertexCount;
+    }
+
+    /**
+     * @brief Возвращает количество хранимых (ориентированных) рёбер.
+     *
+     * Для неориентированного графа каждое ребро учитывается дважды.
+     *
+     * @return int Количество рёбер.
+     */
+    int getEdgeCount() const {
+        return offsets.get(vertexCount);
+    }
+
+    /**
+     * @brief Проверяет, был ли заморожен ориентированный граф.
+     */
+    bool isDirected() const {
+        return directed;
+    }
+
+    /**
+     * @brief Индекс первого исходящего ребра вершины в массивах `targets`/`weights`.
+     */
+    int rowBegin(int vertex) const {
+        return offsets.get(vertex);
+    }
+
+    /**
+     * @brief Индекс за последним исходящим ребром вершины.
+     */
+    int rowEnd(int vertex) const {
+        return offsets.get(vertex + 1);
+    }
+
+    /**
+     * @brief Конечная вершина ребра с индексом `edge`.
+     */
+    int getTarget(int edge) const {
+        return targets.get(edge);
+    }
+
+    /**
+     * @brief Вес ребра с индексом `edge`.
+     */
+    const T &getWeight(int edge) const {
+        return weights.get(edge);
+    }
+
+    /**
+     * @brief Выполняет глубинный поиск (DFS) начиная с заданной вершины.
+     *
+     * Обход итеративный (явный стек), поэтому длинные цепочки не переполняют стек вызовов.
+     * Порядок посещения совпадает с рекурсивным DFS `DirectedGraph`.
+     *
+     * @param startVertex Вершина, с которой начинается поиск.
+     * @param visited Список посещённых вершин.
+     * @param visit Функция, вызываемая при посещении вершины (может быть nullptr).
+     * @throws std::out_of_range Если начальная вершина не существует в графе.
+     */
+    void dfs(int startVertex, ArraySequence<bool> &visited, std::function<void(int)> visit = nullptr) const override {
+        if (startVertex < 0 || startVertex >= vertexCount) {
+            throw std::out_of_range("Invalid start vertex");
+        }
+        if (visited.getLength() != vertexCount) {
+            visited = ArraySequence<bool>(false, vertexCount);
+        }
+
+        std::stack<std::pair<int, int>> stack; // (вершина, следующее ребро)
+        visited[startVertex] = true;
+        if (visit) {
+            visit(startVertex);
+        }
+        stack.emplace(startVertex, offsets.get(startVertex));
+
+        while (!stack.empty()) {
+            auto &top = stack.top();
+            int vertex = top.first;
+            if (top.second == offsets.get(vertex + 1)) {
+                stack.pop();
+                continue;
+            }
+            int neighbor = targets.get(top.second++);
+            if (!visited[neighbor]) {
+                visited[neighbor] = true;
+                if (visit) {
+                    visit(neighbor);
+                }
+                stack.emplace(neighbor, offsets.get(neighbor));
+            }
+        }
+    }
+
+    /**
+     * @brief Возвращает все рёбра графа.
+     *
+     * Для неориентированного графа каждое ребро возвращается один раз (from < to),
+     * как в `UndirectedGraph::getEdges`.
+     *
+     * @return ArraySequence<std::tuple<int, int, T>> Список рёбер (from, to, weight).
+     */
+    ArraySequence<std::tuple<int, int, T>> getEdges() const override {
+        ArraySequence<std::tuple<int, int, T>> edges;
+        for (int from = 0; from < vertexCount; ++from) {
+            for (int i = offsets.get(from); i < offsets.get(from + 1); ++i) {
+                int to = targets.get(i);
+                if (directed || from < to) {
+                    edges.append(std::make_tuple(from, to, weights.get(i)));
+                }
+            }
+        }
+        return edges;
+    }
+
+    /**
+     * @brief Возвращает транспонированный граф (с инвертированными направлениями рёбер).
+     *
+     * Строится подсчётом входящих степеней за O(V + E); строки результата
+     * упорядочены по номеру вершины, так как исходные вершины перебираются по возрастанию.
+     *
+     * @return CSRGraph<T> Транспонированный граф.
+     */
+    CSRGraph<T> getTranspose() const {
+        int edgeCount = getEdgeCount();
+        CSRGraph<T> transposed(vertexCount, directed, edgeCount);
+
+        for (int v = 0; v <= vertexCount; ++v) {
+            transposed.offsets[v] = 0;
+        }
+        for (int i = 0; i < edgeCount; ++i) {
+            transposed.offsets[targets.get(i) + 1]++;
+        }
+        for (int v = 0; v < vertexCount; ++v) {
+            transposed.offsets[v + 1] += transposed.offsets[v];
+        }
+
+        DynamicArray<int> position(vertexCount);
+        for (int v = 0; v < vertexCount; ++v) {
+            position[v] = transposed.offsets[v];
+        }
+        for (int from = 0; from < vertexCount; ++from) {
+            for (int i = offsets.get(from); i < offsets.get(from + 1); ++i) {
+                int slot = position[targets.get(i)]++;
+                transposed.targets[slot] = from;
+                transposed.weights[slot] = weights.get(i);
+            }
+        }
+        return transposed;
+    }
+
+    /**
+     * @brief Деструктор по умолчанию.
+     */
+    ~CSRGraph() override = default;
+};
+
+#endif // CSRGRAPH_H
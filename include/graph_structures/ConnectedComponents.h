@@ -2,76 +2,284 @@
 #define CONNECTED_COMPONENTS_H
 
 #include "UndirectedGraph.h"
+#include "CSRGraph.h"
+#include "../data_structures/DisjointSet.h"
+#include "../data_structures/ThreadPool.h"
 #include "../sequence/ArraySequence.h"
-#include <functional>
+#include "../sequence/DynamicArray.h"
+#include <algorithm>
+#include <atomic>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 
 /**
  * @brief Класс для поиска компонент связности в неориентированном графе.
  *
- * Класс `ConnectedComponents` предоставляет метод для поиска всех компонент связности
- * в заданном неориентированном графе. Он использует алгоритм обхода в глубину (DFS)
- * для идентификации связанных групп вершин.
+ * Класс `ConnectedComponents` предоставляет методы для поиска всех компонент связности
+ * в заданном неориентированном графе. Рёбра объединяются системой непересекающихся множеств
+ * (`DisjointSet`), поэтому рекурсия и списки соседей не нужны; параллельный вариант
+ * выполняет те же объединения без блокировок.
  */
 class ConnectedComponents {
 public:
 
+    /**
+     * @brief Разметка вершин номерами компонент связности.
+     *
+     * Компоненты пронумерованы по возрастанию наименьшей вершины.
+     */
+    struct ComponentIds {
+        int componentCount = 0;        /**< Число компонент. */
+        DynamicArray<int> componentOf; /**< Номер компоненты каждой вершины, от 0 до componentCount - 1. */
+    };
+
     ConnectedComponents() = default;
 
     /**
      * @brief Находит все компоненты связности в графе.
      *
-     * Метод `findComponents` выполняет поиск всех компонент связности в заданном
-     * неориентированном графе, используя алгоритм обхода в глубину (DFS).
      * Каждая компонента представлена как отдельная последовательность вершин.
      *
      * @tparam T Тип веса рёбер графа.
-     * @param graph Неориентированный граф, в котором выполняется поиск компонент связности.
-     * @return ArraySequence<ArraySequence<int>> Список компонент связности, каждая из которых представлена
-     *                                      последовательностью вершин.
+     * @param graph Неориентированный граф (`UndirectedGraph` или замороженный `CSRGraph`),
+     *              в котором выполняется поиск компонент связности.
+     * @return ArraySequence<ArraySequence<int>> Список компонент связности в порядке наименьших вершин;
+     *                                      вершины каждой компоненты упорядочены по возрастанию.
+     */
+    template<typename T>
+    static ArraySequence<ArraySequence<int>> findComponents(const Graph<T>& graph) {
+        return groupComponents(findComponentIds(graph));
+    }
+
+    /**
+     * @brief Находит номер компоненты связности каждой вершины.
+     *
+     * Для ориентированного графа находятся компоненты слабой связности.
+     *
+     * @tparam T Тип веса рёбер графа.
+     * @param graph Граф.
+     * @return ComponentIds Плоская разметка вершин.
+     */
+    template<typename T>
+    static ComponentIds findComponentIds(const Graph<T>& graph) {
+        int vertexCount = graph.getVertexCount();
+        DisjointSet sets(vertexCount);
+        for (int u = 0; u < vertexCount; ++u) {
+            graph.forEachNeighbor(u, [&](int v, const T&) {
+                sets.unite(u, v);
+            });
+        }
+        return labelByRoot(vertexCount, [&sets](int v) { return sets.find(v); });
+    }
+
+    /**
+     * @brief Параллельный поиск компонент связности без блокировок.
+     *
+     * Вариант алгоритма Шилоаха–Вишкина с асинхронным «подвешиванием»: рёбра делятся между
+     * потоками, каждое ребро подвешивает больший из двух корней к меньшему операцией
+     * compare-and-swap, а поиск корня укорачивает путь вдвое. Родитель вершины никогда
+     * не превосходит её саму, поэтому конкурентные укорачивания безопасны, и корнем компоненты
+     * оказывается её наименьшая вершина.
+     *
+     * @tparam T Тип веса рёбер графа.
+     * @param graph Граф в формате CSR; для неориентированного графа каждое ребро просматривается один раз.
+     * @param pool Пул потоков; метод нельзя вызывать из задачи этого же пула.
+     * @return ComponentIds Разметка, совпадающая с `findComponentIds`.
+     */
+    template<typename T>
+    static ComponentIds findComponentIdsParallel(const CSRGraph<T>& graph, ThreadPool& pool) {
+        const int n = graph.getVertexCount();
+        std::unique_ptr<std::atomic<int>[]> parent(new std::atomic<int>[n]);
+        int chunks = (n + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+        pool.parallelFor(chunks, 1, [&](int chunk, unsigned) {
+            int end = std::min(n, (chunk + 1) * PARALLEL_GRAIN);
+            for (int v = chunk * PARALLEL_GRAIN; v < end; ++v) {
+                parent[v].store(v, std::memory_order_relaxed);
+            }
+        });
+
+        bool bothDirections = !graph.isDirected();
+        pool.parallelFor(chunks, 1, [&](int chunk, unsigned) {
+            int end = std::min(n, (chunk + 1) * PARALLEL_GRAIN);
+            for (int u = chunk * PARALLEL_GRAIN; u < end; ++u) {
+                for (int e = graph.rowBegin(u); e < graph.rowEnd(u); ++e) {
+                    int v = graph.getTarget(e);
+                    if (bothDirections && v <= u) continue;
+                    hook(parent.get(), u, v);
+                }
+            }
+        });
+
+        // После всех объединений корни неизменны, и findRoot лишь сжимает пути
+        DynamicArray<int> roots(n);
+        pool.parallelFor(chunks, 1, [&](int chunk, unsigned) {
+            int end = std::min(n, (chunk + 1) * PARALLEL_GRAIN);
+            for (int v = chunk * PARALLEL_GRAIN; v < end; ++v) {
+                roots[v] = findRoot(parent.get(), v);
+            }
+        });
+        return labelByRoot(n, [&roots](int v) { return roots[v]; });
+    }
+
+    /**
+     * @brief Параллельный поиск компонент в произвольном графе (граф копируется в формат CSR).
      *
-     * @throws std::invalid_argument Если граф содержит недопустимые вершины.
+     * Как и перегрузку для CSR, метод нельзя вызывать из задачи пула pool.
      */
     template<typename T>
-    static ArraySequence<ArraySequence<int>> findComponents(const UndirectedGraph<T>& graph) {
-        int vertexCount = graph.getVertexCount(); /**< Общее количество вершин в графе. */
-        ArraySequence<bool> visited;               /**< Массив для отслеживания посещённых вершин. */
+    static ComponentIds findComponentIdsParallel(const Graph<T>& graph, ThreadPool& pool) {
+        return findComponentIdsParallel(CSRGraph<T>(graph, true), pool);
+    }
 
-        // Инициализация массива посещённых вершин как false
-        for (int i = 0; i < vertexCount; ++i) {
-            visited.append(false);
+    /**
+     * @brief Собирает списки вершин компонент по плоской разметке.
+     *
+     * @param ids Разметка вершин.
+     * @return ArraySequence<ArraySequence<int>> Компонента i — элемент i; вершины по возрастанию.
+     */
+    static ArraySequence<ArraySequence<int>> groupComponents(const ComponentIds& ids) {
+        ArraySequence<ArraySequence<int>> components;
+        for (int i = 0; i < ids.componentCount; ++i) {
+            components.append(ArraySequence<int>());
         }
+        for (int v = 0; v < ids.componentOf.getSize(); ++v) {
+            components[ids.componentOf[v]].append(v);
+        }
+        return components;
+    }
 
-        ArraySequence<ArraySequence<int>> components; /**< Список найденных компонент связности. */
+    ~ConnectedComponents() = default;
+
+private:
+    friend class EdgeStreamComponents;
+
+    // Вершин в одной задаче параллельного прохода
+    static constexpr int PARALLEL_GRAIN = 4096;
 
-        // Итерация по всем вершинам графа
+    // Нумерует компоненты по возрастанию наименьшей вершины; rootOf(v) — представитель компоненты v
+    template<class RootOf>
+    static ComponentIds labelByRoot(int vertexCount, RootOf rootOf) {
+        ComponentIds result;
+        result.componentOf = DynamicArray<int>(vertexCount);
+        DynamicArray<int> idOf(-1, vertexCount);
         for (int v = 0; v < vertexCount; ++v) {
-            // Если вершина ещё не посещена, запускаем DFS для её компоненты связности
-            if (!visited[v]) {
-                ArraySequence<int> component; /**< Текущая компонента связности. */
-
-                /**
-                 * @brief Lambda-функция для добавления вершины в текущую компоненту.
-                 *
-                 * Эта функция вызывается для каждой посещённой вершины во время DFS.
-                 *
-                 * @param vertex Индекс текущей вершины.
-                 */
-                std::function<void(int)> visit = [&component](int vertex) {
-                    component.append(vertex); /**< Добавляем вершину в компоненту. */
-                };
-
-                // Выполнение DFS начиная с вершины v
-                graph.dfs(v, visited, visit);
-
-                // Добавление найденной компоненты в список компонент
-                components.append(component);
+            int root = rootOf(v);
+            if (idOf[root] == -1) idOf[root] = result.componentCount++;
+            result.componentOf[v] = idOf[root];
+        }
+        return result;
+    }
+
+    static int findRoot(std::atomic<int>* parent, int v) {
+        while (true) {
+            int p = parent[v].load(std::memory_order_relaxed);
+            if (p == v) return v;
+            int grandparent = parent[p].load(std::memory_order_relaxed);
+            if (grandparent != p) {
+                // Неудача означает, что другой поток уже сдвинул v ещё ближе к корню
+                parent[v].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
             }
+            v = grandparent;
         }
+    }
 
-        return components; /**< Возвращаем список всех компонент связности. */
+    static void hook(std::atomic<int>* parent, int u, int v) {
+        while (true) {
+            u = findRoot(parent, u);
+            v = findRoot(parent, v);
+            if (u == v) return;
+            if (u > v) std::swap(u, v);
+            // Больший корень подвешивается к меньшему, если его ещё никто не подвесил
+            int expected = v;
+            if (parent[v].compare_exchange_strong(expected, u, std::memory_order_relaxed)) return;
+        }
     }
+};
 
-    ~ConnectedComponents() = default;
+/**
+ * @brief Компоненты связности потока рёбер без построения графа.
+ *
+ * Рёбра передаются по одному (или читаются из потока ввода) и сразу объединяются
+ * в `DisjointSet`; память — два числа на вершину независимо от числа рёбер.
+ * Число вершин растёт по мере появления новых номеров.
+ */
+class EdgeStreamComponents {
+private:
+    DisjointSet sets;
+    long long edgeCount = 0;
+
+public:
+    /**
+     * @brief Создаёт поток с заданным начальным числом вершин.
+     */
+    explicit EdgeStreamComponents(int vertexCount = 0) : sets(vertexCount) {}
+
+    /**
+     * @brief Учитывает ребро u - v.
+     *
+     * @throws std::out_of_range Если номер вершины отрицателен.
+     */
+    void addEdge(int u, int v) {
+        if (u < 0 || v < 0) {
+            throw std::out_of_range("Vertex is out of range");
+        }
+        sets.ensureSize(std::max(u, v) + 1);
+        sets.unite(u, v);
+        ++edgeCount;
+    }
+
+    /**
+     * @brief Читает пары «u v», разделённые пробельными символами, до конца потока.
+     *
+     * @return long long Число прочитанных рёбер.
+     *
+     * @throws std::invalid_argument Если поток содержит что-то кроме пар целых чисел.
+     */
+    long long readEdges(std::istream& input) {
+        long long read = 0;
+        int u, v;
+        while (input >> u) {
+            if (!(input >> v)) {
+                throw std::invalid_argument("Edge list must consist of vertex pairs");
+            }
+            addEdge(u, v);
+            ++read;
+        }
+        if (!input.eof()) {
+            throw std::invalid_argument("Edge list must consist of vertex pairs");
+        }
+        return read;
+    }
+
+    /**
+     * @brief Проверяет, лежат ли вершины в одной компоненте.
+     *
+     * @throws std::out_of_range Если вершина ещё не встречалась.
+     */
+    bool connected(int u, int v) {
+        return sets.connected(u, v);
+    }
+
+    int getVertexCount() const {
+        return sets.getSize();
+    }
+
+    long long getEdgeCount() const {
+        return edgeCount;
+    }
+
+    int getComponentCount() const {
+        return sets.getSetCount();
+    }
+
+    /**
+     * @brief Разметка вершин в формате `ConnectedComponents::findComponentIds`.
+     */
+    ConnectedComponents::ComponentIds getComponentIds() {
+        return ConnectedComponents::labelByRoot(sets.getSize(), [this](int v) { return sets.find(v); });
+    }
 };
 
-#endif // CONNECTED_COMPONENTS_H
\ No newline at end of file
+#endif // CONNECTED_COMPONENTS_H
@@ -0,0 +1,617 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include "Graph.h"
+#include "ShortestPath.h"
+#include "../sequence/ArraySequence.h"
+#include "../sequence/DynamicArray.h"
+#include "../sequence/IndexedPriorityQueue.h"
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Иерархия сжатий (contraction hierarchies) для многократных запросов кратчайшего пути.
+ *
+ * Предобработка по очереди «сжимает» вершины в порядке важности: вершина удаляется из графа,
+ * а для каждой пары соседей u -> v -> w, кратчайший путь между которыми проходил через v,
+ * добавляется ребро-сокращение u -> w (shortcut). Порядок выбирается жадно по разности
+ * числа добавленных и удалённых рёбер с учётом числа уже сжатых соседей.
+ *
+ * Запрос — двунаправленный алгоритм Дейкстры, который идёт только по рёбрам к вершинам
+ * с большим рангом, поэтому просматривает лишь небольшую часть графа. Сокращения хранят
+ * среднюю вершину и раскрываются в путь исходного графа в том же формате, что и `ShortestPath::getPath`.
+ *
+ * Индекс неизменяем и может быть сохранён в поток (`save`) и загружен обратно (`load`).
+ * Методы запросов используют внутренние буферы, поэтому один объект нельзя опрашивать
+ * из нескольких потоков одновременно.
+ *
+ * @tparam T Тип веса рёбер (арифметический, веса неотрицательны).
+ */
+template<typename T>
+class ContractionHierarchy {
+    static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+
+    /**
+     * @brief Строит иерархию сжатий для графа.
+     *
+     * @param graph Граф с неотрицательными весами рёбер (ориентированный или неориентированный).
+     *
+     * @throws std::invalid_argument Если в графе есть ребро отрицательного веса.
+     */
+    explicit ContractionHierarchy(const Graph<T>& graph) : vertexCount(graph.getVertexCount()) {
+        build(graph);
+        resetScratch();
+    }
+
+    /**
+     * @brief Длина кратчайшего пути между вершинами.
+     *
+     * @return T Длина пути или максимум типа, если путь не существует.
+     * @throws std::out_of_range Если вершины находятся вне допустимого диапазона.
+     */
+    T distance(Vertex source, Vertex target) const {
+        return search(source, target).first;
+    }
+
+    /**
+     * @brief Кратчайший путь между вершинами в исходном графе.
+     *
+     * @return ArraySequence<Vertex> Вершины пути от источника до цели (как у `ShortestPath::getPath`).
+     * @throws std::out_of_range Если вершины находятся вне допустимого диапазона.
+     * @throws std::runtime_error Если путь не существует.
+     */
+    ArraySequence<Vertex> getPath(Vertex source, Vertex target) const {
+        typename ShortestPath<T>::PathResult result = query(source, target);
+        if (!result.found) {
+            throw std::runtime_error("No path exists to target vertex");
+        }
+        return result.path;
+    }
+
+    /**
+     * @brief Длина и вершины кратчайшего пути, а также число извлечённых из очередей вершин.
+     *
+     * @throws std::out_of_range Если вершины находятся вне допустимого диапазона.
+     */
+    typename ShortestPath<T>::PathResult query(Vertex source, Vertex target) const {
+        typename ShortestPath<T>::PathResult result;
+        Pair<T, Vertex> found = search(source, target);
+        result.settled = lastSettled;
+        if (found.second == -1) return result;
+
+        result.found = true;
+        result.distance = found.first;
+
+        // Цепочка вершин иерархии: source -> ... -> meeting -> ... -> target
+        ArraySequence<Vertex> upward;
+        for (Vertex v = found.second; v != -1; v = forward.predecessors[v]) {
+            upward.prepend(v);
+        }
+        for (Vertex v = backward.predecessors[found.second]; v != -1; v = backward.predecessors[v]) {
+            upward.append(v);
+        }
+
+        result.path.append(source);
+        for (int i = 1; i < upward.getLength(); ++i) {
+            unpackEdge(upward[i - 1], upward[i], result.path);
+        }
+        return result;
+    }
+
+    int getVertexCount() const {
+        return vertexCount;
+    }
+
+    /**
+     * @brief Число добавленных рёбер-сокращений.
+     */
+    int getShortcutCount() const {
+        return shortcutCount;
+    }
+
+    /**
+     * @brief Позиция вершины в порядке сжатия (0 — сжата первой).
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    int getRank(Vertex vertex) const {
+        checkVertex(vertex);
+        return rank[vertex];
+    }
+
+    /**
+     * @brief Сохраняет индекс в двоичный поток.
+     *
+     * @throws std::runtime_error Если запись не удалась.
+     */
+    void save(std::ostream& out) const {
+        out.write(MAGIC, sizeof(MAGIC));
+        writeValue(out, std::uint32_t(sizeof(T)));
+        writeValue(out, std::int32_t(vertexCount));
+        writeValue(out, std::int32_t(shortcutCount));
+        writeArray(out, rank);
+        for (const Level* level : {&up, &down}) {
+            writeArray(out, level->offsets);
+            writeArray(out, level->targets);
+            writeArray(out, level->weights);
+            writeArray(out, level->middles);
+        }
+        if (!out) {
+            throw std::runtime_error("Failed to write contraction hierarchy");
+        }
+    }
+
+    /**
+     * @brief Загружает индекс, сохранённый методом `save`.
+     *
+     * @throws std::runtime_error Если данные повреждены или сохранены для другого типа веса.
+     */
+    static ContractionHierarchy load(std::istream& in) {
+        char magic[sizeof(MAGIC)];
+        in.read(magic, sizeof(magic));
+        if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("Not a contraction hierarchy");
+        }
+        if (readValue<std::uint32_t>(in) != sizeof(T)) {
+            throw std::runtime_error("Contraction hierarchy was saved for another weight type");
+        }
+
+        ContractionHierarchy hierarchy;
+        hierarchy.vertexCount = readValue<std::int32_t>(in);
+        hierarchy.shortcutCount = readValue<std::int32_t>(in);
+        if (hierarchy.vertexCount < 0 || hierarchy.shortcutCount < 0) {
+            throw std::runtime_error("Corrupted contraction hierarchy");
+        }
+        hierarchy.rank = readArray<int>(in);
+        for (Level* level : {&hierarchy.up, &hierarchy.down}) {
+            level->offsets = readArray<int>(in);
+            level->targets = readArray<int>(in);
+            level->weights = readArray<T>(in);
+            level->middles = readArray<int>(in);
+        }
+        hierarchy.validate();
+        hierarchy.resetScratch();
+        return hierarchy;
+    }
+
+private:
+    static constexpr char MAGIC[4] = {'C', 'H', 'G', '1'};
+    // Сколько вершин может извлечь поиск свидетеля, прежде чем сокращение добавляется без проверки
+    static constexpr int WITNESS_SETTLE_LIMIT = 500;
+
+    // Рёбра, ведущие вверх по иерархии, в формате CSR; middle == -1 у рёбер исходного графа
+    struct Level {
+        DynamicArray<int> offsets;
+        DynamicArray<int> targets;
+        DynamicArray<T> weights;
+        DynamicArray<int> middles;
+    };
+
+    // Состояние одного направления поиска; сбрасываются только затронутые вершины
+    struct SearchSide {
+        std::vector<T> distances;
+        std::vector<Vertex> predecessors;
+        std::vector<Vertex> touched;
+        IndexedPriorityQueue<T> queue;
+
+        void reset(int n) {
+            distances.assign(n, std::numeric_limits<T>::max());
+            predecessors.assign(n, -1);
+            touched.clear();
+            queue = IndexedPriorityQueue<T>(n);
+        }
+
+        void clear() {
+            for (Vertex v : touched) {
+                distances[v] = std::numeric_limits<T>::max();
+                predecessors[v] = -1;
+            }
+            touched.clear();
+            queue.clear();
+        }
+    };
+
+    // Ребро рабочего графа при построении
+    struct WorkEdge {
+        Vertex to;
+        T weight;
+        Vertex middle;
+    };
+
+    int vertexCount = 0;
+    int shortcutCount = 0;
+    DynamicArray<int> rank;
+    Level up;    // up[u]: рёбра u -> w, rank[w] > rank[u]
+    Level down;  // down[w]: рёбра u -> w, rank[u] > rank[w], хранятся как (u, вес, середина)
+
+    mutable SearchSide forward;
+    mutable SearchSide backward;
+    mutable int lastSettled = 0;
+
+    ContractionHierarchy() = default;
+
+    void checkVertex(Vertex vertex) const {
+        if (vertex < 0 || vertex >= vertexCount) {
+            throw std::out_of_range("Vertex is out of range");
+        }
+    }
+
+    void resetScratch() {
+        forward.reset(vertexCount);
+        backward.reset(vertexCount);
+    }
+
+    // ---------- Предобработка ----------
+
+    // Поиск свидетеля: расстояния от source в несжатом графе без вершины excluded, не дальше limit
+    void witnessSearch(const std::vector<std::vector<WorkEdge>>& out, const std::vector<bool>& contracted,
+                       Vertex source, Vertex excluded, T limit, SearchSide& side) const {
+        side.clear();
+        side.distances[source] = T(0);
+        side.touched.push_back(source);
+        side.queue.Enqueue(source, T(0));
+        int settled = 0;
+        while (!side.queue.isEmpty() && settled < WITNESS_SETTLE_LIMIT) {
+            Pair<int, T> top = side.queue.Dequeue();
+            if (top.second > limit) break;
+            ++settled;
+            for (const WorkEdge& edge : out[top.first]) {
+                if (contracted[edge.to] || edge.to == excluded) continue;
+                T candidate = top.second + edge.weight;
+                if (!(candidate < side.distances[edge.to])) continue;
+                if (side.distances[edge.to] == std::numeric_limits<T>::max()) {
+                    side.touched.push_back(edge.to);
+                }
+                side.distances[edge.to] = candidate;
+                if (side.queue.contains(edge.to)) {
+                    side.queue.decreaseKey(edge.to, candidate);
+                } else {
+                    side.queue.Enqueue(edge.to, candidate);
+                }
+            }
+        }
+    }
+
+    // Сокращения, необходимые при сжатии vertex; шаблон u -> vertex -> w
+    void findShortcuts(Vertex vertex, const std::vector<std::vector<WorkEdge>>& out,
+                       const std::vector<std::vector<WorkEdge>>& in, const std::vector<bool>& contracted,
+                       SearchSide& side, std::vector<Pair<Vertex, WorkEdge>>& shortcuts) const {
+        shortcuts.clear();
+        for (const WorkEdge& incoming : in[vertex]) {
+            Vertex u = incoming.to;
+            if (contracted[u]) continue;
+
+            T maxOutgoing = T(0);
+            bool hasTargets = false;
+            for (const WorkEdge& outgoing : out[vertex]) {
+                if (contracted[outgoing.to] || outgoing.to == u) continue;
+                if (!hasTargets || maxOutgoing < outgoing.weight) maxOutgoing = outgoing.weight;
+                hasTargets = true;
+            }
+            if (!hasTargets) continue;
+
+            witnessSearch(out, contracted, u, vertex, incoming.weight + maxOutgoing, side);
+            for (const WorkEdge& outgoing : out[vertex]) {
+                if (contracted[outgoing.to] || outgoing.to == u) continue;
+                T via = incoming.weight + outgoing.weight;
+                if (via < side.distances[outgoing.to]) {
+                    shortcuts.push_back(Pair<Vertex, WorkEdge>(u, WorkEdge{outgoing.to, via, vertex}));
+                }
+            }
+        }
+    }
+
+    static int liveDegree(const std::vector<WorkEdge>& edges, const std::vector<bool>& contracted) {
+        int degree = 0;
+        for (const WorkEdge& edge : edges) {
+            if (!contracted[edge.to]) ++degree;
+        }
+        return degree;
+    }
+
+    // Добавляет ребро from -> to или уменьшает вес уже существующего
+    static bool addOrImprove(std::vector<WorkEdge>& edges, const WorkEdge& edge) {
+        for (WorkEdge& existing : edges) {
+            if (existing.to == edge.to) {
+                if (!(edge.weight < existing.weight)) return false;
+                existing.weight = edge.weight;
+                existing.middle = edge.middle;
+                return true;
+            }
+        }
+        edges.push_back(edge);
+        return true;
+    }
+
+    void build(const Graph<T>& graph) {
+        int n = vertexCount;
+        std::vector<std::vector<WorkEdge>> out(n), in(n);
+        for (Vertex u = 0; u < n; ++u) {
+            graph.forEachNeighbor(u, [&](Vertex w, const T& weight) {
+                if (weight < T(0)) {
+                    throw std::invalid_argument("Contraction hierarchy requires non-negative weights");
+                }
+                if (w == u) return;
+                if (addOrImprove(out[u], WorkEdge{w, weight, -1})) {
+                    addOrImprove(in[w], WorkEdge{u, weight, -1});
+                }
+            });
+        }
+
+        std::vector<bool> contracted(n, false);
+        std::vector<int> contractedNeighbors(n, 0);
+        std::vector<Pair<Vertex, WorkEdge>> shortcuts;
+        SearchSide side;
+        side.reset(n);
+
+        auto priorityOf = [&](Vertex v) {
+            findShortcuts(v, out, in, contracted, side, shortcuts);
+            int removed = liveDegree(out[v], contracted) + liveDegree(in[v], contracted);
+            return 2 * (int(shortcuts.size()) - removed) + contractedNeighbors[v];
+        };
+
+        IndexedPriorityQueue<long long> order(n);
+        for (Vertex v = 0; v < n; ++v) {
+            order.Enqueue(v, priorityOf(v));
+        }
+
+        rank = DynamicArray<int>(n);
+        int nextRank = 0;
+        while (!order.isEmpty()) {
+            // Ленивое обновление: приоритет пересчитывается перед сжатием
+            Vertex v = order.Dequeue().first;
+            long long priority = priorityOf(v);
+            if (!order.isEmpty() && order.PeekFirst().second < priority) {
+                order.Enqueue(v, priority);
+                continue;
+            }
+
+            for (const Pair<Vertex, WorkEdge>& shortcut : shortcuts) {
+                if (addOrImprove(out[shortcut.first], shortcut.second)) {
+                    addOrImprove(in[shortcut.second.to],
+                                 WorkEdge{shortcut.first, shortcut.second.weight, shortcut.second.middle});
+                    ++shortcutCount;
+                }
+            }
+            contracted[v] = true;
+            rank[v] = nextRank++;
+            for (const WorkEdge& edge : out[v]) {
+                if (!contracted[edge.to]) ++contractedNeighbors[edge.to];
+            }
+            for (const WorkEdge& edge : in[v]) {
+                if (!contracted[edge.to]) ++contractedNeighbors[edge.to];
+            }
+        }
+
+        // Каждое ребро (исходное или сокращение) попадает в восходящий граф одного из концов
+        std::vector<std::vector<WorkEdge>> upEdges(n), downEdges(n);
+        for (Vertex u = 0; u < n; ++u) {
+            for (const WorkEdge& edge : out[u]) {
+                if (rank[u] < rank[edge.to]) {
+                    upEdges[u].push_back(edge);
+                } else {
+                    downEdges[edge.to].push_back(WorkEdge{u, edge.weight, edge.middle});
+                }
+            }
+        }
+        flatten(upEdges, up);
+        flatten(downEdges, down);
+    }
+
+    static void flatten(const std::vector<std::vector<WorkEdge>>& edges, Level& level) {
+        int n = int(edges.size());
+        level.offsets = DynamicArray<int>(n + 1);
+        for (Vertex v = 0; v < n; ++v) {
+            level.offsets[v + 1] = level.offsets[v] + int(edges[v].size());
+        }
+        int total = level.offsets[n];
+        level.targets = DynamicArray<int>(total);
+        level.weights = DynamicArray<T>(total);
+        level.middles = DynamicArray<int>(total);
+        for (Vertex v = 0; v < n; ++v) {
+            int position = level.offsets[v];
+            for (const WorkEdge& edge : edges[v]) {
+                level.targets[position] = edge.to;
+                level.weights[position] = edge.weight;
+                level.middles[position] = edge.middle;
+                ++position;
+            }
+        }
+    }
+
+    // ---------- Запросы ----------
+
+    // Возвращает (длина, вершина встречи); вершина встречи -1, если пути нет
+    Pair<T, Vertex> search(Vertex source, Vertex target) const {
+        checkVertex(source);
+        checkVertex(target);
+        const T INF = std::numeric_limits<T>::max();
+        forward.clear();
+        backward.clear();
+        lastSettled = 0;
+
+        SearchSide* sides[2] = {&forward, &backward};
+        const Level* levels[2] = {&up, &down};
+        sides[0]->distances[source] = T(0);
+        sides[0]->touched.push_back(source);
+        sides[0]->queue.Enqueue(source, T(0));
+        sides[1]->distances[target] = T(0);
+        sides[1]->touched.push_back(target);
+        sides[1]->queue.Enqueue(target, T(0));
+
+        T best = INF;
+        Vertex meeting = -1;
+        while (true) {
+            // Направление завершается, когда его минимум не меньше лучшего найденного пути
+            for (SearchSide* side : sides) {
+                if (!side->queue.isEmpty() && best != INF && !(side->queue.PeekFirst().second < best)) {
+                    side->queue.clear();
+                }
+            }
+            int current;
+            if (sides[0]->queue.isEmpty() && sides[1]->queue.isEmpty()) break;
+            if (sides[0]->queue.isEmpty()) {
+                current = 1;
+            } else if (sides[1]->queue.isEmpty()) {
+                current = 0;
+            } else {
+                current = sides[0]->queue.PeekFirst().second <= sides[1]->queue.PeekFirst().second ? 0 : 1;
+            }
+
+            SearchSide& side = *sides[current];
+            const SearchSide& other = *sides[1 - current];
+            Pair<int, T> top = side.queue.Dequeue();
+            Vertex u = top.first;
+            T du = top.second;
+            ++lastSettled;
+
+            if (other.distances[u] != INF && du <= INF - other.distances[u] && du + other.distances[u] < best) {
+                best = du + other.distances[u];
+                meeting = u;
+            }
+            // Остановка по требованию: вершина достижима короче через более высокую вершину
+            if (isStalled(u, du, side, *levels[1 - current])) continue;
+
+            const Level& level = *levels[current];
+            for (int i = level.offsets[u]; i < level.offsets[u + 1]; ++i) {
+                Vertex w = level.targets[i];
+                T weight = level.weights[i];
+                if (du > INF - weight) continue;
+                T candidate = du + weight;
+                if (!(candidate < side.distances[w])) continue;
+                if (side.distances[w] == INF) side.touched.push_back(w);
+                side.distances[w] = candidate;
+                side.predecessors[w] = u;
+                if (side.queue.contains(w)) {
+                    side.queue.decreaseKey(w, candidate);
+                } else {
+                    side.queue.Enqueue(w, candidate);
+                }
+            }
+        }
+        return Pair<T, Vertex>(best, meeting);
+    }
+
+    // Рёбра противоположного уровня в u ведут из вершин с большим рангом в u
+    static bool isStalled(Vertex u, T du, const SearchSide& side, const Level& opposite) {
+        const T INF = std::numeric_limits<T>::max();
+        for (int i = opposite.offsets[u]; i < opposite.offsets[u + 1]; ++i) {
+            T dw = side.distances[opposite.targets[i]];
+            if (dw != INF && dw <= INF - opposite.weights[i] && dw + opposite.weights[i] < du) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Средняя вершина ребра from -> to иерархии (-1 для ребра исходного графа)
+    Vertex middleOf(Vertex from, Vertex to) const {
+        if (rank[from] < rank[to]) {
+            for (int i = up.offsets[from]; i < up.offsets[from + 1]; ++i) {
+                if (up.targets[i] == to) return up.middles[i];
+            }
+        } else {
+            for (int i = down.offsets[to]; i < down.offsets[to + 1]; ++i) {
+                if (down.targets[i] == from) return down.middles[i];
+            }
+        }
+        throw std::logic_error("Contraction hierarchy edge not found");
+    }
+
+    // Раскрывает ребро иерархии from -> to и дописывает вершины пути после from
+    void unpackEdge(Vertex from, Vertex to, ArraySequence<Vertex>& path) const {
+        std::vector<Pair<Vertex, Vertex>> stack;
+        stack.push_back(Pair<Vertex, Vertex>(from, to));
+        while (!stack.empty()) {
+            Pair<Vertex, Vertex> edge = stack.back();
+            stack.pop_back();
+            Vertex middle = middleOf(edge.first, edge.second);
+            if (middle == -1) {
+                path.append(edge.second);
+            } else {
+                stack.push_back(Pair<Vertex, Vertex>(middle, edge.second));
+                stack.push_back(Pair<Vertex, Vertex>(edge.first, middle));
+            }
+        }
+    }
+
+    // ---------- Сериализация ----------
+
+    template<class V>
+    static void writeValue(std::ostream& out, const V& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(V));
+    }
+
+    template<class V>
+    static V readValue(std::istream& in) {
+        V value;
+        in.read(reinterpret_cast<char*>(&value), sizeof(V));
+        if (!in) {
+            throw std::runtime_error("Unexpected end of contraction hierarchy data");
+        }
+        return value;
+    }
+
+    template<class V>
+    static void writeArray(std::ostream& out, const DynamicArray<V>& array) {
+        writeValue(out, std::int32_t(array.getSize()));
+        if (array.getSize() > 0) {
+            out.write(reinterpret_cast<const char*>(&array[0]), std::streamsize(sizeof(V)) * array.getSize());
+        }
+    }
+
+    template<class V>
+    static DynamicArray<V> readArray(std::istream& in) {
+        std::int32_t size = readValue<std::int32_t>(in);
+        if (size < 0) {
+            throw std::runtime_error("Corrupted contraction hierarchy");
+        }
+        DynamicArray<V> array(size);
+        if (size > 0) {
+            in.read(reinterpret_cast<char*>(&array[0]), std::streamsize(sizeof(V)) * size);
+            if (!in) {
+                throw std::runtime_error("Unexpected end of contraction hierarchy data");
+            }
+        }
+        return array;
+    }
+
+    // Проверяет согласованность загруженных массивов, чтобы запросы не вышли за их границы
+    void validate() const {
+        if (rank.getSize() != vertexCount) {
+            throw std::runtime_error("Corrupted contraction hierarchy");
+        }
+        for (const Level* level : {&up, &down}) {
+            if (level->offsets.getSize() != vertexCount + 1 || level->offsets[0] != 0) {
+                throw std::runtime_error("Corrupted contraction hierarchy");
+            }
+            for (Vertex v = 0; v < vertexCount; ++v) {
+                if (level->offsets[v + 1] < level->offsets[v]) {
+                    throw std::runtime_error("Corrupted contraction hierarchy");
+                }
+            }
+            int total = level->offsets[vertexCount];
+            if (level->targets.getSize() != total || level->weights.getSize() != total ||
+                level->middles.getSize() != total) {
+                throw std::runtime_error("Corrupted contraction hierarchy");
+            }
+            for (int i = 0; i < total; ++i) {
+                if (level->targets[i] < 0 || level->targets[i] >= vertexCount ||
+                    level->middles[i] < -1 || level->middles[i] >= vertexCount) {
+                    throw std::runtime_error("Corrupted contraction hierarchy");
+                }
+            }
+        }
+    }
+};
+
+#endif //CONTRACTION_HIERARCHY_H
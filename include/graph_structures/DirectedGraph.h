@@ -15,22 +15,50 @@
 template<class T>
 class DirectedGraph : public Graph<T> {
 private:
+    using EdgePool = typename IDictionaryBinaryTree<int, T>::Pool;
+
     IDictionaryBinaryTree<int, IDictionaryBinaryTree<int, T>> adjacencyList; ///< Список смежности графа.
     int vertexCount; ///< Количество вершин в графе.
+    std::shared_ptr<EdgePool> edgePool; ///< Общий пул узлов для словарей исходящих рёбер всех вершин.
+
+    // Заполняет список смежности пустыми словарями, выделяющими узлы из нового общего пула.
+    // Ключи 0..n-1 уже отсортированы, поэтому дерево строится за O(n) без перебалансировок.
+    void initAdjacencyList() {
+        edgePool = std::make_shared<EdgePool>();
+        adjacencyList.BuildFromSorted(vertexCount, [](int i) { return i; }, [this](int) {
+            return IDictionaryBinaryTree<int, T>(edgePool);
+        });
+    }
+
+    // Копирует рёбра другого графа в собственный пул (соседи перечисляются по возрастанию)
+    void copyEdges(const DirectedGraph<T> &graph) {
+        DynamicArray<int> targets;
+        DynamicArray<T> weights;
+        for (int i = 0; i < vertexCount; ++i) {
+            targets.clear();
+            weights.clear();
+            graph.forEachNeighbor(i, [&targets, &weights](int neighbor, const T &weight) {
+                targets.append(neighbor);
+                weights.append(weight);
+            });
+            adjacencyList.GetReference(i).BuildFromSorted(
+                    targets.getSize(),
+                    [&targets](int k) { return targets[k]; },
+                    [&weights](int k) { return weights[k]; });
+        }
+    }
 
 public:
     /**
      * @brief Конструктор для инициализации графа с заданным количеством вершин.
      *
      * Каждая вершина инициализируется пустым словарём для хранения исходящих ребер.
+     * Узлы всех словарей рёбер выделяются из одного пула графа.
      *
      * @param vertices Количество вершин в графе.
      */
     explicit DirectedGraph(int vertices) : vertexCount(vertices) {
-        // Инициализируем список смежности пустыми словарями для каждой вершины
-        for (int i = 0; i < vertices; ++i) {
-            adjacencyList.Add(i, IDictionaryBinaryTree<int, T>());
-        }
+        initAdjacencyList();
     }
 
     /**
@@ -40,7 +68,10 @@ public:
      *
      * @param graph Граф, который необходимо скопировать.
      */
-    DirectedGraph(const DirectedGraph<T> &graph) : vertexCount(graph.vertexCount), adjacencyList(graph.adjacencyList) {}
+    DirectedGraph(const DirectedGraph<T> &graph) : vertexCount(graph.vertexCount) {
+        initAdjacencyList();
+        copyEdges(graph);
+    }
 
     /**
      * @brief Оператор присваивания.
@@ -54,8 +85,35 @@ public:
         if (this == &graph) {
             return *this; // Самоприсваивание, ничего не делаем
         }
+        adjacencyList.Clear();
         vertexCount = graph.vertexCount;
-        adjacencyList = graph.adjacencyList;
+        initAdjacencyList();
+        copyEdges(graph);
+        return *this;
+    }
+
+    /**
+     * @brief Конструктор перемещения: список смежности и пул рёбер передаются без копирования.
+     *
+     * Исходный граф остаётся пустым графом без вершин.
+     */
+    DirectedGraph(DirectedGraph<T> &&graph) noexcept
+            : adjacencyList(std::move(graph.adjacencyList)), vertexCount(graph.vertexCount),
+              edgePool(std::move(graph.edgePool)) {
+        graph.vertexCount = 0;
+    }
+
+    /**
+     * @brief Оператор перемещения; исходный граф остаётся пустым графом без вершин.
+     */
+    DirectedGraph<T> &operator=(DirectedGraph<T> &&graph) noexcept {
+        if (this != &graph) {
+            // Старые словари рёбер освобождаются раньше своего пула
+            adjacencyList = std::move(graph.adjacencyList);
+            edgePool = std::move(graph.edgePool);
+            vertexCount = graph.vertexCount;
+            graph.vertexCount = 0;
+        }
         return *this;
     }
 
@@ -85,7 +143,7 @@ public:
      * @throws std::invalid_argument Если ребро не найдено.
      */
     void removeEdge(int from, int to) override {
-        if (adjacencyList.ContainsKey(from) && adjacencyList.Get(from).ContainsKey(to)) {
+        if (adjacencyList.ContainsKey(from) && adjacencyList.GetReference(from).ContainsKey(to)) {
             adjacencyList.GetReference(from).Remove(to); // Удаляем направление 'from' -> 'to'
         } else {
             throw std::invalid_argument("Edge not found");
@@ -101,7 +159,7 @@ public:
      * @return false Если ребра нет.
      */
     bool hasEdge(int from, int to) const override {
-        return adjacencyList.ContainsKey(from) && adjacencyList.Get(from).ContainsKey(to);
+        return from >= 0 && from < vertexCount && adjacencyList.GetReference(from).ContainsKey(to);
     }
 
     /**
@@ -118,7 +176,7 @@ public:
         if (!adjacencyList.ContainsKey(vertex)) {
             throw std::out_of_range("Vertex not found");
         }
-        return adjacencyList.Get(vertex).GetCount();
+        return adjacencyList.GetReference(vertex).GetCount();
     }
 
     /**
@@ -132,18 +190,31 @@ public:
      */
     ArraySequence<Pair<int, T>> getNeighbors(int vertex) const override {
         ArraySequence<Pair<int, T>> neighbors;
-        if (adjacencyList.ContainsKey(vertex)) {
-            auto neighborDict = adjacencyList.Get(vertex);
-            auto keys = neighborDict.GetKeys();
-            for (int i = 0; i < keys.getLength(); ++i) {
-                int neighbor = keys[i];
-                T weight = neighborDict.Get(neighbor);
-                neighbors.append(Pair<int, T>(neighbor, weight));
-            }
-        }
+        this->forEachNeighbor(vertex, [&neighbors](int neighbor, const T &weight) {
+            neighbors.append(Pair<int, T>(neighbor, weight));
+        });
         return neighbors;
     }
 
+    /**
+     * @brief Обходит исходящие рёбра вершины без копирования списка смежности.
+     *
+     * Посетитель получает соседей в порядке возрастания их номеров прямо из
+     * внутреннего дерева вершины.
+     *
+     * @param vertex Вершина, соседей которой необходимо обойти.
+     * @param visitor Посетитель, вызываемый для каждой пары (сосед, вес).
+     */
+    void visitNeighbors(int vertex, typename Graph<T>::NeighborVisitor &visitor) const override {
+        if (vertex < 0 || vertex >= vertexCount) {
+            return;
+        }
+        const auto &neighborDict = adjacencyList.GetReference(vertex);
+        for (auto it = neighborDict.begin(); it != neighborDict.end(); ++it) {
+            visitor.apply(it->key, it->value);
+        }
+    }
+
     /**
      * @brief Возвращает вес ориентированного ребра между двумя вершинами.
      *
@@ -154,7 +225,7 @@ public:
      */
     T getEdgeWeight(int from, int to) const override {
         if (hasEdge(from, to)) {
-            return adjacencyList.Get(from).Get(to);
+            return adjacencyList.GetReference(from).Get(to);
         }
         throw std::invalid_argument("Edge not found");
     }
@@ -165,16 +236,10 @@ public:
      * Каждое ребро выводится с указанием направления и веса.
      */
     void printGraph() const override {
-        auto keys = adjacencyList.GetKeys();
-        for (int i = 0; i < keys.getLength(); ++i) {
-            int from = keys[i];
-            auto neighborDict = adjacencyList.Get(from);
-            auto neighbors = neighborDict.GetKeys();
-            for (int j = 0; j < neighbors.getLength(); ++j) {
-                int to = neighbors[j];
-                T weight = neighborDict.Get(to);
+        for (int from = 0; from < vertexCount; ++from) {
+            this->forEachNeighbor(from, [from](int to, const T &weight) {
                 std::cout << "Edge (" << from << " -> " << to << ") with weight: " << weight << std::endl;
-            }
+            });
         }
     }
 
@@ -220,16 +285,10 @@ public:
      */
     ArraySequence<std::tuple<int, int, T>> getEdges() const override {
         ArraySequence<std::tuple<int, int, T>> edges;
-        auto keys = adjacencyList.GetKeys();
-        for (int i = 0; i < keys.getLength(); ++i) {
-            int from = keys[i];
-            auto neighborDict = adjacencyList.Get(from);
-            auto neighbors = neighborDict.GetKeys();
-            for (int j = 0; j < neighbors.getLength(); ++j) {
-                int to = neighbors[j];
-                T weight = neighborDict.Get(to);
+        for (int from = 0; from < vertexCount; ++from) {
+            this->forEachNeighbor(from, [&edges, from](int to, const T &weight) {
                 edges.append(std::make_tuple(from, to, weight));
-            }
+            });
         }
 
         return edges;
@@ -249,12 +308,9 @@ public:
 
         // Инвертируем направления всех рёбер
         for (int u = 0; u < vertexCount; ++u) {
-            auto neighbors = graph.getNeighbors(u);
-            for (int i = 0; i < neighbors.getLength(); ++i) {
-                int v = neighbors[i].first;
-                T weight = neighbors[i].second;
+            graph.forEachNeighbor(u, [&transposedGraph, u](int v, const T &weight) {
                 transposedGraph.addEdge(v, u, weight); // Инвертируем ребро
-            }
+            });
         }
 
         return transposedGraph;
@@ -291,13 +347,11 @@ private:
             visit(vertex);
         }
 
-        auto neighbors = getNeighbors(vertex);
-        for (int i = 0; i < neighbors.getLength(); ++i) {
-            int neighbor = neighbors[i].first;
+        this->forEachNeighbor(vertex, [&](int neighbor, const T &) {
             if (!visited[neighbor]) {
                 dfsUtil(neighbor, visited, visit);
             }
-        }
+        });
     }
 };
 
@@ -0,0 +1,382 @@
+#ifndef DYNAMIC_CONNECTIVITY_H
+#define DYNAMIC_CONNECTIVITY_H
+
+#include "UndirectedGraph.h"
+#include "EulerTourForest.h"
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Связность неориентированного графа при добавлении и удалении рёбер.
+ *
+ * Реализована схема Холма–де Лихтенберга–Торупа. Каждое ребро имеет уровень (от 0 до log2 n);
+ * F_i — остовный лес из рёбер дерева уровня не ниже i, так что F_0 — остовный лес всего графа.
+ * Каждый лес хранится как `EulerTourForest`, что даёт проверку связности, связывание
+ * и разрезание деревьев за O(log n).
+ *
+ * При удалении ребра дерева уровня l ищется замена на уровнях l, l-1, ..., 0: в меньшей из двух
+ * половин рёбра дерева этого уровня поднимаются на уровень выше, а рёбра вне дерева
+ * просматриваются, пока не найдётся ребро в другую половину; просмотренные без успеха рёбра
+ * тоже поднимаются. Деревья уровня i содержат не больше n / 2^i вершин, поэтому уровень
+ * каждого ребра растёт не более log2 n раз, и обновление стоит O(log^2 n) амортизированно.
+ *
+ * Если рёбра только добавляются, достаточно системы непересекающихся множеств
+ * (см. `EdgeStreamComponents`).
+ *
+ * Запросы только читают деревья и могут выполняться параллельно друг с другом,
+ * но не с обновлениями. Петли не влияют на связность и игнорируются.
+ */
+class DynamicConnectivity {
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+
+    /**
+     * @brief Создаёт структуру для графа без рёбер.
+     *
+     * @throws std::invalid_argument Если число вершин отрицательно.
+     */
+    explicit DynamicConnectivity(int vertexCount)
+            : vertexCount(vertexCount), componentCount(vertexCount) {
+        if (vertexCount < 0) {
+            throw std::invalid_argument("Vertex count must be non-negative");
+        }
+        ensureLevel(0);
+    }
+
+    /**
+     * @brief Добавляет ребро {u, v}.
+     *
+     * @return true, если ребро соединило две разные компоненты.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     * @throws std::invalid_argument Если ребро уже существует.
+     */
+    bool addEdge(Vertex u, Vertex v) {
+        checkVertex(u);
+        checkVertex(v);
+        if (u == v) return false;
+        if (edgeIds.count(edgeKey(u, v))) {
+            throw std::invalid_argument("Edge already exists");
+        }
+
+        int e = allocateEdge(u, v);
+        edgeIds.emplace(edgeKey(u, v), e);
+        bool joins = !sameTree(0, u, v);
+        if (joins) {
+            edges[e].tree = true;
+            link(0, e);
+            --componentCount;
+        }
+        attach(e);
+        return joins;
+    }
+
+    /**
+     * @brief Удаляет ребро {u, v}.
+     *
+     * @return true, если компонента распалась на две.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     * @throws std::invalid_argument Если ребра нет.
+     */
+    bool removeEdge(Vertex u, Vertex v) {
+        checkVertex(u);
+        checkVertex(v);
+        if (u == v) return false;
+        auto found = edgeIds.find(edgeKey(u, v));
+        if (found == edgeIds.end()) {
+            throw std::invalid_argument("Edge not found");
+        }
+        int e = found->second;
+        edgeIds.erase(found);
+        detach(e);
+
+        bool splits = false;
+        if (edges[e].tree) {
+            int level = edges[e].level;
+            for (int i = 0; i <= level; ++i) {
+                cut(i, e);
+            }
+            splits = true;
+            for (int i = level; i >= 0 && splits; --i) {
+                splits = !replace(i, edges[e].u, edges[e].v);
+            }
+            if (splits) ++componentCount;
+        }
+        freeEdge(e);
+        return splits;
+    }
+
+    /**
+     * @brief Проверяет, лежат ли вершины в одной компоненте связности.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    bool connected(Vertex u, Vertex v) const {
+        checkVertex(u);
+        checkVertex(v);
+        return sameTree(0, u, v);
+    }
+
+    bool hasEdge(Vertex u, Vertex v) const {
+        return u != v && edgeIds.count(edgeKey(u, v)) != 0;
+    }
+
+    /**
+     * @brief Число вершин в компоненте, содержащей вершину.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    int getComponentSize(Vertex vertex) const {
+        checkVertex(vertex);
+        return levels[0].forest.treeSize(vertex);
+    }
+
+    int getComponentCount() const {
+        return componentCount;
+    }
+
+    int getVertexCount() const {
+        return vertexCount;
+    }
+
+    int getEdgeCount() const {
+        return int(edgeIds.size());
+    }
+
+    /**
+     * @brief Число уровней, до которых поднимались рёбра (не больше log2 n + 1).
+     */
+    int getLevelCount() const {
+        return int(levels.size());
+    }
+
+private:
+    static constexpr unsigned char TREE_EDGES = 1;      // У вершины есть рёбра дерева этого уровня
+    static constexpr unsigned char NON_TREE_EDGES = 2;  // У вершины есть рёбра вне дерева этого уровня
+
+    struct FlagUnion {
+        unsigned char operator()(unsigned char a, unsigned char b) const {
+            return a | b;
+        }
+    };
+
+    typedef EulerTourForest<unsigned char, FlagUnion> Forest;
+
+    struct Level {
+        Forest forest;                               // Значение вершины — её флаги на этом уровне
+        std::vector<std::vector<int>> treeEdges;     // Рёбра дерева ровно этого уровня
+        std::vector<std::vector<int>> nonTreeEdges;  // Рёбра вне дерева ровно этого уровня
+
+        Level(int vertexCount, unsigned seed)
+                : forest(vertexCount, 0, seed), treeEdges(vertexCount), nonTreeEdges(vertexCount) {}
+    };
+
+    struct Edge {
+        Vertex u = -1;
+        Vertex v = -1;
+        int level = 0;
+        bool tree = false;
+        int slot[2] = {-1, -1};                         // Позиции в списках u и v на уровне level
+        std::vector<Forest::EdgeHandle> tourEdges;      // Копии ребра в обходах уровней 0..level
+    };
+
+    int vertexCount;
+    int componentCount;
+    std::vector<Level> levels;
+    std::vector<Edge> edges;
+    std::vector<int> freeEdges;
+    std::unordered_map<long long, int> edgeIds;
+
+    void checkVertex(Vertex vertex) const {
+        if (vertex < 0 || vertex >= vertexCount) {
+            throw std::out_of_range("Vertex is out of range");
+        }
+    }
+
+    static long long edgeKey(Vertex u, Vertex v) {
+        if (u > v) std::swap(u, v);
+        return (static_cast<long long>(u) << 32) | static_cast<unsigned>(v);
+    }
+
+    int allocateEdge(Vertex u, Vertex v) {
+        int e;
+        if (freeEdges.empty()) {
+            e = int(edges.size());
+            edges.emplace_back();
+        } else {
+            e = freeEdges.back();
+            freeEdges.pop_back();
+        }
+        edges[e].u = u;
+        edges[e].v = v;
+        edges[e].level = 0;
+        edges[e].tree = false;
+        edges[e].tourEdges.clear();
+        return e;
+    }
+
+    void freeEdge(int e) {
+        edges[e].tourEdges.clear();
+        freeEdges.push_back(e);
+    }
+
+    void ensureLevel(int level) {
+        while (int(levels.size()) <= level) {
+            levels.emplace_back(vertexCount, unsigned(levels.size() + 1));
+        }
+    }
+
+    bool sameTree(int level, Vertex u, Vertex v) const {
+        return levels[level].forest.connected(u, v);
+    }
+
+    void link(int level, int e) {
+        if (int(edges[e].tourEdges.size()) <= level) edges[e].tourEdges.resize(level + 1);
+        edges[e].tourEdges[level] = levels[level].forest.link(edges[e].u, edges[e].v);
+    }
+
+    void cut(int level, int e) {
+        levels[level].forest.cut(edges[e].tourEdges[level]);
+    }
+
+    // ---- Списки рёбер по уровням ----
+
+    std::vector<int>& listOf(int e, Vertex endpoint) {
+        Level& level = levels[edges[e].level];
+        return edges[e].tree ? level.treeEdges[endpoint] : level.nonTreeEdges[endpoint];
+    }
+
+    void attach(int e) {
+        Vertex ends[2] = {edges[e].u, edges[e].v};
+        for (int side = 0; side < 2; ++side) {
+            std::vector<int>& list = listOf(e, ends[side]);
+            edges[e].slot[side] = int(list.size());
+            list.push_back(e);
+            if (list.size() == 1) refreshFlags(edges[e].level, ends[side]);
+        }
+    }
+
+    void detach(int e) {
+        Vertex ends[2] = {edges[e].u, edges[e].v};
+        for (int side = 0; side < 2; ++side) {
+            std::vector<int>& list = listOf(e, ends[side]);
+            int moved = list.back();
+            list[edges[e].slot[side]] = moved;
+            edges[moved].slot[edges[moved].u == ends[side] ? 0 : 1] = edges[e].slot[side];
+            list.pop_back();
+            if (list.empty()) refreshFlags(edges[e].level, ends[side]);
+        }
+    }
+
+    void refreshFlags(int level, Vertex vertex) {
+        Level& current = levels[level];
+        current.forest.setValue(vertex, (current.treeEdges[vertex].empty() ? 0 : TREE_EDGES)
+                                        | (current.nonTreeEdges[vertex].empty() ? 0 : NON_TREE_EDGES));
+    }
+
+    // Вершина дерева vertex на уровне level с флагом flag, либо -1
+    Vertex findFlagged(int level, Vertex vertex, unsigned char flag) const {
+        return levels[level].forest.findVertex(vertex, [flag](unsigned char flags) { return (flags & flag) != 0; });
+    }
+
+    // ---- Поиск замены ----
+
+    // Поднимает ребро на уровень выше; ребро дерева входит в лес следующего уровня
+    void raise(int e) {
+        detach(e);
+        ++edges[e].level;
+        if (edges[e].tree) link(edges[e].level, e);
+        attach(e);
+    }
+
+    // Ищет на уровне level ребро, соединяющее деревья u и v, и делает его ребром дерева
+    bool replace(int level, Vertex u, Vertex v) {
+        ensureLevel(level + 1);
+        const Forest& forest = levels[level].forest;
+        Vertex smaller = forest.treeSize(u) <= forest.treeSize(v) ? u : v;
+
+        // Меньшая половина помещается на уровень выше целиком
+        for (Vertex vertex = findFlagged(level, smaller, TREE_EDGES); vertex != -1;
+             vertex = findFlagged(level, smaller, TREE_EDGES)) {
+            std::vector<int>& list = levels[level].treeEdges[vertex];
+            while (!list.empty()) {
+                raise(list.back());
+            }
+        }
+
+        for (Vertex vertex = findFlagged(level, smaller, NON_TREE_EDGES); vertex != -1;
+             vertex = findFlagged(level, smaller, NON_TREE_EDGES)) {
+            std::vector<int>& list = levels[level].nonTreeEdges[vertex];
+            while (!list.empty()) {
+                int e = list.back();
+                Vertex other = edges[e].u == vertex ? edges[e].v : edges[e].u;
+                if (forest.connected(other, smaller)) {
+                    raise(e);
+                    continue;
+                }
+                detach(e);
+                edges[e].tree = true;
+                for (int i = 0; i <= level; ++i) {
+                    link(i, e);
+                }
+                attach(e);
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Неориентированный граф, поддерживающий компоненты связности при каждом изменении.
+ *
+ * Методы addEdge и removeEdge изменяют граф и сразу обновляют `DynamicConnectivity`,
+ * поэтому связность и число компонент доступны без повторного запуска `ConnectedComponents`.
+ *
+ * @tparam T Тип данных, ассоциированный с рёбрами графа.
+ */
+template<class T>
+class ConnectivityTrackingGraph : public UndirectedGraph<T> {
+private:
+    DynamicConnectivity connectivity;
+
+public:
+    explicit ConnectivityTrackingGraph(int vertices) : UndirectedGraph<T>(vertices), connectivity(vertices) {}
+
+    /**
+     * @brief Добавляет ребро и обновляет компоненты связности.
+     *
+     * @throws std::out_of_range Если индексы вершин выходят за допустимый диапазон.
+     */
+    void addEdge(int from, int to, T weight) override {
+        UndirectedGraph<T>::addEdge(from, to, weight);
+        connectivity.addEdge(from, to);
+    }
+
+    /**
+     * @brief Удаляет ребро и обновляет компоненты связности.
+     *
+     * @throws std::invalid_argument Если ребро не найдено между вершинами.
+     */
+    void removeEdge(int from, int to) override {
+        UndirectedGraph<T>::removeEdge(from, to);
+        connectivity.removeEdge(from, to);
+    }
+
+    bool connected(int u, int v) const {
+        return connectivity.connected(u, v);
+    }
+
+    int getComponentCount() const {
+        return connectivity.getComponentCount();
+    }
+
+    const DynamicConnectivity& getConnectivity() const {
+        return connectivity;
+    }
+};
+
+#endif //DYNAMIC_CONNECTIVITY_H
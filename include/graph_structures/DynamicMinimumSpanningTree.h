@@ -0,0 +1,558 @@
+#ifndef DYNAMIC_MINIMUM_SPANNING_TREE_H
+#define DYNAMIC_MINIMUM_SPANNING_TREE_H
+
+#include "UndirectedGraph.h"
+#include "EulerTourForest.h"
+#include "MinimumSpanningTree.h"
+#include "../sequence/ArraySequence.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Минимальный остовный лес, поддерживаемый при вставке, удалении и изменении веса рёбер.
+ *
+ * Лес хранится в двух представлениях:
+ * - дерево связей и разрезов (link-cut tree, splay-деревья путей), где каждое ребро леса —
+ *   отдельный узел со своим весом; оно находит самое тяжёлое ребро на пути между вершинами;
+ * - `EulerTourForest`, где значение вершины — самое лёгкое инцидентное ей ребро вне леса,
+ *   а свёртка дерева — самое лёгкое ребро вне леса с концом в этом дереве.
+ *
+ * Вставка ребра {u, v}: если u и v в разных деревьях, ребро входит в лес; иначе оно заменяет
+ * самое тяжёлое ребро пути u–v, если легче его. Удаление ребра леса разрезает дерево, после
+ * чего рёбра вне леса меньшей половины перебираются по возрастанию веса: первое ребро,
+ * ведущее в другую половину, — лёгкая замена. Изменение веса — удаление и вставка.
+ *
+ * Вставка и удаление ребра вне леса стоят O(log n). Удаление ребра леса стоит O(log n) на
+ * каждое ребро вне леса, лежащее внутри меньшей половины и более лёгкое, чем найденная замена;
+ * обычно их немного, но в худшем случае это все рёбра меньшей половины.
+ *
+ * Суммарный вес и рёбра леса доступны без пересчёта.
+ *
+ * @tparam T Тип веса рёбер (арифметический).
+ */
+template<typename T>
+class DynamicMinimumSpanningTree {
+    static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+    typedef std::tuple<int, int, T> Edge; /**< Ребро (вершина1, вершина2, вес), вершина1 < вершина2. */
+
+    /**
+     * @brief Создаёт структуру для графа без рёбер.
+     *
+     * @throws std::invalid_argument Если число вершин отрицательно.
+     */
+    explicit DynamicMinimumSpanningTree(int vertexCount)
+            : vertexCount(checkedCount(vertexCount)), componentCount(vertexCount),
+              tour(vertexCount, NO_CANDIDATE), incident(vertexCount) {
+        growPathNodes();
+    }
+
+    /**
+     * @brief Строит структуру по рёбрам неориентированного графа.
+     *
+     * Сначала вставляется остов, найденный `MinimumSpanningTree::kruskal`, затем остальные
+     * рёбра, так что замен при построении не происходит.
+     */
+    explicit DynamicMinimumSpanningTree(const UndirectedGraph<T>& graph)
+            : DynamicMinimumSpanningTree(graph.getVertexCount()) {
+        insertGraph(graph, MinimumSpanningTree<T>::kruskal(graph));
+    }
+
+    /**
+     * @throws std::invalid_argument Если граф ориентированный.
+     */
+    explicit DynamicMinimumSpanningTree(const CSRGraph<T>& graph)
+            : DynamicMinimumSpanningTree(graph.getVertexCount()) {
+        insertGraph(graph, MinimumSpanningTree<T>::kruskal(graph));
+    }
+
+    /**
+     * @brief Добавляет ребро {u, v} с весом weight.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     * @throws std::invalid_argument Если ребро уже существует.
+     */
+    void addEdge(Vertex u, Vertex v, T weight) {
+        checkVertex(u);
+        checkVertex(v);
+        if (u == v) return;
+        if (edgeIds.count(edgeKey(u, v))) {
+            throw std::invalid_argument("Edge already exists");
+        }
+
+        int e = allocateEdge(u, v, weight);
+        edgeIds.emplace(edgeKey(u, v), e);
+        if (!tour.connected(u, v)) {
+            --componentCount;
+            joinForest(e);
+            return;
+        }
+        int heaviest = heaviestOnPath(u, v);
+        if (weight < edges[heaviest].weight) {
+            leaveForest(heaviest);
+            attachCandidate(heaviest);
+            joinForest(e);
+        } else {
+            attachCandidate(e);
+        }
+    }
+
+    /**
+     * @brief Удаляет ребро {u, v}; если оно было в лесу, ищет самую лёгкую замену.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     * @throws std::invalid_argument Если ребра нет.
+     */
+    void removeEdge(Vertex u, Vertex v) {
+        int e = findEdge(u, v);
+        edgeIds.erase(edgeKey(u, v));
+        if (!edges[e].tree) {
+            detachCandidate(e);
+            freeEdges.push_back(e);
+            return;
+        }
+        leaveForest(e);
+        freeEdges.push_back(e);
+
+        int replacement = lightestCrossing(u, v);
+        if (replacement == -1) {
+            ++componentCount;
+        } else {
+            detachCandidate(replacement);
+            joinForest(replacement);
+        }
+    }
+
+    /**
+     * @brief Меняет вес ребра {u, v}.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     * @throws std::invalid_argument Если ребра нет.
+     */
+    void updateWeight(Vertex u, Vertex v, T weight) {
+        int e = findEdge(u, v);
+        if (!(weight < edges[e].weight) && !(edges[e].weight < weight)) return;
+        removeEdge(u, v);
+        addEdge(u, v, weight);
+    }
+
+    bool hasEdge(Vertex u, Vertex v) const {
+        return u != v && edgeIds.count(edgeKey(u, v)) != 0;
+    }
+
+    /**
+     * @brief Проверяет, входит ли ребро {u, v} в текущий минимальный остовный лес.
+     */
+    bool inForest(Vertex u, Vertex v) const {
+        auto found = u == v ? edgeIds.end() : edgeIds.find(edgeKey(u, v));
+        return found != edgeIds.end() && edges[found->second].tree;
+    }
+
+    /**
+     * @brief Проверяет, лежат ли вершины в одной компоненте связности.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    bool connected(Vertex u, Vertex v) const {
+        checkVertex(u);
+        checkVertex(v);
+        return tour.connected(u, v);
+    }
+
+    /**
+     * @brief Рёбра текущего минимального остовного леса.
+     */
+    ArraySequence<Edge> getForest() const {
+        ArraySequence<Edge> forest;
+        for (int e : forestEdges) {
+            forest.append(Edge(std::min(edges[e].u, edges[e].v), std::max(edges[e].u, edges[e].v), edges[e].weight));
+        }
+        return forest;
+    }
+
+    T getTotalWeight() const {
+        return totalWeight;
+    }
+
+    int getForestEdgeCount() const {
+        return int(forestEdges.size());
+    }
+
+    int getComponentCount() const {
+        return componentCount;
+    }
+
+    int getVertexCount() const {
+        return vertexCount;
+    }
+
+    int getEdgeCount() const {
+        return int(edgeIds.size());
+    }
+
+private:
+    // Кандидат на замену: (вес, номер ребра); сравнение пар делает порядок рёбер строгим
+    typedef std::pair<T, int> Candidate;
+
+    struct Lighter {
+        Candidate operator()(const Candidate& a, const Candidate& b) const {
+            return b < a ? b : a;
+        }
+    };
+
+    typedef EulerTourForest<Candidate, Lighter> Forest;
+
+    static constexpr Candidate NO_CANDIDATE{std::numeric_limits<T>::max(), std::numeric_limits<int>::max()};
+
+    struct EdgeRecord {
+        Vertex u = -1;
+        Vertex v = -1;
+        T weight = T();
+        bool tree = false;
+        int forestSlot = -1;              // Позиция в forestEdges
+        typename Forest::EdgeHandle tour; // Копии ребра в эйлеровом обходе
+    };
+
+    int vertexCount;
+    int componentCount;
+    T totalWeight = T();
+    Forest tour;
+    std::vector<std::set<Candidate>> incident;  // Рёбра вне леса по вершинам
+    std::vector<EdgeRecord> edges;
+    std::vector<int> freeEdges;
+    std::vector<int> forestEdges;
+    std::unordered_map<long long, int> edgeIds;
+
+    // Дерево связей и разрезов: узлы 0..n-1 — вершины, n + e — ребро леса e
+    std::vector<std::array<int, 2>> pathChild;
+    std::vector<int> pathParent;
+    std::vector<char> pathFlipped;
+    std::vector<int> pathHeaviest;  // Узел с самым тяжёлым ребром в splay-поддереве
+    std::vector<int> splayStack;
+
+    // Вставляет сначала рёбра остова forest, затем остальные рёбра графа
+    void insertGraph(const Graph<T>& graph, const ArraySequence<Edge>& forest) {
+        for (int i = 0; i < forest.getLength(); ++i) {
+            addEdge(std::get<0>(forest[i]), std::get<1>(forest[i]), std::get<2>(forest[i]));
+        }
+        for (Vertex u = 0; u < vertexCount; ++u) {
+            graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                if (u < v && !hasEdge(u, v)) addEdge(u, v, weight);
+            });
+        }
+    }
+
+    static int checkedCount(int vertexCount) {
+        if (vertexCount < 0) {
+            throw std::invalid_argument("Vertex count must be non-negative");
+        }
+        return vertexCount;
+    }
+
+    void checkVertex(Vertex vertex) const {
+        if (vertex < 0 || vertex >= vertexCount) {
+            throw std::out_of_range("Vertex is out of range");
+        }
+    }
+
+    static long long edgeKey(Vertex u, Vertex v) {
+        if (u > v) std::swap(u, v);
+        return (static_cast<long long>(u) << 32) | static_cast<unsigned>(v);
+    }
+
+    int findEdge(Vertex u, Vertex v) const {
+        checkVertex(u);
+        checkVertex(v);
+        auto found = u == v ? edgeIds.end() : edgeIds.find(edgeKey(u, v));
+        if (found == edgeIds.end()) {
+            throw std::invalid_argument("Edge not found");
+        }
+        return found->second;
+    }
+
+    int allocateEdge(Vertex u, Vertex v, T weight) {
+        int e;
+        if (freeEdges.empty()) {
+            e = int(edges.size());
+            edges.emplace_back();
+            growPathNodes();
+        } else {
+            e = freeEdges.back();
+            freeEdges.pop_back();
+        }
+        edges[e].u = u;
+        edges[e].v = v;
+        edges[e].weight = weight;
+        edges[e].tree = false;
+        return e;
+    }
+
+    // ---- Лес ----
+
+    void joinForest(int e) {
+        EdgeRecord& edge = edges[e];
+        edge.tree = true;
+        edge.tour = tour.link(edge.u, edge.v);
+        edge.forestSlot = int(forestEdges.size());
+        forestEdges.push_back(e);
+        totalWeight += edge.weight;
+
+        int node = vertexCount + e;
+        resetPathNode(node);
+        link(node, edge.u);
+        link(node, edge.v);
+    }
+
+    void leaveForest(int e) {
+        EdgeRecord& edge = edges[e];
+        edge.tree = false;
+        tour.cut(edge.tour);
+        int moved = forestEdges.back();
+        forestEdges[edge.forestSlot] = moved;
+        edges[moved].forestSlot = edge.forestSlot;
+        forestEdges.pop_back();
+        totalWeight -= edge.weight;
+
+        int node = vertexCount + e;
+        cut(node, edge.u);
+        cut(node, edge.v);
+    }
+
+    // ---- Рёбра вне леса ----
+
+    void attachCandidate(int e) {
+        Candidate candidate(edges[e].weight, e);
+        for (Vertex endpoint : {edges[e].u, edges[e].v}) {
+            std::set<Candidate>& set = incident[endpoint];
+            auto inserted = set.insert(candidate).first;
+            if (inserted == set.begin()) tour.setValue(endpoint, candidate);
+        }
+    }
+
+    void detachCandidate(int e) {
+        Candidate candidate(edges[e].weight, e);
+        for (Vertex endpoint : {edges[e].u, edges[e].v}) {
+            std::set<Candidate>& set = incident[endpoint];
+            bool lightest = *set.begin() == candidate;
+            set.erase(candidate);
+            if (lightest) tour.setValue(endpoint, set.empty() ? NO_CANDIDATE : *set.begin());
+        }
+    }
+
+    // Самое лёгкое ребро вне леса между деревьями u и v (после разреза), либо -1
+    int lightestCrossing(Vertex u, Vertex v) {
+        Vertex smaller = tour.treeSize(u) <= tour.treeSize(v) ? u : v;
+        std::vector<int> inside;
+        int found = -1;
+        while (true) {
+            int e = tour.treeValue(smaller).second;
+            if (e == NO_CANDIDATE.second) break;
+            if (!tour.connected(edges[e].u, edges[e].v)) {
+                found = e;
+                break;
+            }
+            // Оба конца в меньшей половине: ребро откладывается до конца поиска
+            detachCandidate(e);
+            inside.push_back(e);
+        }
+        for (int e : inside) {
+            attachCandidate(e);
+        }
+        return found;
+    }
+
+    // ---- Дерево связей и разрезов ----
+
+    void growPathNodes() {
+        int size = vertexCount + int(edges.size());
+        while (int(pathParent.size()) < size) {
+            int node = int(pathParent.size());
+            pathChild.push_back({-1, -1});
+            pathParent.push_back(-1);
+            pathFlipped.push_back(0);
+            pathHeaviest.push_back(node);
+        }
+    }
+
+    void resetPathNode(int node) {
+        pathChild[node] = {-1, -1};
+        pathParent[node] = -1;
+        pathFlipped[node] = 0;
+        pathHeaviest[node] = node;
+    }
+
+    // Вес узла a больше веса узла b; у вершин веса нет
+    bool heavier(int a, int b) const {
+        if (a < vertexCount) return false;
+        if (b < vertexCount) return true;
+        const EdgeRecord& first = edges[a - vertexCount];
+        const EdgeRecord& second = edges[b - vertexCount];
+        return second.weight < first.weight || (!(first.weight < second.weight) && a > b);
+    }
+
+    bool isSplayRoot(int node) const {
+        int parent = pathParent[node];
+        return parent == -1 || (pathChild[parent][0] != node && pathChild[parent][1] != node);
+    }
+
+    void update(int node) {
+        int heaviest = node;
+        for (int child : pathChild[node]) {
+            if (child != -1 && heavier(pathHeaviest[child], heaviest)) heaviest = pathHeaviest[child];
+        }
+        pathHeaviest[node] = heaviest;
+    }
+
+    void flip(int node) {
+        std::swap(pathChild[node][0], pathChild[node][1]);
+        pathFlipped[node] ^= 1;
+    }
+
+    void pushDown(int node) {
+        if (!pathFlipped[node]) return;
+        for (int child : pathChild[node]) {
+            if (child != -1) flip(child);
+        }
+        pathFlipped[node] = 0;
+    }
+
+    void rotate(int node) {
+        int parent = pathParent[node];
+        int grandparent = pathParent[parent];
+        int side = pathChild[parent][1] == node;
+        if (!isSplayRoot(parent)) {
+            pathChild[grandparent][pathChild[grandparent][1] == parent] = node;
+        }
+        pathParent[node] = grandparent;
+        int moved = pathChild[node][!side];
+        pathChild[parent][side] = moved;
+        if (moved != -1) pathParent[moved] = parent;
+        pathChild[node][!side] = parent;
+        pathParent[parent] = node;
+        update(parent);
+        update(node);
+    }
+
+    void splay(int node) {
+        splayStack.clear();
+        for (int current = node;; current = pathParent[current]) {
+            splayStack.push_back(current);
+            if (isSplayRoot(current)) break;
+        }
+        for (auto it = splayStack.rbegin(); it != splayStack.rend(); ++it) {
+            pushDown(*it);
+        }
+        while (!isSplayRoot(node)) {
+            int parent = pathParent[node];
+            if (!isSplayRoot(parent)) {
+                int grandparent = pathParent[parent];
+                bool zigZig = (pathChild[parent][0] == node) == (pathChild[grandparent][0] == parent);
+                rotate(zigZig ? parent : node);
+            }
+            rotate(node);
+        }
+    }
+
+    // Делает путь от корня дерева до node предпочтительным; node становится корнем своего splay-дерева
+    void access(int node) {
+        int last = -1;
+        for (int current = node; current != -1; current = pathParent[current]) {
+            splay(current);
+            pathChild[current][1] = last;
+            update(current);
+            last = current;
+        }
+        splay(node);
+    }
+
+    void makeRoot(int node) {
+        access(node);
+        flip(node);
+    }
+
+    void link(int node, int parent) {
+        makeRoot(node);
+        pathParent[node] = parent;
+    }
+
+    // Узлы соседние в дереве: после makeRoot(a) и access(b) путь состоит ровно из a и b
+    void cut(int a, int b) {
+        makeRoot(a);
+        access(b);
+        pathChild[b][0] = -1;
+        pathParent[a] = -1;
+        update(b);
+    }
+
+    // Самое тяжёлое ребро леса на пути u–v (вершины связаны)
+    int heaviestOnPath(Vertex u, Vertex v) {
+        makeRoot(u);
+        access(v);
+        return pathHeaviest[v] - vertexCount;
+    }
+};
+
+/**
+ * @brief Неориентированный граф, поддерживающий минимальный остовный лес при каждом изменении.
+ *
+ * Методы addEdge, removeEdge и updateEdgeWeight изменяют граф и сразу обновляют
+ * `DynamicMinimumSpanningTree`, поэтому остов и его вес доступны без повторного запуска
+ * `MinimumSpanningTree::kruskal`.
+ *
+ * @tparam T Тип веса рёбер (арифметический).
+ */
+template<class T>
+class MinimumSpanningTrackingGraph : public UndirectedGraph<T> {
+private:
+    DynamicMinimumSpanningTree<T> spanningTree;
+
+public:
+    explicit MinimumSpanningTrackingGraph(int vertices) : UndirectedGraph<T>(vertices), spanningTree(vertices) {}
+
+    /**
+     * @brief Добавляет ребро и обновляет остов.
+     *
+     * @throws std::out_of_range Если индексы вершин выходят за допустимый диапазон.
+     */
+    void addEdge(int from, int to, T weight) override {
+        UndirectedGraph<T>::addEdge(from, to, weight);
+        spanningTree.addEdge(from, to, weight);
+    }
+
+    /**
+     * @brief Удаляет ребро и обновляет остов.
+     *
+     * @throws std::invalid_argument Если ребро не найдено между вершинами.
+     */
+    void removeEdge(int from, int to) override {
+        UndirectedGraph<T>::removeEdge(from, to);
+        spanningTree.removeEdge(from, to);
+    }
+
+    /**
+     * @brief Меняет вес существующего ребра и обновляет остов.
+     *
+     * @throws std::invalid_argument Если ребро не найдено между вершинами.
+     */
+    void updateEdgeWeight(int from, int to, T weight) {
+        UndirectedGraph<T>::removeEdge(from, to);
+        UndirectedGraph<T>::addEdge(from, to, weight);
+        spanningTree.updateWeight(from, to, weight);
+    }
+
+    const DynamicMinimumSpanningTree<T>& getSpanningTree() const {
+        return spanningTree;
+    }
+};
+
+#endif //DYNAMIC_MINIMUM_SPANNING_TREE_H
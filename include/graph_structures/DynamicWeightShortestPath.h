@@ -2,20 +2,25 @@
 #define DYNAMIC_WEIGHT_SHORTEST_PATH_H
 
 #include "Graph.h"
+#include "ShortestPath.h"
 #include "../sequence/ArraySequence.h"
 #include "../sequence/PriorityQueue.h"
+#include "../sequence/IndexedPriorityQueue.h"
 #include "../sequence/Pair.h"
 #include <limits>
 #include <functional>
 #include <stdexcept>
 #include <chrono>
 #include <random>
+#include <tuple>
 
 /**
  * @brief Класс для поиска кратчайших путей в графе с динамическими весами ребер с помощью алгоритма Дейкстры.
  *
  * Класс `DynamicWeightShortestPath` предоставляет методы для выполнения алгоритма Дейкстры
  * с динамическим изменением весов рёбер в зависимости от времени выполнения алгоритма.
+ * Для маршрутов, зависящих от времени отправления, а не от скорости работы программы,
+ * предназначены `TimeDependentGraph` и `TimeDependentShortestPath`.
  */
 template <typename T>
 class DynamicWeightShortestPath {
@@ -45,6 +50,24 @@ public:
         static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
     }
 
+    /**
+     * @brief Конструктор с фиксированным зерном генератора случайных вариаций.
+     *
+     * Случайная составляющая весов воспроизводима; временная составляющая по-прежнему
+     * зависит от длительности поиска. Полностью детерминированная модель — `WeightUpdateModel`.
+     *
+     * @param factor Фактор влияния времени на изменение весов.
+     * @param seed Зерно генератора случайных чисел.
+     */
+    DynamicWeightShortestPath(double factor, unsigned seed)
+            : startTime(Clock::now())
+            , timeInfluenceFactor(factor)
+            , rng(seed)
+            , dist(-0.1, 0.1)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+    }
+
     /**
      * @brief Обновляет вес ребра в зависимости от времени выполнения алгоритма.
      *
@@ -69,11 +92,13 @@ public:
      *
      * @param graph Ссылка на граф, в котором выполняется поиск.
      * @param source Исходная вершина (источник).
+     * @param queue Реализация очереди с приоритетом (по умолчанию индексированная куча).
      * @return ArraySequence<Pair<T, Vertex>> Последовательность пар, где каждая пара содержит расстояние от источника и предшествующую вершину для каждой вершины графа.
      *
      * @throws std::out_of_range Если исходная вершина находится вне допустимого диапазона.
      */
-    ArraySequence<Pair<T, Vertex>> dijkstra(const Graph<T>& graph, Vertex source) {
+    ArraySequence<Pair<T, Vertex>> dijkstra(const Graph<T>& graph, Vertex source,
+                                            DijkstraQueue queue = DijkstraQueue::INDEXED_HEAP) {
         int n = graph.getVertexCount();
         if (source < 0 || source >= n) {
             throw std::out_of_range("Source vertex is out of range");
@@ -89,32 +114,55 @@ public:
         }
         distances[source] = T(0);
 
-        PriorityQueue<Vertex, T> pq; /**< Приоритетная очередь для выбора вершины с минимальным расстоянием. */
-        pq.Enqueue(source, T(0));
+        // Релаксация ребра u -> v с пересчитанным весом; возвращает true, если расстояние до v уменьшилось
+        auto relax = [&](Vertex u, Vertex v, const T& originalWeight) -> bool {
+            // Обновляем вес на основе времени
+            T weight = updateWeight(originalWeight);
 
-        while (!pq.isEmpty()) {
-            auto current = pq.Dequeue();
-            Vertex u = current.first;
-            T dist_u = current.second;
+            if (distances[u] != MAX_VALUE &&
+                weight != MAX_VALUE &&
+                distances[u] + weight < distances[v]) {
 
-            if (dist_u > distances[u]) continue;
+                distances[v] = distances[u] + weight;
+                predecessors[v] = u;
+                return true;
+            }
+            return false;
+        };
 
-            auto neighbors = graph.getNeighbors(u);
-            for (int i = 0; i < neighbors.getLength(); ++i) {
-                Vertex v = neighbors[i].first;
-                T originalWeight = neighbors[i].second;
+        if (queue == DijkstraQueue::AVL_TREE) {
+            PriorityQueue<Vertex, T> pq; /**< Приоритетная очередь для выбора вершины с минимальным расстоянием. */
+            pq.Enqueue(source, T(0));
 
-                // Обновляем вес на основе времени
-                T weight = updateWeight(originalWeight);
+            while (!pq.isEmpty()) {
+                auto current = pq.Dequeue();
+                Vertex u = current.first;
+                T dist_u = current.second;
+
+                if (dist_u > distances[u]) continue;
+
+                graph.forEachNeighbor(u, [&](Vertex v, const T& originalWeight) {
+                    if (relax(u, v, originalWeight)) {
+                        pq.Enqueue(v, distances[v]);
+                    }
+                });
+            }
+        } else {
+            IndexedPriorityQueue<T> heap(n); /**< Индексированная куча с уменьшением ключа. */
+            heap.Enqueue(source, T(0));
 
-                if (distances[u] != MAX_VALUE &&
-                    weight != MAX_VALUE &&
-                    distances[u] + weight < distances[v]) {
+            while (!heap.isEmpty()) {
+                Vertex u = heap.Dequeue().first;
 
-                    distances[v] = distances[u] + weight;
-                    predecessors[v] = u;
-                    pq.Enqueue(v, distances[v]);
-                }
+                graph.forEachNeighbor(u, [&](Vertex v, const T& originalWeight) {
+                    if (relax(u, v, originalWeight)) {
+                        if (heap.contains(v)) {
+                            heap.decreaseKey(v, distances[v]);
+                        } else {
+                            heap.Enqueue(v, distances[v]);
+                        }
+                    }
+                });
             }
         }
 
@@ -178,4 +226,115 @@ public:
     }
 };
 
+/**
+ * @brief Детерминированная модель изменения весов рёбер (поток обновлений дорожного трафика).
+ *
+ * Модель повторяет формулу `DynamicWeightShortestPath::updateWeight`, но вместо реального
+ * времени использует номер шага: на шаге t вес ребра равен
+ * w0 * (1 + factor * t) * (1 + U(-variation, variation)), где w0 — исходный вес; значение,
+ * не помещающееся в T, заменяется ближайшим представимым (`std::numeric_limits<T>::max()`
+ * при неограниченном росте). Каждый вызов `nextBatch` выбирает заданное число случайных
+ * рёбер и назначает им веса следующего шага. Последовательность пакетов полностью
+ * определяется зерном, поэтому результаты воспроизводимы; пакеты подаются, например,
+ * в `IncrementalShortestPath::updateEdges`.
+ *
+ * Если `getEdges` графа перечисляет каждое ребро один раз, хотя дуг вдвое больше
+ * (неориентированный граф), каждое выбранное ребро даёт два обновления с одним весом —
+ * (u, v, w) и (v, u, w), — чтобы веса направлений не расходились.
+ *
+ * @tparam T Тип веса рёбер.
+ */
+template <typename T>
+class WeightUpdateModel {
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+    typedef std::tuple<Vertex, Vertex, T> EdgeUpdate; /**< Ребро (from, to) и его новый вес. */
+
+private:
+    ArraySequence<EdgeUpdate> baseEdges; /**< Рёбра графа с исходными весами. */
+    bool symmetric;                      /**< Обновлять ли оба направления ребра. */
+    double timeInfluenceFactor;          /**< Относительный рост веса за шаг. */
+    std::mt19937_64 rng;
+    std::uniform_real_distribution<double> variation;
+    long long step = 0;
+
+public:
+    /**
+     * @brief Создаёт модель для рёбер графа.
+     *
+     * @param graph Граф, исходные веса которого служат базой.
+     * @param seed Зерно генератора.
+     * @param factor Относительный рост веса за шаг.
+     * @param maxVariation Максимальное относительное случайное отклонение (от 0 до 1).
+     *
+     * @throws std::invalid_argument Если параметры отрицательны или отклонение не меньше 1.
+     */
+    WeightUpdateModel(const Graph<T>& graph, unsigned long long seed, double factor = 0.1, double maxVariation = 0.1)
+            : baseEdges(graph.getEdges())
+            , symmetric(false)
+            , timeInfluenceFactor(factor)
+            , rng(seed)
+            , variation(-maxVariation, maxVariation)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+        if (factor < 0 || maxVariation < 0 || maxVariation >= 1) {
+            throw std::invalid_argument("Invalid weight update model parameters");
+        }
+        long long arcs = 0;
+        for (Vertex v = 0; v < graph.getVertexCount(); ++v) {
+            arcs += graph.getDegree(v);
+        }
+        symmetric = baseEdges.getLength() < arcs;
+    }
+
+    /**
+     * @brief Выбирает count случайных рёбер и возвращает их веса на следующем шаге.
+     *
+     * Одно ребро может встретиться в пакете несколько раз; действует последнее значение.
+     * Для неориентированного графа пакет содержит 2 * count обновлений.
+     *
+     * @throws std::invalid_argument Если count отрицателен.
+     */
+    ArraySequence<EdgeUpdate> nextBatch(int count) {
+        if (count < 0) {
+            throw std::invalid_argument("Batch size must be non-negative");
+        }
+        ++step;
+        ArraySequence<EdgeUpdate> batch;
+        if (baseEdges.getLength() == 0) return batch;
+
+        std::uniform_int_distribution<int> pick(0, baseEdges.getLength() - 1);
+        double timeFactor = 1.0 + step * timeInfluenceFactor;
+        for (int i = 0; i < count; ++i) {
+            const EdgeUpdate& edge = baseEdges[pick(rng)];
+            double randomFactor = 1.0 + variation(rng);
+            T weight = saturate(std::get<2>(edge) * timeFactor * randomFactor);
+            batch.append(EdgeUpdate(std::get<0>(edge), std::get<1>(edge), weight));
+            if (symmetric) {
+                batch.append(EdgeUpdate(std::get<1>(edge), std::get<0>(edge), weight));
+            }
+        }
+        return batch;
+    }
+
+    /**
+     * @brief Номер последнего выданного шага (0 до первого вызова `nextBatch`).
+     */
+    long long getStep() const {
+        return step;
+    }
+
+private:
+    // Приведение к T без переполнения: double вне диапазона T ограничивается его границами
+    static T saturate(double weight) {
+        if (weight >= static_cast<double>(std::numeric_limits<T>::max())) {
+            return std::numeric_limits<T>::max();
+        }
+        if (weight <= static_cast<double>(std::numeric_limits<T>::lowest())) {
+            return std::numeric_limits<T>::lowest();
+        }
+        return static_cast<T>(weight);
+    }
+};
+
 #endif // DYNAMIC_WEIGHT_SHORTEST_PATH_H
\ No newline at end of file
@@ -0,0 +1,270 @@
+#ifndef EULER_TOUR_FOREST_H
+#define EULER_TOUR_FOREST_H
+
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Лес, каждое дерево которого хранится как эйлеров обход в декартовом дереве (treap).
+ *
+ * Обход дерева — последовательность, в которой каждая вершина встречается один раз,
+ * а каждое ребро — двумя направленными копиями. Последовательность хранится в декартовом
+ * дереве с неявным ключом, поэтому связывание и разрезание деревьев, проверка связности
+ * и размер дерева стоят O(log n) в среднем.
+ *
+ * Каждой вершине можно назначить значение; для дерева поддерживается их свёртка операцией
+ * Combine (ассоциативной и коммутативной, identity — её нейтральный элемент), а также
+ * поиск вершины, значение которой удовлетворяет условию.
+ *
+ * @tparam Value Тип значения вершины.
+ * @tparam Combine Функциональный объект Value(Value, Value).
+ */
+template<typename Value, typename Combine>
+class EulerTourForest {
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины. */
+
+    /**
+     * @brief Копии ребра в обходе; возвращаются из link и передаются в cut.
+     */
+    struct EdgeHandle {
+        int forward = -1;
+        int backward = -1;
+    };
+
+    /**
+     * @brief Лес из vertexCount изолированных вершин со значением identity.
+     */
+    explicit EulerTourForest(int vertexCount, Value identity = Value(), unsigned seed = 1)
+            : identity(identity), random(seed) {
+        vertexNode.resize(vertexCount);
+        for (Vertex v = 0; v < vertexCount; ++v) {
+            vertexNode[v] = allocateNode(v);
+        }
+    }
+
+    int getVertexCount() const {
+        return int(vertexNode.size());
+    }
+
+    bool connected(Vertex u, Vertex v) const {
+        return rootOf(vertexNode[u]) == rootOf(vertexNode[v]);
+    }
+
+    /**
+     * @brief Представитель дерева вершины; меняется при link и cut.
+     */
+    int treeOf(Vertex vertex) const {
+        return rootOf(vertexNode[vertex]);
+    }
+
+    /**
+     * @brief Число вершин в дереве вершины.
+     */
+    int treeSize(Vertex vertex) const {
+        return nodes[rootOf(vertexNode[vertex])].vertices;
+    }
+
+    /**
+     * @brief Свёртка значений всех вершин дерева.
+     */
+    const Value& treeValue(Vertex vertex) const {
+        return nodes[rootOf(vertexNode[vertex])].total;
+    }
+
+    const Value& getValue(Vertex vertex) const {
+        return nodes[vertexNode[vertex]].own;
+    }
+
+    void setValue(Vertex vertex, const Value& value) {
+        int node = vertexNode[vertex];
+        nodes[node].own = value;
+        for (; node != -1; node = nodes[node].parent) {
+            pull(node);
+        }
+    }
+
+    /**
+     * @brief Вершина дерева vertex, значение которой удовлетворяет matches, либо -1.
+     *
+     * Условие проверяется и для свёрток поддеревьев и должно быть монотонным: если оно
+     * выполнено для значения одной из вершин, то выполнено и для свёртки, содержащей его.
+     */
+    template<class Matches>
+    Vertex findVertex(Vertex vertex, Matches matches) const {
+        int node = rootOf(vertexNode[vertex]);
+        if (!matches(nodes[node].total)) return -1;
+        while (true) {
+            int left = nodes[node].left;
+            if (left != -1 && matches(nodes[left].total)) {
+                node = left;
+            } else if (nodes[node].vertex != -1 && matches(nodes[node].own)) {
+                return nodes[node].vertex;
+            } else {
+                node = nodes[node].right;
+            }
+        }
+    }
+
+    /**
+     * @brief Соединяет деревья вершин u и v ребром; вершины должны быть в разных деревьях.
+     *
+     * Обход нового дерева: обход(u), u->v, обход(v), v->u.
+     */
+    EdgeHandle link(Vertex u, Vertex v) {
+        EdgeHandle edge;
+        edge.forward = allocateNode(-1);
+        edge.backward = allocateNode(-1);
+        int first = reroot(u);
+        int second = reroot(v);
+        int root = merge(merge(merge(first, edge.forward), second), edge.backward);
+        nodes[root].parent = -1;
+        return edge;
+    }
+
+    /**
+     * @brief Удаляет ребро дерева: обход L, u->v, M, v->u, R распадается на M и L + R.
+     */
+    void cut(const EdgeHandle& edge) {
+        int root = rootOf(edge.forward);
+        int first = indexOf(edge.forward);
+        int second = indexOf(edge.backward);
+        if (first > second) std::swap(first, second);
+
+        auto head = split(root, first);
+        auto middle = split(split(head.second, 1).second, second - first - 1);
+        int tail = split(middle.second, 1).second;
+        int rest = merge(head.first, tail);
+        if (rest != -1) nodes[rest].parent = -1;
+
+        freeNodes.push_back(edge.forward);
+        freeNodes.push_back(edge.backward);
+    }
+
+private:
+    struct TourNode {
+        int left = -1;
+        int right = -1;
+        int parent = -1;
+        unsigned priority = 0;
+        int size = 1;      // Элементов в поддереве
+        int vertices = 0;  // Вершин в поддереве
+        Vertex vertex = -1;
+        Value own;
+        Value total;
+    };
+
+    Value identity;
+    Combine combine;
+    std::mt19937 random;
+    std::vector<TourNode> nodes;
+    std::vector<int> freeNodes;
+    std::vector<int> vertexNode;
+
+    int allocateNode(Vertex vertex) {
+        int node;
+        if (freeNodes.empty()) {
+            node = int(nodes.size());
+            nodes.emplace_back();
+        } else {
+            node = freeNodes.back();
+            freeNodes.pop_back();
+            nodes[node] = TourNode();
+        }
+        nodes[node].priority = random();
+        nodes[node].vertex = vertex;
+        nodes[node].vertices = vertex == -1 ? 0 : 1;
+        nodes[node].own = identity;
+        nodes[node].total = identity;
+        return node;
+    }
+
+    int sizeOf(int node) const {
+        return node == -1 ? 0 : nodes[node].size;
+    }
+
+    void pull(int node) {
+        TourNode& current = nodes[node];
+        current.size = 1;
+        current.vertices = current.vertex == -1 ? 0 : 1;
+        current.total = current.own;
+        for (int child : {current.left, current.right}) {
+            if (child == -1) continue;
+            current.size += nodes[child].size;
+            current.vertices += nodes[child].vertices;
+            current.total = combine(current.total, nodes[child].total);
+        }
+    }
+
+    int merge(int a, int b) {
+        if (a == -1) return b;
+        if (b == -1) return a;
+        if (nodes[a].priority > nodes[b].priority) {
+            int right = merge(nodes[a].right, b);
+            nodes[a].right = right;
+            nodes[right].parent = a;
+            pull(a);
+            return a;
+        }
+        int left = merge(a, nodes[b].left);
+        nodes[b].left = left;
+        nodes[left].parent = b;
+        pull(b);
+        return b;
+    }
+
+    // Первые count элементов обхода и остаток; корни обеих частей получают parent = -1
+    std::pair<int, int> split(int root, int count) {
+        auto parts = splitNodes(root, count);
+        if (parts.first != -1) nodes[parts.first].parent = -1;
+        if (parts.second != -1) nodes[parts.second].parent = -1;
+        return parts;
+    }
+
+    std::pair<int, int> splitNodes(int node, int count) {
+        if (node == -1) return {-1, -1};
+        int left = nodes[node].left;
+        if (sizeOf(left) >= count) {
+            auto parts = splitNodes(left, count);
+            nodes[node].left = parts.second;
+            if (parts.second != -1) nodes[parts.second].parent = node;
+            pull(node);
+            return {parts.first, node};
+        }
+        auto parts = splitNodes(nodes[node].right, count - sizeOf(left) - 1);
+        nodes[node].right = parts.first;
+        if (parts.first != -1) nodes[parts.first].parent = node;
+        pull(node);
+        return {node, parts.second};
+    }
+
+    int rootOf(int node) const {
+        while (nodes[node].parent != -1) {
+            node = nodes[node].parent;
+        }
+        return node;
+    }
+
+    int indexOf(int node) const {
+        int index = sizeOf(nodes[node].left);
+        for (int parent = nodes[node].parent; parent != -1; node = parent, parent = nodes[node].parent) {
+            if (nodes[parent].right == node) index += sizeOf(nodes[parent].left) + 1;
+        }
+        return index;
+    }
+
+    // Циклически сдвигает обход так, чтобы он начинался с вершины; возвращает корень
+    int reroot(Vertex vertex) {
+        int node = vertexNode[vertex];
+        int index = indexOf(node);
+        int root = rootOf(node);
+        if (index == 0) return root;
+        auto parts = split(root, index);
+        int merged = merge(parts.second, parts.first);
+        nodes[merged].parent = -1;
+        return merged;
+    }
+};
+
+#endif //EULER_TOUR_FOREST_H
@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <type_traits>
 #include "../sequence/ArraySequence.h"
 #include "../sequence/Pair.h"
 #include "../data_structures/IDictionaryBinaryTree.h"
@@ -10,6 +11,11 @@
 template<class T>
 class Graph {
 public:
+    // Посетитель рёбер, исходящих из вершины (см. visitNeighbors)
+    struct NeighborVisitor {
+        virtual void apply(int neighbor, const T &weight) = 0;
+    };
+
     virtual ~Graph() = default;
 
     virtual void addEdge(int from, int to, T weight) = 0;
@@ -17,11 +23,28 @@ public:
     virtual bool hasEdge(int from, int to) const = 0;
     virtual int getDegree(int vertex) const = 0;
     virtual ArraySequence<Pair<int, T>> getNeighbors(int vertex) const = 0;
+    // Обходит соседей вершины прямо по внутреннему хранилищу, без копирования и выделения памяти
+    virtual void visitNeighbors(int vertex, NeighborVisitor &visitor) const = 0;
     virtual T getEdgeWeight(int from, int to) const = 0;
     virtual void printGraph() const = 0;
     virtual int getVertexCount() const = 0;
     virtual void dfs(int startVertex, ArraySequence<bool>& visited, std::function<void(int)> visit) const = 0;
     virtual ArraySequence<std::tuple<int, int, T>> getEdges() const = 0;
+
+    // Вызывает func(neighbor, weight) для каждого соседа вершины; обёртка над visitNeighbors для лямбд
+    template<class Func>
+    void forEachNeighbor(int vertex, Func &&func) const {
+        struct Adapter : NeighborVisitor {
+            std::remove_reference_t<Func> &func;
+
+            explicit Adapter(std::remove_reference_t<Func> &f) : func(f) {}
+
+            void apply(int neighbor, const T &weight) override {
+                func(neighbor, weight);
+            }
+        } adapter(func);
+        visitNeighbors(vertex, adapter);
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,20 +2,51 @@
 #define GRAPH_COLORING_H
 
 #include "Graph.h"
+#include "CSRGraph.h"
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
 #include <stdexcept>
+#include <vector>
+#include "../data_structures/ThreadPool.h"
 #include "../sequence/ArraySequence.h"
+#include "../sequence/DynamicArray.h"
+#include "../sequence/IndexedPriorityQueue.h"
 #include "../sequence/Pair.h"
 
 /**
  * @brief Класс для раскраски графа.
  *
- * Класс `GraphColoring` предоставляет метод для выполнения жадной раскраски графа.
- * Жадный алгоритм раскраски назначает минимальное возможное число цветов вершинам графа
- * таким образом, чтобы никакие две смежные вершины не имели одинакового цвета.
+ * Класс `GraphColoring` предоставляет жадные алгоритмы раскраски графа: вершины
+ * перебираются в заданном порядке, и каждая получает наименьший цвет, не занятый её
+ * соседями, так что никакие две смежные вершины не имеют одинакового цвета.
+ *
+ * Порядок перебора заметно влияет на число цветов:
+ * - `NATURAL` — по возрастанию номеров;
+ * - `LARGEST_FIRST` — по убыванию степени (Уэлш–Пауэлл);
+ * - `SMALLEST_LAST` — порядок вырождения (Матула–Бек): вершина наименьшей степени
+ *   удаляется последней раскрашиваемой, что гарантирует не больше degeneracy + 1 цветов;
+ * - `dsatur` — порядок, выбираемый по ходу раскраски (Брелаз).
+ *
+ * Вершина степени d всегда получает цвет не больше d, поэтому занятые цвета собираются
+ * в битовый набор из (максимальная степень + 1) бит, который создаётся один раз и очищается
+ * только в пределах степени текущей вершины. Граф читается в формате CSR.
+ *
+ * `speculativeColoring` раскрашивает граф в несколько потоков, `isValidColoring` проверяет
+ * результат любой из раскрасок.
  */
 class GraphColoring {
 public:
+    /**
+     * @brief Порядок перебора вершин жадной раскраски.
+     */
+    enum Ordering {
+        NATURAL,       /**< По возрастанию номеров вершин. */
+        LARGEST_FIRST, /**< По убыванию степени (Уэлш–Пауэлл). */
+        SMALLEST_LAST  /**< Порядок вырождения (Матула–Бек). */
+    };
+
     /**
      * @brief Выполняет жадную раскраску графа.
      *
@@ -23,61 +54,349 @@ public:
      * Приоритет цвета отдается порядку следования вершин.
      *
      * @tparam T Тип веса рёбер графа.
-     * @param graph Граф, который необходимо раскрасить.
+     * @param graph Граф, который необходимо раскрасить (копируется в формат CSR).
+     * @param ordering Порядок перебора вершин.
      * @return ArraySequence<int> Последовательность цветов для каждой вершины графа,
      *                           где индекс соответствует номеру вершины, а значение — цвету.
+     */
+    template<typename T>
+    static ArraySequence<int> greedyColoring(const Graph<T>& graph, Ordering ordering = NATURAL) {
+        return greedyColoring(CSRGraph<T>(graph, true), ordering);
+    }
+
+    /**
+     * @brief Жадная раскраска замороженного графа без его копирования.
+     */
+    template<typename T>
+    static ArraySequence<int> greedyColoring(const CSRGraph<T>& graph, Ordering ordering = NATURAL) {
+        return colorInOrder(graph, vertexOrder(graph, ordering));
+    }
+
+    /**
+     * @brief Раскраска DSatur: следующей раскрашивается вершина с наибольшей насыщенностью.
      *
-     * @throws std::out_of_range Если индекс соседа выходит за пределы допустимого диапазона.
+     * Насыщенность вершины v — число различных цветов 0..deg(v) среди её раскрашенных соседей
+     * (старшие цвета не могут запретить v ни одного цвета); при равенстве выбирается вершина
+     * большей степени. Занятые цвета каждой вершины хранятся в собственном битовом наборе
+     * из deg(v) + 1 бит, все наборы лежат в одном массиве; очередь — индексированная куча.
+     *
+     * @return ArraySequence<int> Цвет каждой вершины.
      */
     template<typename T>
-    static ArraySequence<int> greedyColoring(const Graph<T>& graph) {
-        int n = graph.getVertexCount(); /**< Общее количество вершин в графе. */
-        ArraySequence<int> result(-1, n); /**< Массив для хранения цвета каждой вершины. Инициализируется значением -1 (неокрашенные). */
+    static ArraySequence<int> dsatur(const Graph<T>& graph) {
+        return dsatur(CSRGraph<T>(graph, true));
+    }
+
+    template<typename T>
+    static ArraySequence<int> dsatur(const CSRGraph<T>& graph) {
+        const int n = graph.getVertexCount();
+        ArraySequence<int> colors(-1, n);
+        if (n == 0) return colors;
 
-        // Если граф пустой, возвращаем массив без изменений
-        if (n == 0) {
-            return result;
+        DynamicArray<int> wordOffset(n + 1);
+        int maxDegree = 0;
+        for (int v = 0; v < n; ++v) {
+            int degree = graph.rowEnd(v) - graph.rowBegin(v);
+            maxDegree = std::max(maxDegree, degree);
+            wordOffset[v + 1] = wordOffset[v] + degree / WORD_BITS + 1;
         }
+        DynamicArray<unsigned long long> used(0ULL, wordOffset[n]);
+        DynamicArray<int> saturation(0, n);
+        const long long scale = maxDegree + 1;
 
-        result[0] = 0; /**< Присваиваем первый цвет первой вершине. */
+        IndexedPriorityQueue<long long> queue(n);
+        for (int v = 0; v < n; ++v) {
+            queue.Enqueue(v, -(long long) (graph.rowEnd(v) - graph.rowBegin(v)));
+        }
+        while (!queue.isEmpty()) {
+            int u = queue.Dequeue().first;
+            int color = 0;
+            for (int w = wordOffset[u]; used[w] == ~0ULL; ++w) {
+                color += WORD_BITS;
+            }
+            color += std::countr_one(used[wordOffset[u] + color / WORD_BITS]);
+            colors[u] = color;
 
-        /**
-         * @brief Основной цикл раскраски.
-         *
-         * Присваиваем каждой вершине наименьший доступный цвет, который не используется
-         * её смежными вершинами.
-         */
-        for (int u = 1; u < n; ++u) {
-            ArraySequence<bool> available(true, n); /**< Массив доступных цветов. Изначально все цвета доступны. */
+            for (int e = graph.rowBegin(u); e < graph.rowEnd(u); ++e) {
+                int v = graph.getTarget(e);
+                int degree = graph.rowEnd(v) - graph.rowBegin(v);
+                if (colors[v] != -1 || color > degree) continue;
+                unsigned long long& word = used[wordOffset[v] + color / WORD_BITS];
+                unsigned long long bit = 1ULL << (color % WORD_BITS);
+                if (word & bit) continue;
+                word |= bit;
+                ++saturation[v];
+                queue.decreaseKey(v, -(saturation[v] * scale + degree));
+            }
+        }
+        return colors;
+    }
 
-            ArraySequence<Pair<int, T>> neighbors = graph.getNeighbors(u); /**< Список соседей текущей вершины. */
+    /**
+     * @brief Параллельная спекулятивная раскраска (Гебремедхин–Манне).
+     *
+     * Вершины очереди раскрашиваются в несколько потоков блоками по PARALLEL_GRAIN, каждая —
+     * наименьшим цветом, не занятым соседями на момент чтения. Соседи из одновременно
+     * обрабатываемых блоков могут получить один цвет; после раунда такие конфликты ищутся
+     * параллельно, и из каждой конфликтной пары в очередь следующего раунда попадает вершина
+     * с большим номером. Вершина с меньшим номером цвет сохраняет, поэтому очередь строго
+     * уменьшается, а конфликтов обычно мало по сравнению с числом вершин.
+     *
+     * @param graph Граф в формате CSR (симметричный для неориентированного графа).
+     * @param pool Пул потоков; метод нельзя вызывать из задачи этого же пула.
+     * @param ordering Порядок вершин в первой очереди.
+     * @return ArraySequence<int> Цвет каждой вершины.
+     */
+    template<typename T>
+    static ArraySequence<int> speculativeColoring(const CSRGraph<T>& graph, ThreadPool& pool,
+                                                  Ordering ordering = NATURAL) {
+        const int n = graph.getVertexCount();
+        std::unique_ptr<std::atomic<int>[]> colors(new std::atomic<int>[n]);
+        for (int v = 0; v < n; ++v) {
+            colors[v].store(-1, std::memory_order_relaxed);
+        }
+        auto colorOf = [&colors](int v) { return colors[v].load(std::memory_order_relaxed); };
 
-            // Проходим по всем соседям текущей вершины
-            for (int i = 0; i < neighbors.getLength(); ++i) {
-                int neighbor = neighbors[i].first; /**< Индекс соседней вершины. */
+        DynamicArray<int> order = vertexOrder(graph, ordering);
+        std::vector<int> queue(order.getSize());
+        for (int i = 0; i < order.getSize(); ++i) {
+            queue[i] = order[i];
+        }
+        std::vector<ColorScratch> scratch(pool.getThreadCount(), ColorScratch(maxDegree(graph)));
+        std::vector<std::vector<int>> conflicts(pool.getThreadCount());
 
-                // Проверка валидности индекса соседа
-                if (neighbor < 0 || neighbor >= n) {
-                    throw std::out_of_range("Neighbor index out of range");
+        while (!queue.empty()) {
+            const int count = int(queue.size());
+            pool.parallelFor(count, PARALLEL_GRAIN, [&](int i, unsigned worker) {
+                int u = queue[i];
+                colors[u].store(scratch[worker].smallestFree(graph, u, colorOf), std::memory_order_relaxed);
+            });
+            pool.parallelFor(count, PARALLEL_GRAIN, [&](int i, unsigned worker) {
+                int u = queue[i];
+                int color = colorOf(u);
+                for (int e = graph.rowBegin(u); e < graph.rowEnd(u); ++e) {
+                    int v = graph.getTarget(e);
+                    if (v < u && colorOf(v) == color) {
+                        conflicts[worker].push_back(u);
+                        return;
+                    }
                 }
+            });
+            queue.clear();
+            for (std::vector<int>& found : conflicts) {
+                queue.insert(queue.end(), found.begin(), found.end());
+                found.clear();
+            }
+        }
 
-                // Если сосед уже раскрашен, помечаем его цвет как недоступный
-                if (result[neighbor] != -1) {
-                    available[result[neighbor]] = false;
-                }
+        ArraySequence<int> result(-1, n);
+        for (int v = 0; v < n; ++v) {
+            result[v] = colorOf(v);
+        }
+        return result;
+    }
+
+    template<typename T>
+    static ArraySequence<int> speculativeColoring(const Graph<T>& graph, ThreadPool& pool,
+                                                  Ordering ordering = NATURAL) {
+        return speculativeColoring(CSRGraph<T>(graph, true), pool, ordering);
+    }
+
+    /**
+     * @brief Проверяет, что раскраска правильная.
+     *
+     * @return true, если цвет задан каждой вершине (не меньше 0) и концы каждого ребра,
+     *         кроме петель, раскрашены по-разному.
+     */
+    template<typename T>
+    static bool isValidColoring(const CSRGraph<T>& graph, const ArraySequence<int>& colors) {
+        if (colors.getLength() != graph.getVertexCount()) return false;
+        for (int u = 0; u < graph.getVertexCount(); ++u) {
+            if (colors[u] < 0) return false;
+            for (int e = graph.rowBegin(u); e < graph.rowEnd(u); ++e) {
+                int v = graph.getTarget(e);
+                if (v != u && colors[v] == colors[u]) return false;
             }
+        }
+        return true;
+    }
 
-            // Находим первый доступный цвет
-            int color = 0;
-            while (color < n && !available[color]) {
-                ++color;
+    template<typename T>
+    static bool isValidColoring(const Graph<T>& graph, const ArraySequence<int>& colors) {
+        return isValidColoring(CSRGraph<T>(graph, true), colors);
+    }
+
+    /**
+     * @brief Порядок перебора вершин для жадной раскраски.
+     *
+     * @return DynamicArray<int> Перестановка вершин 0..n-1.
+     */
+    template<typename T>
+    static DynamicArray<int> vertexOrder(const CSRGraph<T>& graph, Ordering ordering) {
+        switch (ordering) {
+            case LARGEST_FIRST:
+                return largestFirstOrder(graph);
+            case SMALLEST_LAST:
+                return smallestLastOrder(graph);
+            case NATURAL:
+                break;
+        }
+        DynamicArray<int> order(graph.getVertexCount());
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            order[v] = v;
+        }
+        return order;
+    }
+
+    /**
+     * @brief Жадно раскрашивает вершины в заданном порядке.
+     *
+     * @param graph Граф в формате CSR.
+     * @param order Перестановка вершин.
+     * @return ArraySequence<int> Цвет каждой вершины.
+     *
+     * @throws std::invalid_argument Если длина order не равна числу вершин.
+     */
+    template<typename T>
+    static ArraySequence<int> colorInOrder(const CSRGraph<T>& graph, const DynamicArray<int>& order) {
+        const int n = graph.getVertexCount();
+        if (order.getSize() != n) {
+            throw std::invalid_argument("Order must list every vertex once");
+        }
+        ArraySequence<int> colors(-1, n);
+        ColorScratch scratch(maxDegree(graph));
+        for (int i = 0; i < n; ++i) {
+            int u = order[i];
+            colors[u] = scratch.smallestFree(graph, u, [&colors](int v) { return colors[v]; });
+        }
+        return colors;
+    }
+
+    /**
+     * @brief Число различных цветов раскраски (наибольший цвет + 1).
+     */
+    static int colorCount(const ArraySequence<int>& colors) {
+        int count = 0;
+        for (int i = 0; i < colors.getLength(); ++i) {
+            count = std::max(count, colors[i] + 1);
+        }
+        return count;
+    }
+
+private:
+    static constexpr int WORD_BITS = 64;
+    static constexpr int PARALLEL_GRAIN = 1024; // Вершин в одном блоке параллельной раскраски
+
+    /**
+     * Битовый набор цветов, занятых соседями одной вершины. Создаётся один раз на
+     * (максимальная степень + 1) бит и после каждой вершины очищается только в пределах
+     * её степени; параллельные раскраски держат по набору на поток.
+     */
+    class ColorScratch {
+    public:
+        explicit ColorScratch(int maxDegree) : words(maxDegree / WORD_BITS + 1, 0) {}
+
+        // Наименьший цвет, не занятый соседями u; colorOf(v) < 0 — сосед не раскрашен
+        template<typename T, class ColorOf>
+        int smallestFree(const CSRGraph<T>& graph, int u, ColorOf colorOf) {
+            const int limit = graph.rowEnd(u) - graph.rowBegin(u);
+            for (int e = graph.rowBegin(u); e < graph.rowEnd(u); ++e) {
+                int color = colorOf(graph.getTarget(e));
+                // Цвета больше степени u не мешают: хотя бы один цвет 0..limit свободен
+                if (color >= 0 && color <= limit) {
+                    words[color / WORD_BITS] |= 1ULL << (color % WORD_BITS);
+                }
+            }
+            int found = -1;
+            for (int w = 0; w <= limit / WORD_BITS; ++w) {
+                if (found == -1 && words[w] != ~0ULL) found = w * WORD_BITS + std::countr_one(words[w]);
+                words[w] = 0;
             }
+            return found;
+        }
+
+    private:
+        std::vector<unsigned long long> words;
+    };
+
+    template<typename T>
+    static int maxDegree(const CSRGraph<T>& graph) {
+        int result = 0;
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            result = std::max(result, graph.rowEnd(v) - graph.rowBegin(v));
+        }
+        return result;
+    }
+
+    // Сортировка подсчётом по убыванию степени; при равных степенях — по возрастанию номера
+    template<typename T>
+    static DynamicArray<int> largestFirstOrder(const CSRGraph<T>& graph) {
+        const int n = graph.getVertexCount();
+        const int top = maxDegree(graph);
+        DynamicArray<int> start(0, top + 2);
+        for (int v = 0; v < n; ++v) {
+            ++start[top - (graph.rowEnd(v) - graph.rowBegin(v)) + 1];
+        }
+        for (int d = 0; d <= top; ++d) {
+            start[d + 1] += start[d];
+        }
+        DynamicArray<int> order(n);
+        for (int v = 0; v < n; ++v) {
+            order[start[top - (graph.rowEnd(v) - graph.rowBegin(v))]++] = v;
+        }
+        return order;
+    }
 
-            result[u] = color; /**< Назначаем найденный цвет вершине u. */
+    // Порядок вырождения за O(n + m) (Батагель–Заверсник): вершины удаляются по возрастанию
+    // текущей степени и раскрашиваются в обратном порядке
+    template<typename T>
+    static DynamicArray<int> smallestLastOrder(const CSRGraph<T>& graph) {
+        const int n = graph.getVertexCount();
+        const int top = maxDegree(graph);
+        DynamicArray<int> degree(n);
+        DynamicArray<int> bin(0, top + 1);  // Начало блока вершин каждой степени в vertices
+        for (int v = 0; v < n; ++v) {
+            degree[v] = graph.rowEnd(v) - graph.rowBegin(v);
+            ++bin[degree[v]];
         }
+        for (int d = 0, begin = 0; d <= top; ++d) {
+            int count = bin[d];
+            bin[d] = begin;
+            begin += count;
+        }
+        DynamicArray<int> vertices(n);
+        DynamicArray<int> position(n);
+        for (int v = 0; v < n; ++v) {
+            position[v] = bin[degree[v]]++;
+            vertices[position[v]] = v;
+        }
+        for (int d = top; d > 0; --d) {
+            bin[d] = bin[d - 1];
+        }
+        bin[0] = 0;
 
-        return result; /**< Возвращаем массив с назначенными цветами для всех вершин. */
+        DynamicArray<int> order(n);
+        for (int i = 0; i < n; ++i) {
+            int v = vertices[i];
+            order[n - 1 - i] = v;
+            for (int e = graph.rowBegin(v); e < graph.rowEnd(v); ++e) {
+                int w = graph.getTarget(e);
+                if (degree[w] <= degree[v]) continue;
+                // w переносится в начало своего блока, и граница блока сдвигается за неё
+                int d = degree[w];
+                int first = vertices[bin[d]];
+                if (first != w) {
+                    vertices[position[w]] = first;
+                    position[first] = position[w];
+                    vertices[bin[d]] = w;
+                    position[w] = bin[d];
+                }
+                ++bin[d];
+                --degree[w];
+            }
+        }
+        return order;
     }
 };
 
-#endif // GRAPH_COLORING_H
\ No newline at end of file
+#endif // GRAPH_COLORING_H
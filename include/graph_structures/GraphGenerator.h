@@ -167,6 +167,13 @@ private:
         std::mt19937 gen(std::random_device{}()); /**< Генератор случайных чисел. */
         std::uniform_int_distribution<> dis_weight(1, maxWeight); /**< Равномерное распределение для весов рёбер. */
 
+        long long maxEdges = (long long) vertices * (vertices - 1) / 2; /**< Максимальное возможное число рёбер в неориентированном графе. */
+        long long targetEdges = static_cast<long long>(density * maxEdges); /**< Целевое число рёбер на основе плотности. */
+        if (isSparseTarget(targetEdges, maxEdges)) {
+            addRandomEdges(graph, vertices, targetEdges, gen, dis_weight);
+            return graph;
+        }
+
         ArraySequence<Pair<int, int>> allEdges; /**< Список всех возможных рёбер. */
 
         // Генерируем список всех возможных рёбер без повторений
@@ -179,9 +186,6 @@ private:
         // Перемешиваем список рёбер для случайного выбора
         shuffleArraySequence(allEdges, gen);
 
-        int maxEdges = vertices * (vertices - 1) / 2; /**< Максимальное возможное число рёбер в неориентированном графе. */
-        int targetEdges = static_cast<int>(density * maxEdges); /**< Целевое число рёбер на основе плотности. */
-
         // Добавляем ребра до достижения целевого числа рёбер
         for (int i = 0; i < targetEdges && i < allEdges.getLength(); ++i) {
             int u = allEdges.get(i).first; /**< Первая вершина ребра. */
@@ -304,6 +308,13 @@ private:
         std::mt19937 gen(std::random_device{}()); /**< Генератор случайных чисел. */
         std::uniform_int_distribution<> dis_weight(1, maxWeight); /**< Равномерное распределение для весов рёбер. */
 
+        long long maxEdges = (long long) vertices * (vertices - 1); /**< Максимальное возможное число ориентированных рёбер. */
+        long long targetEdges = static_cast<long long>(density * maxEdges); /**< Целевое число рёбер на основе плотности. */
+        if (isSparseTarget(targetEdges, maxEdges)) {
+            addRandomEdges(graph, vertices, targetEdges, gen, dis_weight);
+            return graph;
+        }
+
         ArraySequence<Pair<int, int>> allEdges; /**< Список всех возможных направленных рёбер. */
 
         // Генерируем список всех возможных направленных рёбер без повторений, исключая петли
@@ -318,9 +329,6 @@ private:
         // Перемешиваем список рёбер для случайного выбора
         shuffleArraySequence(allEdges, gen);
 
-        int maxEdges = vertices * (vertices - 1); /**< Максимальное возможное число ориентированных рёбер. */
-        int targetEdges = static_cast<int>(density * maxEdges); /**< Целевое число рёбер на основе плотности. */
-
         // Добавляем ребра до достижения целевого числа рёбер
         for (int i = 0; i < targetEdges && i < allEdges.getLength(); ++i) {
             int u = allEdges.get(i).first; /**< Исходная вершина ребра. */
@@ -463,6 +471,43 @@ private:
         return graph; /**< Возвращаем сгенерированный граф. */
     }
 
+    /**
+     * @brief Проверяет, что случайный граф достаточно разрежён для выбора рёбер с отбрасыванием повторов.
+     *
+     * При заполнении не более четверти всех пар случайная пара оказывается новой с вероятностью
+     * не меньше 3/4, поэтому перечислять все O(V^2) пар не требуется.
+     */
+    static bool isSparseTarget(long long targetEdges, long long maxEdges) {
+        return targetEdges * 4 <= maxEdges;
+    }
+
+    /**
+     * @brief Добавляет в граф заданное число случайных рёбер без петель и повторов.
+     *
+     * Пары вершин выбираются равномерно, уже существующие рёбра отбрасываются;
+     * время O(E log d) вместо O(V^2) при полном перечислении пар.
+     *
+     * @param graph Граф, в который добавляются рёбра.
+     * @param vertices Число вершин в графе.
+     * @param edges Число добавляемых рёбер.
+     * @param gen Генератор случайных чисел.
+     * @param disWeight Распределение весов рёбер.
+     */
+    template <typename G>
+    static void addRandomEdges(G& graph, int vertices, long long edges, std::mt19937& gen,
+                               std::uniform_int_distribution<>& disWeight) {
+        std::uniform_int_distribution<> disVertex(0, vertices - 1); /**< Равномерное распределение для выбора вершин. */
+        for (long long added = 0; added < edges;) {
+            int u = disVertex(gen);
+            int v = disVertex(gen);
+            if (u == v || graph.hasEdge(u, v)) {
+                continue;
+            }
+            graph.addEdge(u, v, disWeight(gen));
+            ++added;
+        }
+    }
+
     /**
      * @brief Алгоритм Фишера-Йейтса для перемешивания элементов в `ArraySequence`.
      *
@@ -0,0 +1,357 @@
+#ifndef INCREMENTAL_SHORTEST_PATH_H
+#define INCREMENTAL_SHORTEST_PATH_H
+
+#include "Graph.h"
+#include "ShortestPath.h"
+#include "../sequence/ArraySequence.h"
+#include "../sequence/DynamicArray.h"
+#include "../sequence/IndexedPriorityQueue.h"
+#include "../sequence/Pair.h"
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Дерево кратчайших путей от одного источника, поддерживаемое при изменении весов рёбер.
+ *
+ * Вместо повторного запуска алгоритма Дейкстры после изменения весов дерево ремонтируется
+ * локально по схеме Рамалингама–Репса:
+ * - при увеличении веса ребра дерева все вершины его поддерева («затронутые») получают
+ *   предварительные расстояния через незатронутых предков и досчитываются алгоритмом
+ *   Дейкстры только внутри затронутого множества;
+ * - при уменьшении веса ребра улучшение распространяется от его конца, пока расстояния уменьшаются.
+ * Работа пропорциональна числу вершин, чьи расстояния или предшественники действительно
+ * изменились, и их рёбрам.
+ *
+ * Структура хранит собственную копию рёбер (в формате CSR с обратными списками), поэтому
+ * исходный граф после построения не нужен. Рёбра считаются ориентированными: для
+ * неориентированного графа вес нужно обновлять в обоих направлениях.
+ *
+ * @tparam T Тип веса рёбер (арифметический, веса неотрицательны).
+ */
+template<typename T>
+class IncrementalShortestPath {
+    static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+    typedef std::tuple<Vertex, Vertex, T> EdgeUpdate; /**< Ребро (from, to) и его новый вес. */
+
+    /**
+     * @brief Копирует рёбра графа и строит дерево кратчайших путей от источника.
+     *
+     * @param graph Граф с неотрицательными весами рёбер.
+     * @param source Исходная вершина.
+     *
+     * @throws std::out_of_range Если исходная вершина находится вне допустимого диапазона.
+     * @throws std::invalid_argument Если в графе есть ребро отрицательного веса.
+     */
+    IncrementalShortestPath(const Graph<T>& graph, Vertex source)
+            : vertexCount(graph.getVertexCount()), source(source), queue(graph.getVertexCount()) {
+        if (source < 0 || source >= vertexCount) {
+            throw std::out_of_range("Source vertex is out of range");
+        }
+        copyEdges(graph);
+        distances.assign(vertexCount, INF);
+        predecessors.assign(vertexCount, -1);
+        affected.assign(vertexCount, false);
+
+        distances[source] = T(0);
+        queue.Enqueue(source, T(0));
+        propagateDecreases();
+    }
+
+    /**
+     * @brief Меняет вес одного ребра и ремонтирует дерево.
+     *
+     * @throws std::invalid_argument Если ребра нет или новый вес отрицателен.
+     */
+    void updateEdge(Vertex from, Vertex to, T weight) {
+        ArraySequence<EdgeUpdate> updates;
+        updates.append(EdgeUpdate(from, to, weight));
+        updateEdges(updates);
+    }
+
+    /**
+     * @brief Меняет веса пакета рёбер и ремонтирует дерево один раз для всего пакета.
+     *
+     * Сначала обрабатываются увеличения (пересчёт затронутых поддеревьев), затем
+     * уменьшения (распространение улучшений). Если ребро встречается в пакете несколько раз,
+     * действует последнее значение.
+     *
+     * @throws std::invalid_argument Если какого-либо ребра нет или новый вес отрицателен;
+     *                               в этом случае ни один вес не изменяется.
+     */
+    void updateEdges(const ArraySequence<EdgeUpdate>& updates) {
+        std::vector<int> positions(updates.getLength());
+        for (int i = 0; i < updates.getLength(); ++i) {
+            positions[i] = findEdge(std::get<0>(updates[i]), std::get<1>(updates[i]));
+            if (positions[i] == -1) {
+                throw std::invalid_argument("Edge not found");
+            }
+            if (std::get<2>(updates[i]) < T(0)) {
+                throw std::invalid_argument("Edge weight must be non-negative");
+            }
+        }
+
+        lastTouched = 0;
+        std::vector<Vertex> increasedTreeHeads;
+        std::vector<int> decreased;
+        for (int i = 0; i < updates.getLength(); ++i) {
+            Vertex from = std::get<0>(updates[i]);
+            Vertex to = std::get<1>(updates[i]);
+            T weight = std::get<2>(updates[i]);
+            T old = weights[positions[i]];
+            if (weight == old) continue;
+            weights[positions[i]] = weight;
+            if (old < weight) {
+                if (predecessors[to] == from) increasedTreeHeads.push_back(to);
+            } else {
+                decreased.push_back(positions[i]);
+            }
+        }
+
+        repairIncreases(increasedTreeHeads);
+
+        // Уменьшения: ребро, нарушающее неравенство треугольника, улучшает свой конец
+        for (int position : decreased) {
+            Vertex from = edgeSources[position];
+            relax(from, targets[position], weights[position]);
+        }
+        propagateDecreases();
+    }
+
+    /**
+     * @brief Текущее расстояние от источника до вершины (максимум типа, если вершина недостижима).
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    T getDistance(Vertex vertex) const {
+        checkVertex(vertex);
+        return distances[vertex];
+    }
+
+    /**
+     * @brief Предшественник вершины в дереве кратчайших путей (-1 для источника и недостижимых вершин).
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    Vertex getPredecessor(Vertex vertex) const {
+        checkVertex(vertex);
+        return predecessors[vertex];
+    }
+
+    /**
+     * @brief Текущий вес ребра.
+     *
+     * @throws std::invalid_argument Если ребра нет.
+     */
+    T getEdgeWeight(Vertex from, Vertex to) const {
+        int position = findEdge(from, to);
+        if (position == -1) {
+            throw std::invalid_argument("Edge not found");
+        }
+        return weights[position];
+    }
+
+    /**
+     * @brief Расстояния и предшественники всех вершин в формате `ShortestPath::dijkstra`.
+     */
+    ArraySequence<Pair<T, Vertex>> getResult() const {
+        ArraySequence<Pair<T, Vertex>> result;
+        for (Vertex v = 0; v < vertexCount; ++v) {
+            result.append(Pair<T, Vertex>(distances[v], predecessors[v]));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Путь от источника до вершины по текущему дереву.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     * @throws std::runtime_error Если вершина недостижима.
+     */
+    ArraySequence<Vertex> getPath(Vertex target) const {
+        checkVertex(target);
+        if (distances[target] == INF) {
+            throw std::runtime_error("No path exists to target vertex");
+        }
+        ArraySequence<Vertex> path;
+        for (Vertex v = target; v != -1; v = predecessors[v]) {
+            path.prepend(v);
+        }
+        return path;
+    }
+
+    Vertex getSource() const {
+        return source;
+    }
+
+    int getVertexCount() const {
+        return vertexCount;
+    }
+
+    /**
+     * @brief Число вершин, извлечённых из очереди при последнем обновлении.
+     */
+    int getLastTouchedCount() const {
+        return lastTouched;
+    }
+
+private:
+    static constexpr T INF = std::numeric_limits<T>::max();
+
+    int vertexCount;
+    Vertex source;
+
+    // Прямые рёбра в формате CSR, строки отсортированы по конечной вершине
+    DynamicArray<int> offsets;
+    DynamicArray<int> targets;
+    DynamicArray<int> edgeSources;  // Начало ребра с тем же индексом
+    DynamicArray<T> weights;
+    // Обратные списки: индексы прямых рёбер, входящих в вершину
+    DynamicArray<int> reverseOffsets;
+    DynamicArray<int> reverseEdges;
+
+    std::vector<T> distances;
+    std::vector<Vertex> predecessors;
+    std::vector<bool> affected;
+    IndexedPriorityQueue<T> queue;
+    int lastTouched = 0;
+
+    void checkVertex(Vertex vertex) const {
+        if (vertex < 0 || vertex >= vertexCount) {
+            throw std::out_of_range("Vertex is out of range");
+        }
+    }
+
+    void copyEdges(const Graph<T>& graph) {
+        offsets = DynamicArray<int>(vertexCount + 1);
+        for (Vertex u = 0; u < vertexCount; ++u) {
+            offsets[u + 1] = offsets[u] + graph.getDegree(u);
+        }
+        int edgeCount = offsets[vertexCount];
+        targets = DynamicArray<int>(edgeCount);
+        edgeSources = DynamicArray<int>(edgeCount);
+        weights = DynamicArray<T>(edgeCount);
+        reverseOffsets = DynamicArray<int>(vertexCount + 1);
+
+        for (Vertex u = 0; u < vertexCount; ++u) {
+            int position = offsets[u];
+            graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                if (weight < T(0)) {
+                    throw std::invalid_argument("Edge weight must be non-negative");
+                }
+                // Вставка с сохранением порядка: списки соседей обычно уже отсортированы
+                int j = position++;
+                while (j > offsets[u] && targets[j - 1] > v) {
+                    targets[j] = targets[j - 1];
+                    weights[j] = weights[j - 1];
+                    --j;
+                }
+                targets[j] = v;
+                weights[j] = weight;
+                edgeSources[j] = u;
+                ++reverseOffsets[v + 1];
+            });
+        }
+
+        for (Vertex v = 0; v < vertexCount; ++v) {
+            reverseOffsets[v + 1] += reverseOffsets[v];
+        }
+        reverseEdges = DynamicArray<int>(edgeCount);
+        std::vector<int> fill(vertexCount);
+        for (Vertex v = 0; v < vertexCount; ++v) {
+            fill[v] = reverseOffsets[v];
+        }
+        for (int position = 0; position < edgeCount; ++position) {
+            reverseEdges[fill[targets[position]]++] = position;
+        }
+    }
+
+    // Индекс ребра from -> to двоичным поиском в строке from или -1
+    int findEdge(Vertex from, Vertex to) const {
+        if (from < 0 || from >= vertexCount || to < 0 || to >= vertexCount) return -1;
+        int low = offsets[from];
+        int high = offsets[from + 1] - 1;
+        while (low <= high) {
+            int middle = low + (high - low) / 2;
+            if (targets[middle] == to) return middle;
+            if (targets[middle] < to) {
+                low = middle + 1;
+            } else {
+                high = middle - 1;
+            }
+        }
+        return -1;
+    }
+
+    // Улучшает расстояние до v через ребро u -> v и ставит v в очередь
+    void relax(Vertex u, Vertex v, T weight) {
+        if (distances[u] == INF || distances[u] > INF - weight) return;
+        T candidate = distances[u] + weight;
+        if (!(candidate < distances[v])) return;
+        distances[v] = candidate;
+        predecessors[v] = u;
+        if (queue.contains(v)) {
+            queue.decreaseKey(v, candidate);
+        } else {
+            queue.Enqueue(v, candidate);
+        }
+    }
+
+    // Дейкстра от вершин, уже находящихся в очереди, с текущими расстояниями как верхними оценками
+    void propagateDecreases() {
+        while (!queue.isEmpty()) {
+            Vertex u = queue.Dequeue().first;
+            ++lastTouched;
+            for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+                relax(u, targets[i], weights[i]);
+            }
+        }
+    }
+
+    // Пересчитывает поддеревья вершин, ребро к которым от предшественника стало тяжелее
+    void repairIncreases(const std::vector<Vertex>& heads) {
+        if (heads.empty()) return;
+
+        // Затронутые вершины — потомки heads в дереве; потомки u — соседи w с predecessors[w] == u
+        std::vector<Vertex> subtree;
+        for (Vertex head : heads) {
+            if (affected[head]) continue;
+            affected[head] = true;
+            subtree.push_back(head);
+        }
+        for (size_t i = 0; i < subtree.size(); ++i) {
+            Vertex u = subtree[i];
+            for (int j = offsets[u]; j < offsets[u + 1]; ++j) {
+                Vertex w = targets[j];
+                if (!affected[w] && predecessors[w] == u) {
+                    affected[w] = true;
+                    subtree.push_back(w);
+                }
+            }
+        }
+
+        // Предварительные расстояния через входящие рёбра от незатронутых вершин
+        for (Vertex v : subtree) {
+            distances[v] = INF;
+            predecessors[v] = -1;
+        }
+        for (Vertex v : subtree) {
+            for (int i = reverseOffsets[v]; i < reverseOffsets[v + 1]; ++i) {
+                int edge = reverseEdges[i];
+                if (!affected[edgeSources[edge]]) relax(edgeSources[edge], v, weights[edge]);
+            }
+        }
+        for (Vertex v : subtree) {
+            affected[v] = false;
+        }
+        // Расстояния незатронутых вершин не выросли, поэтому досчёт не выходит за пределы поддеревьев
+        propagateDecreases();
+    }
+};
+
+#endif //INCREMENTAL_SHORTEST_PATH_H
@@ -0,0 +1,144 @@
+#ifndef LANDMARK_HEURISTIC_H
+#define LANDMARK_HEURISTIC_H
+
+#include "Graph.h"
+#include "ShortestPath.h"
+#include "../sequence/ArraySequence.h"
+#include "../sequence/DynamicArray.h"
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief Эвристика ALT (A*, Landmarks, Triangle inequality) для алгоритма A*.
+ *
+ * При построении выбираются k опорных вершин (landmarks) методом «самой дальней точки»
+ * и для каждой из них вычисляются расстояния от неё до всех вершин и от всех вершин до неё.
+ * По неравенству треугольника оценка
+ * h(v) = max_L max(d(L, t) - d(L, v), d(v, L) - d(t, L), 0)
+ * не превосходит истинного расстояния d(v, t), поэтому A* с ней находит кратчайший путь.
+ * Если по опорной вершине видно, что цель из v недостижима, возвращается максимум типа.
+ *
+ * Предвычисление требует 2k запусков алгоритма Дейкстры и O(k * V) памяти; одна эвристика
+ * обслуживает сколько угодно запросов, цель задаётся через `setTarget`.
+ *
+ * @tparam T Тип веса рёбер графа.
+ */
+template<typename T>
+class LandmarkHeuristic {
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+
+    /**
+     * @brief Выбирает опорные вершины и вычисляет расстояния до них.
+     *
+     * @param graph Граф с неотрицательными весами рёбер.
+     * @param reverseGraph Граф с обращёнными рёбрами (для неориентированного графа — сам граф).
+     * @param landmarkCount Число опорных вершин (не больше числа вершин графа).
+     *
+     * @throws std::invalid_argument Если графы имеют разное число вершин или число опорных вершин отрицательно.
+     */
+    LandmarkHeuristic(const Graph<T>& graph, const Graph<T>& reverseGraph, int landmarkCount)
+            : vertexCount(graph.getVertexCount()) {
+        if (reverseGraph.getVertexCount() != vertexCount) {
+            throw std::invalid_argument("Reverse graph must have the same vertices");
+        }
+        if (landmarkCount < 0) {
+            throw std::invalid_argument("Landmark count must be non-negative");
+        }
+        if (landmarkCount > vertexCount) landmarkCount = vertexCount;
+
+        const T INF = std::numeric_limits<T>::max();
+        fromLandmark.reserve(landmarkCount * vertexCount);
+        toLandmark.reserve(landmarkCount * vertexCount);
+
+        // Наименьшее расстояние от уже выбранных опорных вершин; следующая — самая дальняя
+        DynamicArray<T> nearest(INF, vertexCount);
+        Vertex next = 0;
+        for (int l = 0; l < landmarkCount; ++l) {
+            landmarks.append(next);
+            auto forward = ShortestPath<T>::dijkstra(graph, next);
+            auto backward = ShortestPath<T>::dijkstra(reverseGraph, next);
+            for (Vertex v = 0; v < vertexCount; ++v) {
+                fromLandmark.append(forward[v].first);
+                toLandmark.append(backward[v].first);
+                if (forward[v].first < nearest[v]) nearest[v] = forward[v].first;
+            }
+
+            // Недостижимые из выбранных вершины считаются самыми дальними
+            Vertex farthest = -1;
+            for (Vertex v = 0; v < vertexCount; ++v) {
+                if (isLandmark(v)) continue;
+                if (farthest == -1 || nearest[farthest] < nearest[v]) farthest = v;
+            }
+            if (farthest == -1) break;
+            next = farthest;
+        }
+    }
+
+    /**
+     * @brief Задаёт целевую вершину для последующих вызовов `operator()`.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    void setTarget(Vertex target) {
+        if (target < 0 || target >= vertexCount) {
+            throw std::out_of_range("Target vertex is out of range");
+        }
+        this->target = target;
+    }
+
+    /**
+     * @brief Нижняя оценка расстояния от вершины до текущей цели.
+     *
+     * @return T Оценка или максимум типа, если цель из вершины недостижима.
+     */
+    T operator()(Vertex v) const {
+        const T INF = std::numeric_limits<T>::max();
+        T best = T(0);
+        for (int l = 0; l < landmarks.getLength(); ++l) {
+            int offset = l * vertexCount;
+            T fromToTarget = fromLandmark[offset + target];
+            T fromToVertex = fromLandmark[offset + v];
+            T vertexToLandmark = toLandmark[offset + v];
+            T targetToLandmark = toLandmark[offset + target];
+
+            // L достигает v, но не t — значит, и v не достигает t; аналогично для пути в L
+            if ((fromToVertex != INF && fromToTarget == INF) ||
+                (targetToLandmark != INF && vertexToLandmark == INF)) {
+                return INF;
+            }
+            if (fromToTarget != INF && fromToVertex != INF && fromToVertex < fromToTarget &&
+                best < fromToTarget - fromToVertex) {
+                best = fromToTarget - fromToVertex;
+            }
+            if (vertexToLandmark != INF && targetToLandmark != INF && targetToLandmark < vertexToLandmark &&
+                best < vertexToLandmark - targetToLandmark) {
+                best = vertexToLandmark - targetToLandmark;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Возвращает выбранные опорные вершины.
+     */
+    const ArraySequence<Vertex>& getLandmarks() const {
+        return landmarks;
+    }
+
+private:
+    int vertexCount;
+    Vertex target = 0;
+    ArraySequence<Vertex> landmarks;
+    DynamicArray<T> fromLandmark;  // [l * V + v] = d(L_l, v)
+    DynamicArray<T> toLandmark;    // [l * V + v] = d(v, L_l)
+
+    bool isLandmark(Vertex v) const {
+        for (int l = 0; l < landmarks.getLength(); ++l) {
+            if (landmarks[l] == v) return true;
+        }
+        return false;
+    }
+};
+
+#endif //LANDMARK_HEURISTIC_H
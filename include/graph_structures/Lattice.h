@@ -2,6 +2,7 @@
 #define LATTICE_H
 
 #include "DirectedGraph.h"
+#include "ReachabilityIndex.h"
 #include "../sequence/ArraySequence.h"
 #include "../sequence/Pair.h"
 #include "../data_structures/IDictionaryBinaryTree.h"
@@ -26,35 +27,7 @@ private:
     IDictionaryBinaryTree<T, int> elementToIndex; /**< Отображение элемента в индекс. */
     ArraySequence<T> indexToElement; /**< Отображение индекса в элемент. */
 
-    /**
-     * @brief Реализация метода hasPath с использованием DFS.
-     *
-     * Метод `hasPath` проверяет наличие пути между двумя вершинами в графе с использованием
-     * алгоритма поиска в глубину (DFS).
-     *
-     * @param src Исходная вершина.
-     * @param dest Целевая вершина.
-     * @param visited Массив посещённых вершин.
-     * @return true, если путь существует, иначе false.
-     */
-    bool hasPath(int src, int dest, ArraySequence<bool>& visited) const {
-        if (src == dest) {
-            return true;
-        }
-
-        visited[src] = true;
-
-        ArraySequence<Pair<int, int>> neighbors = hasseDiagram.getNeighbors(src);
-        for (int i = 0; i < neighbors.getLength(); ++i) {
-            int neighbor = neighbors.get(i).first;
-            if (!visited.get(neighbor)) {
-                if (hasPath(neighbor, dest, visited)) {
-                    return true;
-                }
-            }
-        }
-        return false;
-    }
+    std::optional<ReachabilityIndex<T>> reachability; /**< Индекс достижимости по диаграмме Хассе. */
 
 public:
     /**
@@ -74,6 +47,7 @@ public:
             elementToIndex.Add(elem, i);
             indexToElement.append(elem);
         }
+        reachability.emplace(hasseDiagram);
     }
 
     /**
@@ -117,11 +91,16 @@ public:
                 }
             }
         }
+        reachability.emplace(hasseDiagram);
     }
 
     /**
      * @brief Метод для проверки отношения a <= b.
      *
+     * Ответ даёт индекс достижимости, построенный по диаграмме Хассе при создании решётки,
+     * поэтому запрос не обходит диаграмму целиком. Буфер обхода у каждого запроса свой,
+     * так что метод можно вызывать из нескольких потоков одновременно.
+     *
      * @param a Первый элемент.
      * @param b Второй элемент.
      * @return true, если a <= b, иначе false.
@@ -135,12 +114,8 @@ public:
         int indexA = elementToIndex.Get(a);
         int indexB = elementToIndex.Get(b);
 
-        ArraySequence<bool> visited;
-        for(int i = 0; i < elements.getLength(); ++i){
-            visited.append(false);
-        }
-
-        return hasPath(indexA, indexB, visited);
+        typename ReachabilityIndex<T>::QueryScratch scratch;
+        return reachability->reachable(indexA, indexB, scratch);
     }
 
     /**
@@ -2,23 +2,46 @@
 #define LAB4_SEM3_MINIMUMSPANNINGTREE_H
 
 #include "UndirectedGraph.h"
-#include <functional>
-#include "QuickSorter.h"
+#include "CSRGraph.h"
+#include "../data_structures/DisjointSet.h"
+#include "../data_structures/ThreadPool.h"
 #include "../sequence/ArraySequence.h"
+#include "../sequence/DynamicArray.h"
+#include "../sequence/IndexedPriorityQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
 #include <tuple>
+#include <vector>
 
 /**
  * @brief Класс для поиска минимального остова графа.
  *
- * Класс `MinimumSpanningTree` предоставляет метод для нахождения минимального остова
- * в неориентированном графе, используя алгоритм Крускала. Он реализует структуру
- * данных "система непересекающихся множеств" для эффективного объединения компонент.
+ * Класс `MinimumSpanningTree` предоставляет алгоритмы нахождения минимального остова
+ * (для несвязного графа — остовного леса) в неориентированном графе:
+ * - `kruskal` — сортировка всех рёбер и проход с системой непересекающихся множеств;
+ * - `filterKruskal` — Крускал с разбиением рёбер по опорному весу: тяжёлая часть
+ *   сортируется только после отбрасывания рёбер внутри уже построенных компонент;
+ * - `boruvka` — параллельный алгоритм Борувки на пуле потоков;
+ * - `prim` — алгоритм Прима, растущий от вершины и не сортирующий рёбра; для плотных графов
+ *   выгоднее всех остальных.
+ *
+ * Варианты Крускала и Борувки читают каждое ребро один раз (из пары направлений берётся
+ * from < to) в плоский массив и объединяют компоненты через `DisjointSet`.
+ *
+ * Каждый метод принимает `UndirectedGraph` или `CSRGraph`; ориентированный `CSRGraph`
+ * отвергается, так как дуги u->v с u > v иначе были бы потеряны.
  *
  * @tparam T Тип веса рёбер графа.
  */
 template <typename T>
 class MinimumSpanningTree {
 public:
+    typedef std::tuple<int, int, T> Edge; /**< Ребро (вершина1, вершина2, вес), вершина1 < вершина2. */
+
     /**
      * @brief Находит минимальный остов графа с использованием алгоритма Крускала.
      *
@@ -26,90 +49,392 @@ public:
      * с помощью алгоритма Крускала. Он сортирует все рёбра по возрастанию веса
      * и добавляет их последовательно к остову, избегая циклов.
      *
-     * @param graph Неориентированный граф, для которого требуется найти минимальный остов.
-     * @return ArraySequence<std::tuple<int, int, T>> Список рёбер минимального остова.
-     *                                             Каждое ребро представлено кортежем (вершина1, вершина2, вес).
+     * @param graph Неориентированный граф (`UndirectedGraph` или замороженный `CSRGraph`),
+     *              для которого требуется найти минимальный остов.
+     * @return ArraySequence<std::tuple<int, int, T>> Список рёбер минимального остова в порядке
+     *                                             возрастания веса. Каждое ребро представлено кортежем (вершина1, вершина2, вес).
+     *
+     * @throws std::invalid_argument Если `CSRGraph` ориентированный (так же для всех методов класса).
+     */
+    static ArraySequence<Edge> kruskal(const UndirectedGraph<T>& graph) {
+        return kruskalImpl(graph);
+    }
+
+    static ArraySequence<Edge> kruskal(const CSRGraph<T>& graph) {
+        return kruskalImpl(requireUndirected(graph));
+    }
+
+    /**
+     * @brief Находит минимальный остов алгоритмом Filter-Kruskal.
+     *
+     * Рёбра разбиваются по весу случайного опорного ребра. Лёгкая часть обрабатывается
+     * рекурсивно первой; затем из тяжёлой части удаляются рёбра, концы которых уже связаны,
+     * и только оставшиеся рёбра участвуют в дальнейшем разбиении. Для графов, где остов
+     * складывается из лёгких рёбер, большая часть рёбер так и не сортируется.
+     *
+     * @param graph Неориентированный граф.
+     * @return ArraySequence<std::tuple<int, int, T>> Рёбра остова в порядке возрастания веса
+     *                                             (тот же вес, что у `kruskal`).
      */
-    static ArraySequence<std::tuple<int, int, T>> kruskal(const UndirectedGraph<T>& graph) {
-        int vertices = graph.getVertexCount(); /**< Общее количество вершин в графе. */
-        ArraySequence<int> parent;             /**< Массив для хранения родительских вершин в системе непересекающихся множеств. */
+    static ArraySequence<Edge> filterKruskal(const UndirectedGraph<T>& graph) {
+        return filterKruskalImpl(graph);
+    }
+
+    static ArraySequence<Edge> filterKruskal(const CSRGraph<T>& graph) {
+        return filterKruskalImpl(requireUndirected(graph));
+    }
+
+    /**
+     * @brief Находит минимальный остов параллельным алгоритмом Борувки.
+     *
+     * В каждом раунде потоки просматривают рёбра и для каждой компоненты выбирают самое
+     * лёгкое исходящее ребро (атомарный минимум по паре (вес, номер ребра), поэтому при равных
+     * весах циклы не возникают). Выбранные рёбра объединяют компоненты, вершины получают
+     * номера новых компонент, а рёбра внутри компонент удаляются из массива. Число компонент
+     * за раунд уменьшается как минимум вдвое, так что раундов не больше log2 n.
+     *
+     * @param graph Неориентированный граф.
+     * @param pool Пул потоков; метод нельзя вызывать из задачи этого же пула.
+     * @return ArraySequence<std::tuple<int, int, T>> Рёбра остова (порядок не определён).
+     */
+    static ArraySequence<Edge> boruvka(const UndirectedGraph<T>& graph, ThreadPool& pool) {
+        return boruvkaImpl(graph, pool);
+    }
+
+    static ArraySequence<Edge> boruvka(const CSRGraph<T>& graph, ThreadPool& pool) {
+        return boruvkaImpl(requireUndirected(graph), pool);
+    }
+
+    /**
+     * @brief Находит минимальный остов алгоритмом Прима, выбирая вариант по плотности графа.
+     *
+     * Если число рёбер порядка V² / log V и больше (например, `GraphGenerator::COMPLETE`),
+     * используется `primDense` за O(V²), иначе — `primHeap` за O(E log V).
+     *
+     * @param graph Неориентированный граф.
+     * @return ArraySequence<std::tuple<int, int, T>> Рёбра остова в порядке их добавления.
+     */
+    static ArraySequence<Edge> prim(const UndirectedGraph<T>& graph) {
+        return primImpl(graph);
+    }
+
+    static ArraySequence<Edge> prim(const CSRGraph<T>& graph) {
+        return primImpl(requireUndirected(graph));
+    }
+
+    /**
+     * @brief Алгоритм Прима на индексированной куче.
+     *
+     * Вершины вне дерева хранятся в `IndexedPriorityQueue` с ключом — весом лёгкого ребра
+     * в дерево; улучшение ключа выполняется через decreaseKey. Для несвязного графа
+     * рост начинается заново от каждой не достигнутой вершины, и получается остовный лес.
+     *
+     * @param graph Неориентированный граф.
+     * @return ArraySequence<std::tuple<int, int, T>> Рёбра остова в порядке их добавления.
+     */
+    static ArraySequence<Edge> primHeap(const UndirectedGraph<T>& graph) {
+        return primHeapImpl(graph);
+    }
+
+    static ArraySequence<Edge> primHeap(const CSRGraph<T>& graph) {
+        return primHeapImpl(requireUndirected(graph));
+    }
+
+    /**
+     * @brief Алгоритм Прима за O(V²) без кучи, для полных и почти полных графов.
+     *
+     * Ключи вершин вне дерева лежат подряд в плоском массиве, и следующая вершина выбирается
+     * линейным просмотром этого массива; добавленная вершина заменяется последней. При E
+     * порядка V² просмотр стоит столько же, сколько чтение рёбер, и куча не нужна.
+     *
+     * @param graph Неориентированный граф (для T нужен `std::numeric_limits<T>::max()`).
+     * @return ArraySequence<std::tuple<int, int, T>> Рёбра остова в порядке их добавления.
+     */
+    static ArraySequence<Edge> primDense(const UndirectedGraph<T>& graph) {
+        return primDenseImpl(graph);
+    }
+
+    static ArraySequence<Edge> primDense(const CSRGraph<T>& graph) {
+        return primDenseImpl(requireUndirected(graph));
+    }
+
+private:
+    static ArraySequence<Edge> kruskalImpl(const Graph<T>& graph) {
+        std::vector<WeightedEdge> edges = collectEdges(graph);
+        std::sort(edges.begin(), edges.end(), lighterWeight);
+
+        DisjointSet forest(graph.getVertexCount());
+        ArraySequence<Edge> mst;
+        addEdges(edges.begin(), edges.end(), forest, mst, graph.getVertexCount());
+        return mst;
+    }
+
+    static ArraySequence<Edge> filterKruskalImpl(const Graph<T>& graph) {
+        std::vector<WeightedEdge> edges = collectEdges(graph);
+        DisjointSet forest(graph.getVertexCount());
+        ArraySequence<Edge> mst;
+        std::mt19937 random(1);
+        filterKruskal(edges.begin(), edges.end(), forest, mst, graph.getVertexCount(), random);
+        return mst;
+    }
+
+    static ArraySequence<Edge> boruvkaImpl(const Graph<T>& graph, ThreadPool& pool) {
+        const int n = graph.getVertexCount();
+        std::vector<WeightedEdge> edges = collectEdges(graph);
+        std::vector<WeightedEdge> remaining;
+        ArraySequence<Edge> mst;
 
-        // Инициализируем каждую вершину как её собственного родителя
-        for (int i = 0; i < vertices; ++i) {
-            parent.append(i); /**< Каждая вершина является корнем собственного множества. */
+        DisjointSet forest(n);
+        DynamicArray<int> component(n);    // Представитель компоненты вершины на начало раунда
+        DynamicArray<int> nextComponent(n);
+        std::unique_ptr<std::atomic<int>[]> lightest(new std::atomic<int>[n]);
+        std::vector<int> roots(n);
+        for (int v = 0; v < n; ++v) {
+            component[v] = v;
+            lightest[v].store(-1, std::memory_order_relaxed);
+            roots[v] = v;
         }
 
-        /**
-         * @brief Функция для нахождения корня множества сжатия пути.
-         *
-         * Метод `find` находит корень множества, к которому принадлежит вершина `v`,
-         * и одновременно выполняет сжатие пути для оптимизации будущих операций.
-         *
-         * @param v Вершина, для которой нужно найти корень.
-         * @return int Индекс корня множества.
-         */
-        std::function<int(int)> find = [&](int v) -> int {
-            if (parent[v] != v) {
-                parent[v] = find(parent[v]);  /**< Рекурсивно ищем корень и выполняем сжатие пути. */
+        while (!edges.empty()) {
+            const int m = int(edges.size());
+            const int edgeChunks = (m + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+            pool.parallelFor(edgeChunks, 1, [&](int chunk, unsigned) {
+                int end = std::min(m, (chunk + 1) * PARALLEL_GRAIN);
+                for (int e = chunk * PARALLEL_GRAIN; e < end; ++e) {
+                    offerLightest(lightest[component[edges[e].from]], e, edges);
+                    offerLightest(lightest[component[edges[e].to]], e, edges);
+                }
+            });
+
+            // Объединение по выбранным рёбрам (число компонент мало по сравнению с числом рёбер)
+            for (int root : roots) {
+                int e = lightest[root].load(std::memory_order_relaxed);
+                if (e == -1) continue;
+                lightest[root].store(-1, std::memory_order_relaxed);
+                if (forest.unite(edges[e].from, edges[e].to)) {
+                    mst.append(Edge(edges[e].from, edges[e].to, edges[e].weight));
+                }
             }
-            return parent[v]; /**< Возвращаем корень множества. */
-        };
-
-        /**
-         * @brief Функция для объединения двух множеств.
-         *
-         * Метод `unite` объединяет два множества, в которые принадлежат вершины `u` и `v`.
-         *
-         * @param u Первая вершина.
-         * @param v Вторая вершина.
-         */
-        std::function<void(int, int)> unite = [&](int u, int v) {
-            int rootU = find(u); /**< Находим корень множества первой вершины. */
-            int rootV = find(v); /**< Находим корень множества второй вершины. */
-            if (rootU != rootV) {
-                parent[rootU] = rootV;  /**< Объединяем два множества, присваивая корню одного множество другого. */
+            for (int root : roots) {
+                nextComponent[root] = forest.find(root);
             }
-        };
-
-        ArraySequence<std::tuple<int, int, T>> mst; /**< Список рёбер минимального остова. */
-        ArraySequence<std::tuple<int, int, T>> edges = graph.getEdges(); /**< Получаем все рёбра графа. */
-
-        /**
-         * @brief Сортируем рёбра по возрастанию веса с помощью быстрого сортировщика.
-         *
-         * Используется класс `QuickSorter` для эффективной сортировки рёбер.
-         */
-        QuickSorter<std::tuple<int, int, T>> sorter([](const std::tuple<int, int, T>& a, const std::tuple<int, int, T>& b) {
-            return std::get<2>(a) < std::get<2>(b);  /**< Сортировка по третьему элементу кортежа - весу ребра. */
-        });
+            roots.erase(std::remove_if(roots.begin(), roots.end(),
+                                       [&nextComponent](int root) { return nextComponent[root] != root; }),
+                        roots.end());
 
-        sorter.sort(&edges); /**< Сортируем рёбра по возрастанию веса. */
-
-        /**
-         * @brief Проходим по отсортированным рёбрам и добавляем их в остов.
-         *
-         * Добавляем ребро в остов, если оно соединяет две разные компоненты связности,
-         * тем самым избегая создания циклов.
-         */
-        for (int i = 0; i < edges.getLength(); ++i) {
-            const auto& edge = edges[i]; /**< Текущее ребро. */
-            int u = std::get<0>(edge);   /**< Первая вершина ребра. */
-            int v = std::get<1>(edge);   /**< Вторая вершина ребра. */
-            T weight = std::get<2>(edge); /**< Вес ребра. */
-
-            if (find(u) != find(v)) { /**< Проверяем, принадлежат ли вершины к разным множествам. */
-                mst.append(edge);      /**< Добавляем ребро в минимальный остов. */
-                unite(u, v);           /**< Объединяем множества вершин. */
-
-                // Если остов содержит (vertices - 1) рёбер, алгоритм завершается
-                if (mst.getLength() == vertices - 1) {
-                    break; /**< Достигнут минимальный набор рёбер для остова. */
+            const int vertexChunks = (n + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+            pool.parallelFor(vertexChunks, 1, [&](int chunk, unsigned) {
+                int end = std::min(n, (chunk + 1) * PARALLEL_GRAIN);
+                for (int v = chunk * PARALLEL_GRAIN; v < end; ++v) {
+                    component[v] = nextComponent[component[v]];
                 }
+            });
+
+            // Уплотнение: рёбра внутри компонент больше не нужны
+            std::vector<int> offsets(edgeChunks + 1, 0);
+            pool.parallelFor(edgeChunks, 1, [&](int chunk, unsigned) {
+                int end = std::min(m, (chunk + 1) * PARALLEL_GRAIN);
+                int kept = 0;
+                for (int e = chunk * PARALLEL_GRAIN; e < end; ++e) {
+                    kept += component[edges[e].from] != component[edges[e].to];
+                }
+                offsets[chunk + 1] = kept;
+            });
+            for (int chunk = 0; chunk < edgeChunks; ++chunk) {
+                offsets[chunk + 1] += offsets[chunk];
             }
+            remaining.resize(offsets[edgeChunks]);
+            pool.parallelFor(edgeChunks, 1, [&](int chunk, unsigned) {
+                int end = std::min(m, (chunk + 1) * PARALLEL_GRAIN);
+                int position = offsets[chunk];
+                for (int e = chunk * PARALLEL_GRAIN; e < end; ++e) {
+                    if (component[edges[e].from] != component[edges[e].to]) {
+                        remaining[position++] = edges[e];
+                    }
+                }
+            });
+            edges.swap(remaining);
         }
+        return mst;
+    }
+
+    static ArraySequence<Edge> primImpl(const Graph<T>& graph) {
+        const int n = graph.getVertexCount();
+        long long arcs = 0;
+        for (int v = 0; v < n; ++v) {
+            arcs += graph.getDegree(v);
+        }
+        int logV = 1;
+        while ((1 << logV) < n) {
+            ++logV;
+        }
+        // Порог подобран по замеру Benchmarks (группа mst): на полном графе primDense быстрее примерно на 15%
+        return arcs * logV >= 2LL * n * n ? primDenseImpl(graph) : primHeapImpl(graph);
+    }
+
+    static ArraySequence<Edge> primHeapImpl(const Graph<T>& graph) {
+        const int n = graph.getVertexCount();
+        ArraySequence<Edge> mst;
+        DynamicArray<T> key(n);
+        DynamicArray<int> parent(-1, n);
+        DynamicArray<bool> inTree(false, n);
+        IndexedPriorityQueue<T> queue(n);
+
+        for (int root = 0; root < n; ++root) {
+            if (inTree[root]) continue;
+            queue.Enqueue(root, T());
+            while (!queue.isEmpty()) {
+                int u = queue.Dequeue().first;
+                inTree[u] = true;
+                if (parent[u] != -1) {
+                    mst.append(Edge(std::min(parent[u], u), std::max(parent[u], u), key[u]));
+                }
+                graph.forEachNeighbor(u, [&](int v, const T& weight) {
+                    if (inTree[v]) return;
+                    if (queue.contains(v)) {
+                        if (!(weight < key[v])) return;
+                        queue.decreaseKey(v, weight);
+                    } else {
+                        queue.Enqueue(v, weight);
+                    }
+                    key[v] = weight;
+                    parent[v] = u;
+                });
+            }
+        }
+        return mst;
+    }
+
+    static ArraySequence<Edge> primDenseImpl(const Graph<T>& graph) {
+        const int n = graph.getVertexCount();
+        ArraySequence<Edge> mst;
+        if (n == 0) return mst;
+
+        const T none = std::numeric_limits<T>::max();
+        DynamicArray<T> keys(none, n);       // Ключ вершины outside[i] — keys[i]
+        DynamicArray<int> outside(n);        // Вершины вне дерева
+        DynamicArray<int> positionOf(n);     // Позиция вершины в outside или -1 для вершин дерева
+        DynamicArray<int> parent(-1, n);
+        for (int v = 0; v < n; ++v) {
+            outside[v] = v;
+            positionOf[v] = v;
+        }
+        T* key = &keys[0];
+        int* vertexAt = &outside[0];
+        int* position = &positionOf[0];
+        int* parentOf = &parent[0];
+
+        for (int remaining = n; remaining > 0; --remaining) {
+            int best = 0;
+            for (int i = 1; i < remaining; ++i) {
+                if (key[i] < key[best]) best = i;
+            }
+            // Ключ none бывает и у настоящего ребра максимального веса: такое ребро важнее нового корня
+            if (!(key[best] < none) && parentOf[vertexAt[best]] == -1) {
+                for (int i = 0; i < remaining; ++i) {
+                    if (parentOf[vertexAt[i]] != -1) {
+                        best = i;
+                        break;
+                    }
+                }
+            }
+
+            int u = vertexAt[best];
+            if (parentOf[u] != -1) {
+                mst.append(Edge(std::min(parentOf[u], u), std::max(parentOf[u], u), key[best]));
+            }
+            int last = remaining - 1;
+            vertexAt[best] = vertexAt[last];
+            key[best] = key[last];
+            position[vertexAt[best]] = best;
+            position[u] = -1;
 
-        return mst;  /**< Возвращаем список рёбер минимального остова. */
+            graph.forEachNeighbor(u, [&](int v, const T& weight) {
+                int p = position[v];
+                if (p == -1 || (!(weight < key[p]) && parentOf[v] != -1)) return;
+                key[p] = weight;
+                parentOf[v] = u;
+            });
+        }
+        return mst;
+    }
+
+    // Рёбер (или вершин) в одной задаче параллельного прохода
+    static constexpr int PARALLEL_GRAIN = 16384;
+
+    // Диапазон, который Filter-Kruskal сортирует целиком вместо разбиения
+    static constexpr int FILTER_THRESHOLD = 4096;
+
+    struct WeightedEdge {
+        T weight;
+        int from;
+        int to;
+    };
+
+    typedef typename std::vector<WeightedEdge>::iterator EdgeIterator;
+
+    static bool lighterWeight(const WeightedEdge& a, const WeightedEdge& b) {
+        return a.weight < b.weight;
+    }
+
+    static const CSRGraph<T>& requireUndirected(const CSRGraph<T>& graph) {
+        if (graph.isDirected()) {
+            throw std::invalid_argument("Minimum spanning tree requires an undirected graph");
+        }
+        return graph;
+    }
+
+    static std::vector<WeightedEdge> collectEdges(const Graph<T>& graph) {
+        std::vector<WeightedEdge> edges;
+        for (int from = 0; from < graph.getVertexCount(); ++from) {
+            graph.forEachNeighbor(from, [&edges, from](int to, const T& weight) {
+                if (from < to) edges.push_back(WeightedEdge{weight, from, to});
+            });
+        }
+        return edges;
+    }
+
+    // Добавляет в остов рёбра упорядоченного диапазона, соединяющие разные компоненты
+    static void addEdges(EdgeIterator begin, EdgeIterator end, DisjointSet& forest, ArraySequence<Edge>& mst,
+                         int vertexCount) {
+        for (auto edge = begin; edge != end && mst.getLength() < vertexCount - 1; ++edge) {
+            if (forest.unite(edge->from, edge->to)) {
+                mst.append(Edge(edge->from, edge->to, edge->weight));
+            }
+        }
+    }
+
+    static void filterKruskal(EdgeIterator begin, EdgeIterator end, DisjointSet& forest, ArraySequence<Edge>& mst,
+                              int vertexCount, std::mt19937& random) {
+        if (mst.getLength() >= vertexCount - 1) return;
+        if (end - begin <= FILTER_THRESHOLD) {
+            std::sort(begin, end, lighterWeight);
+            addEdges(begin, end, forest, mst, vertexCount);
+            return;
+        }
+
+        // Диапазон делится на рёбра легче опорного, равные ему и тяжелее
+        T pivot = begin[random() % (end - begin)].weight;
+        auto equal = std::partition(begin, end, [&pivot](const WeightedEdge& edge) { return edge.weight < pivot; });
+        auto heavy = std::partition(equal, end, [&pivot](const WeightedEdge& edge) { return !(pivot < edge.weight); });
+
+        filterKruskal(begin, equal, forest, mst, vertexCount, random);
+        addEdges(equal, heavy, forest, mst, vertexCount);
+        if (mst.getLength() >= vertexCount - 1) return;
+        auto kept = std::partition(heavy, end, [&forest](const WeightedEdge& edge) {
+            return !forest.connected(edge.from, edge.to);
+        });
+        filterKruskal(heavy, kept, forest, mst, vertexCount, random);
+    }
+
+    // Атомарный минимум по (вес, номер ребра)
+    static void offerLightest(std::atomic<int>& slot, int e, const std::vector<WeightedEdge>& edges) {
+        int current = slot.load(std::memory_order_relaxed);
+        while (current == -1 || edges[e].weight < edges[current].weight
+               || (!(edges[current].weight < edges[e].weight) && e < current)) {
+            if (slot.compare_exchange_weak(current, e, std::memory_order_relaxed)) return;
+        }
     }
 };
 
-#endif // LAB4_SEM3_MINIMUMSPANNINGTREE_H
\ No newline at end of file
+#endif // LAB4_SEM3_MINIMUMSPANNINGTREE_H
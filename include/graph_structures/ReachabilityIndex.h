@@ -0,0 +1,503 @@
+#ifndef REACHABILITY_INDEX_H
+#define REACHABILITY_INDEX_H
+
+#include "Graph.h"
+#include "CSRGraph.h"
+#include "StronglyConnectedComponents.h"
+#include "../sequence/DynamicArray.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Индекс достижимости: отвечает, есть ли путь из u в v, без обхода всего графа.
+ *
+ * Граф сжимается до графа конденсации (DAG сильно связанных компонент), компоненты
+ * нумеруются в топологическом порядке, и каждой компоненте назначаются интервальные метки
+ * GRAIL: для нескольких случайных обходов в глубину метка компоненты c — интервал
+ * post-номеров всех достижимых из неё компонент (в DAG это [наименьший из них, номер самой c]).
+ * Если v достижима из u, метка v вложена в метку u во всех обходах, поэтому большинство
+ * отрицательных ответов получается сравнением чисел. Положительные ответы даёт интервал поддерева первого обхода
+ * (v — потомок u в дереве обхода). Остальные запросы решаются обходом в глубину,
+ * отсекающим компоненты по меткам и топологическому номеру.
+ *
+ * Метки всех обходов одной компоненты лежат рядом, так что запрос читает две строки памяти.
+ *
+ * Индекс поддерживает добавление рёбер: ребро, согласованное с топологическим порядком,
+ * только расширяет метки предков; ребро, образующее цикл или нарушающее порядок, перестраивает
+ * индекс по графу конденсации без повторного чтения исходного графа. Удаление рёбер
+ * требует построить индекс заново.
+ *
+ * Запросы без аргумента-буфера используют общий буфер посещённых компонент, поэтому такой
+ * индекс нельзя опрашивать из нескольких потоков одновременно. Перегрузка `reachable` с
+ * собственным `QueryScratch` не изменяет индекс, и её можно вызывать из нескольких потоков,
+ * пока в индекс не добавляются рёбра.
+ *
+ * @tparam T Тип веса рёбер исходного графа (веса не используются).
+ */
+template<typename T>
+class ReachabilityIndex {
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+
+    // Число случайных интервальных меток на компоненту
+    static constexpr int DEFAULT_LABEL_COUNT = 2;
+
+    /**
+     * @brief Буфер обхода одного запроса; размер подгоняется под индекс при первом обходе.
+     */
+    struct QueryScratch {
+        std::vector<int> visitStamp;
+        int currentStamp = 0;
+        std::vector<int> stack;
+        long long searches = 0;
+    };
+
+    /**
+     * @brief Строит индекс для произвольного ориентированного графа.
+     *
+     * @param graph Ориентированный граф.
+     * @param labelCount Число интервальных меток (не меньше 1).
+     * @param seed Зерно для порядка обходов.
+     *
+     * @throws std::invalid_argument Если labelCount меньше 1.
+     */
+    explicit ReachabilityIndex(const Graph<T>& graph, int labelCount = DEFAULT_LABEL_COUNT, unsigned seed = 1)
+            : ReachabilityIndex(CSRGraph<T>(graph, true), labelCount, seed) {}
+
+    /**
+     * @brief Строит индекс для замороженного графа без его копирования.
+     *
+     * @throws std::invalid_argument Если labelCount меньше 1.
+     */
+    explicit ReachabilityIndex(const CSRGraph<T>& graph, int labelCount = DEFAULT_LABEL_COUNT, unsigned seed = 1)
+            : labelCount(labelCount), random(seed) {
+        if (labelCount < 1) {
+            throw std::invalid_argument("Label count must be positive");
+        }
+        auto ids = StronglyConnectedComponents<T>::findComponentIds(graph);
+        vertexCount = graph.getVertexCount();
+        componentOf = std::move(ids.componentOf);
+
+        std::vector<std::pair<int, int>> edges;
+        for (Vertex u = 0; u < vertexCount; ++u) {
+            for (int e = graph.rowBegin(u); e < graph.rowEnd(u); ++e) {
+                int from = componentOf[u];
+                int to = componentOf[graph.getTarget(e)];
+                if (from != to) edges.emplace_back(from, to);
+            }
+        }
+        setCondensation(ids.componentCount, edges);
+    }
+
+    /**
+     * @brief Проверяет, существует ли путь из from в to (вершина достижима из самой себя).
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    bool reachable(Vertex from, Vertex to) const {
+        return reachable(from, to, sharedScratch);
+    }
+
+    /**
+     * @brief Проверка достижимости с буфером вызывающего: индекс при этом не изменяется.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    bool reachable(Vertex from, Vertex to, QueryScratch& scratch) const {
+        checkVertex(from);
+        checkVertex(to);
+        int source = componentOf[from];
+        int target = componentOf[to];
+        if (source == target) return true;
+        // Рёбра конденсации ведут только к большим номерам
+        if (source > target) return false;
+        if (inTreeSubtree(source, target)) return true;
+        if (!labelsContain(source, target)) return false;
+        return search(source, target, scratch);
+    }
+
+    /**
+     * @brief Добавляет ребро from -> to, обновляя индекс.
+     *
+     * @return true, если достижимость в графе изменилась.
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    bool addEdge(Vertex from, Vertex to) {
+        if (reachable(from, to)) return false;
+        int source = componentOf[from];
+        int target = componentOf[to];
+        if (source < target) {
+            extendLabels(source, target);
+        } else {
+            rebuildWithEdge(source, target);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Номер сильно связанной компоненты вершины (в топологическом порядке конденсации).
+     *
+     * @throws std::out_of_range Если вершина находится вне допустимого диапазона.
+     */
+    int getComponent(Vertex vertex) const {
+        checkVertex(vertex);
+        return componentOf[vertex];
+    }
+
+    int getComponentCount() const {
+        return componentCount;
+    }
+
+    int getVertexCount() const {
+        return vertexCount;
+    }
+
+    /**
+     * @brief Число рёбер графа конденсации, включая добавленные после построения.
+     */
+    int getCondensationEdgeCount() const {
+        return forwardOffsets[componentCount] + addedEdgeCount;
+    }
+
+    /**
+     * @brief Число запросов через общий буфер, потребовавших обхода (метки не дали ответа).
+     */
+    long long getSearchCount() const {
+        return sharedScratch.searches;
+    }
+
+private:
+    // Границы post-номеров компонент, достижимых из данной; после обхода high — её собственный номер
+    struct Interval {
+        int low;
+        int high;
+    };
+
+    int vertexCount = 0;
+    int componentCount = 0;
+    int labelCount;
+    std::mt19937 random;
+    DynamicArray<int> componentOf;
+
+    // Граф конденсации в формате CSR (прямые и обратные рёбра) и рёбра, добавленные позже
+    DynamicArray<int> forwardOffsets;
+    DynamicArray<int> forwardTargets;
+    DynamicArray<int> reverseOffsets;
+    DynamicArray<int> reverseTargets;
+    std::vector<std::vector<int>> addedForward;
+    std::vector<std::vector<int>> addedReverse;
+    int addedEdgeCount = 0;
+
+    DynamicArray<Interval> labels;  // Метки компоненты c: labels[c * labelCount + i]
+    DynamicArray<int> treeBegin;    // Поддерево первого обхода: pre-номера [treeBegin, treeEnd)
+    DynamicArray<int> treeEnd;
+
+    mutable QueryScratch sharedScratch;  // Буфер запросов без собственного буфера и обновлений индекса
+
+    void checkVertex(Vertex vertex) const {
+        if (vertex < 0 || vertex >= vertexCount) {
+            throw std::out_of_range("Vertex is out of range");
+        }
+    }
+
+    bool inTreeSubtree(int ancestor, int descendant) const {
+        return treeBegin[ancestor] <= treeBegin[descendant] && treeBegin[descendant] < treeEnd[ancestor];
+    }
+
+    bool labelsContain(int outer, int inner) const {
+        const Interval* a = &labels[outer * labelCount];
+        const Interval* b = &labels[inner * labelCount];
+        for (int i = 0; i < labelCount; ++i) {
+            if (b[i].low < a[i].low || b[i].high > a[i].high) return false;
+        }
+        return true;
+    }
+
+    template<class Func>
+    void forEachSuccessor(int component, Func&& func) const {
+        for (int e = forwardOffsets[component]; e < forwardOffsets[component + 1]; ++e) {
+            if (!func(forwardTargets[e])) return;
+        }
+        if (addedForward.empty()) return;
+        for (int next : addedForward[component]) {
+            if (!func(next)) return;
+        }
+    }
+
+    template<class Func>
+    void forEachPredecessor(int component, Func&& func) const {
+        for (int e = reverseOffsets[component]; e < reverseOffsets[component + 1]; ++e) {
+            func(reverseTargets[e]);
+        }
+        if (addedReverse.empty()) return;
+        for (int previous : addedReverse[component]) {
+            func(previous);
+        }
+    }
+
+    static bool markVisited(QueryScratch& scratch, int component) {
+        if (scratch.visitStamp[component] == scratch.currentStamp) return false;
+        scratch.visitStamp[component] = scratch.currentStamp;
+        return true;
+    }
+
+    void nextStamp(QueryScratch& scratch) const {
+        if (int(scratch.visitStamp.size()) != componentCount) {
+            scratch.visitStamp.assign(componentCount, 0);
+            scratch.currentStamp = 0;
+        }
+        if (++scratch.currentStamp == 0) {
+            std::fill(scratch.visitStamp.begin(), scratch.visitStamp.end(), 0);
+            scratch.currentStamp = 1;
+        }
+    }
+
+    // Обход в глубину от source, заходящий только в компоненты, чьи метки могут содержать target
+    bool search(int source, int target, QueryScratch& scratch) const {
+        ++scratch.searches;
+        nextStamp(scratch);
+        std::vector<int>& stack = scratch.stack;
+        stack.clear();
+        stack.push_back(source);
+        markVisited(scratch, source);
+        bool found = false;
+        while (!stack.empty() && !found) {
+            int component = stack.back();
+            stack.pop_back();
+            forEachSuccessor(component, [&](int next) {
+                if (next == target || (next < target && inTreeSubtree(next, target))) {
+                    found = true;
+                    return false;
+                }
+                if (next < target && labelsContain(next, target) && markVisited(scratch, next)) {
+                    stack.push_back(next);
+                }
+                return true;
+            });
+        }
+        return found;
+    }
+
+    // Строит CSR конденсации (номера компонент топологические) и метки
+    void setCondensation(int components, std::vector<std::pair<int, int>>& edges) {
+        componentCount = components;
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        forwardOffsets = DynamicArray<int>(componentCount + 1);
+        reverseOffsets = DynamicArray<int>(componentCount + 1);
+        for (const auto& edge : edges) {
+            ++forwardOffsets[edge.first + 1];
+            ++reverseOffsets[edge.second + 1];
+        }
+        for (int c = 0; c < componentCount; ++c) {
+            forwardOffsets[c + 1] += forwardOffsets[c];
+            reverseOffsets[c + 1] += reverseOffsets[c];
+        }
+        forwardTargets = DynamicArray<int>(int(edges.size()));
+        reverseTargets = DynamicArray<int>(int(edges.size()));
+        std::vector<int> fill(componentCount);
+        for (int c = 0; c < componentCount; ++c) {
+            fill[c] = reverseOffsets[c];
+        }
+        for (int i = 0; i < int(edges.size()); ++i) {
+            forwardTargets[i] = edges[i].second;
+            reverseTargets[fill[edges[i].second]++] = edges[i].first;
+        }
+        addedForward.clear();
+        addedReverse.clear();
+        addedEdgeCount = 0;
+
+        buildLabels();
+    }
+
+    void buildLabels() {
+        labels = DynamicArray<Interval>(componentCount * labelCount);
+        treeBegin = DynamicArray<int>(componentCount);
+        treeEnd = DynamicArray<int>(componentCount);
+
+        std::vector<int> order(componentCount);
+        std::vector<int> frameComponent;
+        std::vector<int> frameStep;
+        std::vector<int> frameShift;
+        for (int i = 0; i < labelCount; ++i) {
+            for (int c = 0; c < componentCount; ++c) {
+                order[c] = c;
+            }
+            // Первый обход идёт в топологическом порядке и строит дерево для положительных ответов
+            if (i > 0) std::shuffle(order.begin(), order.end(), random);
+
+            nextStamp(sharedScratch);
+            int post = 0;
+            int pre = 0;
+            for (int root : order) {
+                if (!markVisited(sharedScratch, root)) continue;
+                frameComponent.assign(1, root);
+                frameStep.assign(1, 0);
+                frameShift.assign(1, i == 0 ? 0 : int(random() % 1024));
+                if (i == 0) treeBegin[root] = pre++;
+
+                while (!frameComponent.empty()) {
+                    int c = frameComponent.back();
+                    int degree = forwardOffsets[c + 1] - forwardOffsets[c];
+                    int& step = frameStep.back();
+                    bool descended = false;
+                    while (step < degree) {
+                        // Соседи перебираются со случайного сдвига, чтобы обходы различались
+                        int next = forwardTargets[forwardOffsets[c] + (step + frameShift.back()) % degree];
+                        ++step;
+                        if (markVisited(sharedScratch, next)) {
+                            if (i == 0) treeBegin[next] = pre++;
+                            frameComponent.push_back(next);
+                            frameStep.push_back(0);
+                            frameShift.push_back(i == 0 ? 0 : int(random() % 1024));
+                            descended = true;
+                            break;
+                        }
+                    }
+                    if (descended) continue;
+
+                    // Все потомки DAG уже завершены: их метки окончательны
+                    Interval label{post, post};
+                    ++post;
+                    for (int e = forwardOffsets[c]; e < forwardOffsets[c + 1]; ++e) {
+                        label.low = std::min(label.low, labels[forwardTargets[e] * labelCount + i].low);
+                    }
+                    labels[c * labelCount + i] = label;
+                    if (i == 0) treeEnd[c] = pre;
+                    frameComponent.pop_back();
+                    frameStep.pop_back();
+                    frameShift.pop_back();
+                }
+            }
+        }
+    }
+
+    // Ребро source -> target с source < target: метки source и его предков расширяются до метки target
+    void extendLabels(int source, int target) {
+        if (addedForward.empty()) {
+            addedForward.resize(componentCount);
+            addedReverse.resize(componentCount);
+        }
+        addedForward[source].push_back(target);
+        addedReverse[target].push_back(source);
+        ++addedEdgeCount;
+
+        const Interval* bound = &labels[target * labelCount];
+        auto extend = [&](int component) {
+            bool changed = false;
+            Interval* label = &labels[component * labelCount];
+            for (int i = 0; i < labelCount; ++i) {
+                if (bound[i].low < label[i].low) {
+                    label[i].low = bound[i].low;
+                    changed = true;
+                }
+                if (bound[i].high > label[i].high) {
+                    label[i].high = bound[i].high;
+                    changed = true;
+                }
+            }
+            return changed;
+        };
+        if (!extend(source)) return;
+        std::vector<int>& stack = sharedScratch.stack;
+        stack.assign(1, source);
+        while (!stack.empty()) {
+            int component = stack.back();
+            stack.pop_back();
+            forEachPredecessor(component, [&](int previous) {
+                if (extend(previous)) stack.push_back(previous);
+            });
+        }
+    }
+
+    // Ребро source -> target с source > target: сливает образовавшийся цикл и перенумеровывает компоненты
+    void rebuildWithEdge(int source, int target) {
+        // Цикл образуют компоненты, достижимые из target и ведущие в source; их номера в [target, source]
+        std::vector<char> forward(componentCount, 0);
+        std::vector<char> backward(componentCount, 0);
+        forward[target] = 1;
+        std::vector<int>& stack = sharedScratch.stack;
+        stack.assign(1, target);
+        while (!stack.empty()) {
+            int component = stack.back();
+            stack.pop_back();
+            forEachSuccessor(component, [&](int next) {
+                if (next <= source && !forward[next]) {
+                    forward[next] = 1;
+                    stack.push_back(next);
+                }
+                return true;
+            });
+        }
+        if (forward[source]) {
+            backward[source] = 1;
+            stack.assign(1, source);
+            while (!stack.empty()) {
+                int component = stack.back();
+                stack.pop_back();
+                forEachPredecessor(component, [&](int previous) {
+                    if (previous >= target && !backward[previous]) {
+                        backward[previous] = 1;
+                        stack.push_back(previous);
+                    }
+                });
+            }
+        }
+
+        // Слитые компоненты получают номер target, остальные сжимаются
+        std::vector<int> merged(componentCount);
+        int count = 0;
+        for (int c = 0; c < componentCount; ++c) {
+            bool inCycle = forward[c] && backward[c];
+            merged[c] = inCycle && c != target ? -1 : count++;
+        }
+        for (int c = 0; c < componentCount; ++c) {
+            if (merged[c] == -1) merged[c] = merged[target];
+        }
+
+        std::vector<std::pair<int, int>> edges;
+        for (int c = 0; c < componentCount; ++c) {
+            forEachSuccessor(c, [&](int next) {
+                if (merged[c] != merged[next]) edges.emplace_back(merged[c], merged[next]);
+                return true;
+            });
+        }
+        if (merged[source] != merged[target]) edges.emplace_back(merged[source], merged[target]);
+
+        // Новый топологический порядок (алгоритм Кана)
+        std::vector<int> inDegree(count, 0);
+        std::vector<std::vector<int>> successors(count);
+        for (const auto& edge : edges) {
+            successors[edge.first].push_back(edge.second);
+            ++inDegree[edge.second];
+        }
+        std::vector<int> rank(count);
+        std::vector<int> ready;
+        for (int c = 0; c < count; ++c) {
+            if (inDegree[c] == 0) ready.push_back(c);
+        }
+        for (int next = 0; !ready.empty(); ++next) {
+            int c = ready.back();
+            ready.pop_back();
+            rank[c] = next;
+            for (int successor : successors[c]) {
+                if (--inDegree[successor] == 0) ready.push_back(successor);
+            }
+        }
+
+        for (auto& edge : edges) {
+            edge = {rank[edge.first], rank[edge.second]};
+        }
+        for (Vertex v = 0; v < vertexCount; ++v) {
+            componentOf[v] = rank[merged[componentOf[v]]];
+        }
+        setCondensation(count, edges);
+    }
+};
+
+#endif //REACHABILITY_INDEX_H
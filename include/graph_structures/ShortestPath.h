@@ -4,10 +4,24 @@
 #include "Graph.h"
 #include "../sequence/ArraySequence.h"
 #include "../sequence/PriorityQueue.h"
+#include "../sequence/IndexedPriorityQueue.h"
 #include "../sequence/Pair.h"
+#include <atomic>
+#include <barrier>
 #include <limits>
 #include <functional>
+#include <memory>
 #include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Очередь с приоритетом, используемая алгоритмом Дейкстры.
+ */
+enum class DijkstraQueue {
+    AVL_TREE,     /**< `PriorityQueue` на AVL-дереве с ленивым повторным добавлением вершин. */
+    INDEXED_HEAP  /**< `IndexedPriorityQueue` (4-арная куча) с уменьшением ключа. */
+};
 
 /**
  * @brief Класс для поиска кратчайших путей в графе с помощью алгоритма Дейкстры.
@@ -20,6 +34,23 @@ class ShortestPath {
 public:
     typedef int Vertex; /**< Тип для обозначения вершины графа. */
 
+    /**
+     * @brief Результат поиска кратчайшего пути между двумя вершинами.
+     */
+    struct PathResult {
+        bool found = false;                          /**< Существует ли путь. */
+        T distance = std::numeric_limits<T>::max();  /**< Длина пути (максимум типа, если пути нет). */
+        ArraySequence<Vertex> path;                  /**< Вершины пути от источника до цели. */
+        int settled = 0;                             /**< Число извлечённых из очереди вершин. */
+    };
+
+    /**
+     * @brief Нулевая эвристика: A* с ней совпадает с алгоритмом Дейкстры с ранней остановкой.
+     */
+    static T zeroHeuristic(Vertex) {
+        return T(0);
+    }
+
     /**
      * @brief Реализация алгоритма Дейкстры для поиска кратчайших путей от источника до всех вершин графа.
      *
@@ -29,12 +60,14 @@ public:
      *
      * @param graph Ссылка на граф, в котором выполняется поиск.
      * @param source Исходная вершина (источник).
+     * @param queue Реализация очереди с приоритетом (по умолчанию индексированная куча).
      * @return ArraySequence<Pair<T, Vertex>> Последовательность пар, где каждая пара содержит
      *                                            расстояние от источника и предшествующую вершину для каждой вершины графа.
      *
      * @throws std::out_of_range Если исходная вершина находится вне допустимого диапазона.
      */
-    static ArraySequence<Pair<T, Vertex>> dijkstra(const Graph<T>& graph, Vertex source) {
+    static ArraySequence<Pair<T, Vertex>> dijkstra(const Graph<T>& graph, Vertex source,
+                                                   DijkstraQueue queue = DijkstraQueue::INDEXED_HEAP) {
         static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
 
         int n = graph.getVertexCount();
@@ -53,32 +86,56 @@ public:
         }
         distances[source] = T(0);
 
-        // Приоритетная очередь для вершин
-        PriorityQueue<Vertex, T> pq;
-        pq.Enqueue(source, T(0));
+        // Релаксация ребра u -> v; возвращает true, если расстояние до v уменьшилось
+        auto relax = [&](Vertex u, Vertex v, const T& weight) -> bool {
+            // Проверка на переполнение и корректность пути
+            if (distances[u] != MAX_VALUE &&
+                weight != MAX_VALUE &&
+                distances[u] + weight < distances[v]) {
 
-        while (!pq.isEmpty()) {
-            auto current = pq.Dequeue();
-            Vertex u = current.first;
-            T dist_u = current.second;
+                distances[v] = distances[u] + weight;
+                predecessors[v] = u;
+                return true;
+            }
+            return false;
+        };
 
-            // Пропускаем, если уже найден более короткий путь
-            if (dist_u > distances[u]) continue;
+        if (queue == DijkstraQueue::AVL_TREE) {
+            // Приоритетная очередь для вершин
+            PriorityQueue<Vertex, T> pq;
+            pq.Enqueue(source, T(0));
 
-            auto neighbors = graph.getNeighbors(u);
-            for (int i = 0; i < neighbors.getLength(); ++i) {
-                Vertex v = neighbors[i].first;
-                T weight = neighbors[i].second;
+            while (!pq.isEmpty()) {
+                auto current = pq.Dequeue();
+                Vertex u = current.first;
+                T dist_u = current.second;
 
-                // Проверка на переполнение и корректность пути
-                if (distances[u] != MAX_VALUE &&
-                    weight != MAX_VALUE &&
-                    distances[u] + weight < distances[v]) {
+                // Пропускаем, если уже найден более короткий путь
+                if (dist_u > distances[u]) continue;
 
-                    distances[v] = distances[u] + weight;
-                    predecessors[v] = u;
-                    pq.Enqueue(v, distances[v]);
-                }
+                graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                    if (relax(u, v, weight)) {
+                        pq.Enqueue(v, distances[v]);
+                    }
+                });
+            }
+        } else {
+            // Каждая вершина находится в куче не более одного раза
+            IndexedPriorityQueue<T> heap(n);
+            heap.Enqueue(source, T(0));
+
+            while (!heap.isEmpty()) {
+                Vertex u = heap.Dequeue().first;
+
+                graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                    if (relax(u, v, weight)) {
+                        if (heap.contains(v)) {
+                            heap.decreaseKey(v, distances[v]);
+                        } else {
+                            heap.Enqueue(v, distances[v]);
+                        }
+                    }
+                });
             }
         }
 
@@ -91,6 +148,215 @@ public:
         return result;
     }
 
+    /**
+     * @brief Поиск кратчайшего пути между двумя вершинами алгоритмом A*.
+     *
+     * Вершины извлекаются в порядке g(v) + h(v), где g — найденное расстояние от источника,
+     * h — оценка расстояния до цели. Поиск завершается, как только извлечена цель, поэтому
+     * просматривается лишь часть графа. Для допустимой эвристики (h не превосходит истинного
+     * расстояния) путь кратчайший; для несогласованной эвристики вершины могут открываться повторно.
+     * Значение h(v), равное максимуму типа, означает, что цель из v недостижима.
+     *
+     * @tparam Heuristic Вызываемый объект T(Vertex), например `LandmarkHeuristic` или `zeroHeuristic`.
+     * @param graph Граф с неотрицательными весами рёбер.
+     * @param source Исходная вершина.
+     * @param target Целевая вершина.
+     * @param heuristic Оценка расстояния от вершины до цели.
+     * @return PathResult Длина и вершины пути.
+     *
+     * @throws std::out_of_range Если вершины находятся вне допустимого диапазона.
+     */
+    template<class Heuristic>
+    static PathResult aStar(const Graph<T>& graph, Vertex source, Vertex target, const Heuristic& heuristic) {
+        static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+        int n = graph.getVertexCount();
+        checkEndpoints(n, source, target);
+
+        const T INF = std::numeric_limits<T>::max();
+        std::vector<T> distances(n, INF);
+        std::vector<Vertex> predecessors(n, -1);
+        IndexedPriorityQueue<T> open(n);
+        PathResult result;
+
+        T sourceEstimate = heuristic(source);
+        if (sourceEstimate == INF) return result;
+        distances[source] = T(0);
+        open.Enqueue(source, sourceEstimate);
+
+        while (!open.isEmpty()) {
+            Vertex u = open.Dequeue().first;
+            ++result.settled;
+            if (u == target) break;
+
+            T du = distances[u];
+            graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                if (du > INF - weight || !(du + weight < distances[v])) return;
+                T estimate = heuristic(v);
+                if (estimate == INF || du + weight > INF - estimate) return;
+                distances[v] = du + weight;
+                predecessors[v] = u;
+                T key = distances[v] + estimate;
+                if (open.contains(v)) {
+                    open.decreaseKey(v, key);
+                } else {
+                    open.Enqueue(v, key);
+                }
+            });
+        }
+
+        if (distances[target] != INF) {
+            result.found = true;
+            result.distance = distances[target];
+            for (Vertex v = target; v != -1; v = predecessors[v]) {
+                result.path.prepend(v);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Двунаправленный алгоритм Дейкстры для поиска пути между двумя вершинами.
+     *
+     * Прямой поиск идёт от источника по `graph`, обратный — от цели по `reverseGraph`
+     * (транспонированному графу; для неориентированного графа это сам граф). На каждом шаге
+     * продвигается поиск с меньшим минимальным ключом; работа прекращается, когда сумма
+     * минимальных ключей очередей не меньше длины лучшего найденного пути.
+     *
+     * @param graph Граф с неотрицательными весами рёбер.
+     * @param reverseGraph Граф с обращёнными рёбрами (например, `CSRGraph::getTranspose()`).
+     * @param source Исходная вершина.
+     * @param target Целевая вершина.
+     * @return PathResult Длина и вершины пути.
+     *
+     * @throws std::out_of_range Если вершины находятся вне допустимого диапазона.
+     * @throws std::invalid_argument Если графы имеют разное число вершин.
+     */
+    static PathResult bidirectionalDijkstra(const Graph<T>& graph, const Graph<T>& reverseGraph,
+                                            Vertex source, Vertex target) {
+        static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+        int n = graph.getVertexCount();
+        checkEndpoints(n, source, target);
+        if (reverseGraph.getVertexCount() != n) {
+            throw std::invalid_argument("Reverse graph must have the same vertices");
+        }
+
+        const T INF = std::numeric_limits<T>::max();
+        // Индекс 0 — прямой поиск, 1 — обратный
+        std::vector<T> distances[2] = {std::vector<T>(n, INF), std::vector<T>(n, INF)};
+        std::vector<Vertex> predecessors[2] = {std::vector<Vertex>(n, -1), std::vector<Vertex>(n, -1)};
+        IndexedPriorityQueue<T> queues[2] = {IndexedPriorityQueue<T>(n), IndexedPriorityQueue<T>(n)};
+        const Graph<T>* graphs[2] = {&graph, &reverseGraph};
+        PathResult result;
+
+        distances[0][source] = T(0);
+        distances[1][target] = T(0);
+        queues[0].Enqueue(source, T(0));
+        queues[1].Enqueue(target, T(0));
+        T best = source == target ? T(0) : INF;
+        Vertex meeting = source == target ? source : -1;
+
+        while (!queues[0].isEmpty() && !queues[1].isEmpty()) {
+            T top[2] = {queues[0].PeekFirst().second, queues[1].PeekFirst().second};
+            if (best != INF && top[0] + top[1] >= best) break;
+
+            int side = top[0] <= top[1] ? 0 : 1;
+            Vertex u = queues[side].Dequeue().first;
+            ++result.settled;
+            T du = distances[side][u];
+            auto &dist = distances[side];
+            auto &otherDist = distances[1 - side];
+            auto &queue = queues[side];
+
+            graphs[side]->forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                if (du > INF - weight) return;
+                T candidate = du + weight;
+                if (candidate < dist[v]) {
+                    dist[v] = candidate;
+                    predecessors[side][v] = u;
+                    if (queue.contains(v)) {
+                        queue.decreaseKey(v, candidate);
+                    } else {
+                        queue.Enqueue(v, candidate);
+                    }
+                }
+                if (otherDist[v] != INF && dist[v] <= INF - otherDist[v] && dist[v] + otherDist[v] < best) {
+                    best = dist[v] + otherDist[v];
+                    meeting = v;
+                }
+            });
+        }
+
+        if (meeting != -1) {
+            result.found = true;
+            result.distance = best;
+            for (Vertex v = meeting; v != -1; v = predecessors[0][v]) {
+                result.path.prepend(v);
+            }
+            for (Vertex v = predecessors[1][meeting]; v != -1; v = predecessors[1][v]) {
+                result.path.append(v);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Параллельный поиск кратчайших путей от источника методом delta-stepping (Meyer, Sanders).
+     *
+     * Вершины распределяются по корзинам ширины `delta` по текущему расстоянию. Корзины обрабатываются
+     * по возрастанию: сначала многократно релаксируются лёгкие рёбра (вес <= delta) вершин текущей
+     * корзины, затем один раз тяжёлые рёбра всех вершин, покинувших её. Вершины фазы делятся между
+     * потоками порциями, расстояния обновляются атомарно (CAS), а пополнение корзин выполняется
+     * одним потоком между фазами. Предшественники восстанавливаются после завершения по «тугим» рёбрам,
+     * поэтому результат совместим с `getPath`.
+     *
+     * Граф должен допускать одновременное чтение из нескольких потоков и не содержать рёбер
+     * отрицательного веса.
+     *
+     * @param graph Граф, в котором выполняется поиск.
+     * @param source Исходная вершина.
+     * @param delta Ширина корзины; при значении <= 0 выбирается как максимальный вес / средняя степень.
+     * @param threads Число потоков (по умолчанию число аппаратных потоков).
+     * @return ArraySequence<Pair<T, Vertex>> Расстояние и предшественник для каждой вершины (как у `dijkstra`).
+     *
+     * @throws std::out_of_range Если исходная вершина находится вне допустимого диапазона.
+     */
+    static ArraySequence<Pair<T, Vertex>> deltaStepping(const Graph<T>& graph, Vertex source, T delta = T(0),
+                                                        unsigned threads = std::thread::hardware_concurrency()) {
+        static_assert(std::is_arithmetic<T>::value, "Weight type must be numeric");
+
+        int n = graph.getVertexCount();
+        if (source < 0 || source >= n) {
+            throw std::out_of_range("Source vertex is out of range");
+        }
+        if (threads == 0) threads = 1;
+        if (!(delta > T(0))) delta = chooseDelta(graph);
+
+        DeltaSteppingState state(n, threads, delta);
+        state.distances[source].store(T(0), std::memory_order_relaxed);
+        state.addToBucket(source, 0);
+        state.takeCurrentBucket();
+
+        // Фазы разделены барьером; переход к следующей фазе выполняет функция завершения барьера
+        auto completion = [&state]() noexcept { state.finishPhase(); };
+        std::barrier barrier((std::ptrdiff_t) threads, completion);
+        auto worker = [&graph, &state, &barrier](unsigned id) {
+            while (!state.done) {
+                state.processPhase(graph, id);
+                barrier.arrive_and_wait();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned id = 1; id < threads; ++id) {
+            pool.emplace_back(worker, id);
+        }
+        worker(0);
+        for (auto &thread : pool) {
+            thread.join();
+        }
+
+        return state.collectResult(graph, source, threads);
+    }
+
     /**
      * @brief Восстанавливает путь от источника до целевой вершины.
      *
@@ -144,6 +410,223 @@ public:
 
         return path;
     }
+
+private:
+    static void checkEndpoints(int n, Vertex source, Vertex target) {
+        if (source < 0 || source >= n) {
+            throw std::out_of_range("Source vertex is out of range");
+        }
+        if (target < 0 || target >= n) {
+            throw std::out_of_range("Target vertex is out of range");
+        }
+    }
+
+    // Ширина корзины по умолчанию: максимальный вес ребра, делённый на среднюю степень
+    static T chooseDelta(const Graph<T>& graph) {
+        int n = graph.getVertexCount();
+        long long edges = 0;
+        T maxWeight = T(0);
+        for (int u = 0; u < n; ++u) {
+            graph.forEachNeighbor(u, [&](int, const T& weight) {
+                ++edges;
+                if (maxWeight < weight) maxWeight = weight;
+            });
+        }
+        if (edges == 0 || !(maxWeight > T(0))) return T(1);
+        T delta = static_cast<T>(maxWeight * (double) n / (double) edges);
+        return delta > T(0) ? delta : T(1);
+    }
+
+    /**
+     * @brief Общее состояние потоков delta-stepping.
+     *
+     * Между фазами состояние изменяет только функция завершения барьера (`finishPhase`),
+     * во время фазы потоки читают текущий фронт и пишут в собственные списки обновлённых вершин.
+     */
+    struct DeltaSteppingState {
+        enum Phase { LIGHT, HEAVY };
+        static constexpr int CHUNK = 64; ///< Число вершин фронта, забираемых потоком за раз.
+
+        int vertexCount;
+        T delta;
+        const T INF = std::numeric_limits<T>::max();
+        std::unique_ptr<std::atomic<T>[]> distances;
+        std::vector<std::vector<Vertex>> buckets;   ///< Корзины по номеру floor(dist / delta).
+        std::vector<long long> queuedBucket;         ///< Корзина, в которой вершина ожидает обработки, или -1.
+        std::vector<long long> settledBucket;        ///< Последняя корзина, в которой вершина обработана.
+        std::vector<std::vector<Vertex>> updated;    ///< Вершины с уменьшившимся расстоянием, по потокам.
+        std::vector<Vertex> frontier;                ///< Вершины текущей фазы.
+        std::vector<Vertex> settled;                 ///< Вершины, обработанные в текущей корзине.
+        std::atomic<size_t> nextIndex{0};
+        long long current = 0;
+        Phase phase = LIGHT;
+        bool done = false;
+
+        DeltaSteppingState(int n, unsigned threads, T delta)
+                : vertexCount(n), delta(delta), distances(new std::atomic<T>[n]),
+                  queuedBucket(n, -1), settledBucket(n, -1), updated(threads) {
+            for (int i = 0; i < n; ++i) {
+                distances[i].store(INF, std::memory_order_relaxed);
+            }
+        }
+
+        long long bucketOf(T distance) const {
+            return static_cast<long long>(distance / delta);
+        }
+
+        void addToBucket(Vertex v, long long bucket) {
+            if (queuedBucket[v] == bucket) return;
+            if ((long long) buckets.size() <= bucket) buckets.resize(bucket + 1);
+            buckets[bucket].push_back(v);
+            queuedBucket[v] = bucket;
+        }
+
+        // Атомарно уменьшает расстояние до v; true, если оно уменьшилось
+        bool relax(Vertex v, T candidate) {
+            T old = distances[v].load(std::memory_order_relaxed);
+            while (candidate < old) {
+                if (distances[v].compare_exchange_weak(old, candidate, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void processPhase(const Graph<T>& graph, unsigned id) {
+            auto &out = updated[id];
+            size_t size = frontier.size();
+            for (size_t begin = nextIndex.fetch_add(CHUNK); begin < size; begin = nextIndex.fetch_add(CHUNK)) {
+                size_t end = begin + CHUNK < size ? begin + CHUNK : size;
+                for (size_t i = begin; i < end; ++i) {
+                    Vertex u = frontier[i];
+                    T du = distances[u].load(std::memory_order_relaxed);
+                    graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                        if ((weight <= delta) != (phase == LIGHT) || du > INF - weight) return; // Переполнение
+                        if (relax(v, du + weight)) out.push_back(v);
+                    });
+                }
+            }
+        }
+
+        // Забирает из корзины current актуальные вершины в качестве фронта
+        void takeCurrentBucket() {
+            frontier.clear();
+            if (current >= (long long) buckets.size()) return;
+            for (Vertex v : buckets[current]) {
+                if (queuedBucket[v] == current && bucketOf(distances[v].load(std::memory_order_relaxed)) <= current) {
+                    queuedBucket[v] = -1;
+                    frontier.push_back(v);
+                    if (settledBucket[v] != current) {
+                        settledBucket[v] = current;
+                        settled.push_back(v);
+                    }
+                }
+            }
+            std::vector<Vertex>().swap(buckets[current]);
+        }
+
+        // Выбирает следующую фазу: лёгкие рёбра, пока текущая корзина пополняется, затем тяжёлые
+        // рёбра обработанных в ней вершин, затем следующая непустая корзина
+        void prepareNextPhase() {
+            nextIndex.store(0, std::memory_order_relaxed);
+            takeCurrentBucket();
+            if (!frontier.empty()) {
+                phase = LIGHT;
+                return;
+            }
+            if (phase == LIGHT && !settled.empty()) {
+                frontier.swap(settled);
+                phase = HEAVY;
+                return;
+            }
+            settled.clear();
+            while (frontier.empty()) {
+                do {
+                    ++current;
+                } while (current < (long long) buckets.size() && buckets[current].empty());
+                if (current >= (long long) buckets.size()) {
+                    done = true;
+                    return;
+                }
+                takeCurrentBucket();
+            }
+            phase = LIGHT;
+        }
+
+        void finishPhase() {
+            for (auto &list : updated) {
+                for (Vertex v : list) {
+                    long long bucket = bucketOf(distances[v].load(std::memory_order_relaxed));
+                    addToBucket(v, bucket > current ? bucket : current);
+                }
+                list.clear();
+            }
+            if (phase == HEAVY) settled.clear();
+            prepareNextPhase();
+        }
+
+        // Предшественник вершины — начало любого «тугого» ребра u -> v (dist[u] + w == dist[v]);
+        // рёбра положительного веса просматриваются параллельно по диапазонам вершин.
+        // Рёбра нулевого веса разбираются отдельно обходом в ширину, чтобы не образовать цикл.
+        ArraySequence<Pair<T, Vertex>> collectResult(const Graph<T>& graph, Vertex source, unsigned threads) {
+            std::unique_ptr<std::atomic<Vertex>[]> tight(new std::atomic<Vertex>[vertexCount]);
+            for (int v = 0; v < vertexCount; ++v) {
+                tight[v].store(-1, std::memory_order_relaxed);
+            }
+            std::atomic<bool> zeroWeights{false};
+            auto scan = [&](int from, int to) {
+                for (int u = from; u < to; ++u) {
+                    T du = distances[u].load(std::memory_order_relaxed);
+                    if (du == INF) continue;
+                    graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                        if (v == source || tight[v].load(std::memory_order_relaxed) != -1) return;
+                        if (weight == T(0)) {
+                            zeroWeights.store(true, std::memory_order_relaxed);
+                        } else if (du <= INF - weight && du + weight == distances[v].load(std::memory_order_relaxed)) {
+                            tight[v].store(u, std::memory_order_relaxed);
+                        }
+                    });
+                }
+            };
+            std::vector<std::thread> pool;
+            for (unsigned id = 1; id < threads; ++id) {
+                pool.emplace_back(scan, (int) ((long long) vertexCount * id / threads),
+                                  (int) ((long long) vertexCount * (id + 1) / threads));
+            }
+            scan(0, (int) ((long long) vertexCount / threads));
+            for (auto &thread : pool) {
+                thread.join();
+            }
+
+            std::vector<Vertex> predecessors(vertexCount);
+            for (int v = 0; v < vertexCount; ++v) {
+                predecessors[v] = tight[v].load(std::memory_order_relaxed);
+            }
+            if (zeroWeights.load()) {
+                std::vector<Vertex> queue;
+                for (int v = 0; v < vertexCount; ++v) {
+                    if (v == source || predecessors[v] != -1) queue.push_back(v);
+                }
+                for (size_t head = 0; head < queue.size(); ++head) {
+                    Vertex u = queue[head];
+                    T du = distances[u].load(std::memory_order_relaxed);
+                    graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                        if (weight == T(0) && v != source && predecessors[v] == -1 &&
+                            distances[v].load(std::memory_order_relaxed) == du) {
+                            predecessors[v] = u;
+                            queue.push_back(v);
+                        }
+                    });
+                }
+            }
+
+            ArraySequence<Pair<T, Vertex>> result;
+            for (int i = 0; i < vertexCount; ++i) {
+                result.append(Pair<T, Vertex>(distances[i].load(std::memory_order_relaxed), predecessors[i]));
+            }
+            return result;
+        }
+    };
 };
 
 #endif // SHORTEST_PATH_H
\ No newline at end of file
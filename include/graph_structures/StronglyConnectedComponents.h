@@ -2,17 +2,26 @@
 #define STRONGLY_CONNECTED_COMPONENTS_H
 
 #include "DirectedGraph.h"
+#include "CSRGraph.h"
 #include "../sequence/ArraySequence.h"
-#include <functional>
+#include "../sequence/DynamicArray.h"
+#include "../data_structures/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 /**
  * @brief Класс для поиска сильно связанных компонент в ориентированном графе.
  *
- * Этот класс реализует алгоритм Косарайю для нахождения всех сильно связанных компонент
- * в заданном ориентированном графе. Сильно связанные компоненты представляют собой
- * подмножества вершин, где каждая вершина достижима из любой другой вершины внутри
- * этого множества.
+ * Сильно связанные компоненты представляют собой подмножества вершин, где каждая вершина
+ * достижима из любой другой вершины внутри этого множества.
+ *
+ * Используется однопроходный алгоритм Тарьяна в варианте Пирса: вместо массивов
+ * index/lowlink/onStack хранится один массив rindex, который по завершении обхода
+ * содержит номера компонент. Обход итеративный, с явными стеками, поэтому длинные
+ * цепочки не переполняют стек вызовов, а транспонированный граф не нужен.
  *
  * @tparam T Тип данных, ассоциированный с рёбрами графа (например, вес рёбер).
  */
@@ -20,82 +29,424 @@ template <typename T>
 class StronglyConnectedComponents {
 public:
     /**
-     * @brief Находит сильно связанные компоненты графа с использованием алгоритма Косарайю.
+     * @brief Разметка вершин номерами сильно связанных компонент.
      *
-     * Метод выполняет два прохода глубинного обхода (DFS). Первый проход используется
-     * для определения порядка завершения обхода вершин, а второй проход выполняется
-     * на транспонированном графе для выявления сильно связанных компонент.
+     * Компоненты пронумерованы в топологическом порядке графа конденсации:
+     * каждое ребро между разными компонентами ведёт от меньшего номера к большему.
+     */
+    struct ComponentIds {
+        int componentCount = 0;        /**< Число компонент. */
+        DynamicArray<int> componentOf; /**< Номер компоненты каждой вершины, от 0 до componentCount - 1. */
+    };
+
+    /**
+     * @brief Находит сильно связанные компоненты графа.
      *
      * @param graph Ориентированный граф, в котором необходимо найти сильно связанные компоненты.
      * @return ArraySequence<ArraySequence<int>> Список сильно связанных компонент,
-     * каждая из которых представлена списком вершин.
+     * каждая из которых представлена списком вершин; компоненты идут в топологическом порядке.
      */
-    static ArraySequence<ArraySequence<int>> findSCC(const DirectedGraph<T>& graph) {
-        int vertexCount = graph.getVertexCount();
-        ArraySequence<bool> visited; // Массив посещённых вершин
+    static ArraySequence<ArraySequence<int>> findSCC(const Graph<T>& graph) {
+        return groupComponents(findComponentIds(graph));
+    }
 
-        // Инициализируем массив посещённых вершин значениями false
-        for(int i = 0; i < vertexCount; ++i){
-            visited.append(false);
+    /**
+     * @brief Находит номер сильно связанной компоненты каждой вершины.
+     *
+     * Граф копируется в формат CSR (без транспонирования), чтобы обход мог продолжать
+     * перебор соседей с сохранённой позиции.
+     *
+     * @param graph Ориентированный граф.
+     * @return ComponentIds Плоская разметка вершин.
+     */
+    static ComponentIds findComponentIds(const Graph<T>& graph) {
+        return findComponentIds(CSRGraph<T>(graph, true));
+    }
+
+    /**
+     * @brief Находит номер сильно связанной компоненты каждой вершины замороженного графа без копирования.
+     *
+     * Дополнительная память — несколько массивов длины V, ничего пропорционального числу рёбер.
+     *
+     * @param graph Ориентированный граф в формате CSR.
+     * @return ComponentIds Плоская разметка вершин.
+     */
+    static ComponentIds findComponentIds(const CSRGraph<T>& graph) {
+        const int n = graph.getVertexCount();
+        DynamicArray<int> rindex(n);
+        int count = tarjan(graph, n, n, [](int i) { return i; }, [](int) { return true; }, rindex);
+
+        // Компонента, завершённая первой, получила номер n - 1 и не имеет исходящих рёбер
+        ComponentIds result;
+        result.componentCount = count;
+        result.componentOf = DynamicArray<int>(n);
+        for (int v = 0; v < n; ++v) {
+            result.componentOf[v] = rindex[v] - (n - count);
         }
+        return result;
+    }
+
+    // Подзадачи меньше этого размера решаются последовательным алгоритмом Тарьяна
+    static constexpr int DEFAULT_SERIAL_CUTOFF = 4096;
+
+    /**
+     * @brief Параллельный поиск сильно связанных компонент (обрезка + forward–backward).
+     *
+     * Сначала параллельно «обрезаются» вершины без входящих или без исходящих рёбер среди
+     * оставшихся: каждая из них — отдельная компонента. Затем для множества оставшихся вершин
+     * от опорной вершины выполняются прямой и обратный обходы (уровни обходов обрабатываются
+     * параллельно); их пересечение — компонента опорной вершины, а три остатка (достижимые только
+     * вперёд, только назад и остальные) не имеют общих компонент и обрабатываются независимо.
+     * Подзадачи меньше serialCutoff вершин решаются алгоритмом Тарьяна параллельно друг с другом.
+     *
+     * Множества компонент совпадают с `findComponentIds`, но нумерация другая:
+     * компоненты пронумерованы по возрастанию наименьшей вершины, топологического порядка нет.
+     *
+     * @param graph Ориентированный граф в формате CSR.
+     * @param pool Пул потоков; метод нельзя вызывать из задачи этого же пула.
+     * @param serialCutoff Размер подзадачи, начиная с которого применяется forward–backward.
+     * @return ComponentIds Плоская разметка вершин.
+     */
+    static ComponentIds findComponentIdsParallel(const CSRGraph<T>& graph, ThreadPool& pool,
+                                                 int serialCutoff = DEFAULT_SERIAL_CUTOFF) {
+        const int n = graph.getVertexCount();
+        CSRGraph<T> transpose = graph.getTranspose();
+        ParallelState state(n, pool.getThreadCount());
 
-        ArraySequence<int> finishOrder; // Порядок завершения обхода
+        trim(graph, transpose, pool, state);
 
-        // Первый проход DFS для заполнения порядка завершения
-        std::function<void(int)> dfs_first_pass = [&](int v) {
-            visited[v] = true;
-            auto neighbors = graph.getNeighbors(v);
-            for(int i = 0; i < neighbors.getLength(); ++i){
-                int neighbor = neighbors[i].first;
-                if(!visited[neighbor]){
-                    dfs_first_pass(neighbor);
+        std::vector<Part> small;
+        std::vector<Part> large;
+        Part rest;
+        rest.color = 0;
+        for (int v = 0; v < n; ++v) {
+            if (state.colors[v].load(std::memory_order_relaxed) == 0) rest.vertices.push_back(v);
+        }
+        if (!rest.vertices.empty()) {
+            (int(rest.vertices.size()) < serialCutoff ? small : large).push_back(std::move(rest));
+        }
+
+        int nextColor = 1;
+        while (!large.empty()) {
+            Part part = std::move(large.back());
+            large.pop_back();
+            for (Part& piece : forwardBackward(graph, transpose, pool, state, part, nextColor)) {
+                (int(piece.vertices.size()) < serialCutoff ? small : large).push_back(std::move(piece));
+            }
+        }
+
+        pool.parallelFor(int(small.size()), 1, [&](int i, unsigned worker) {
+            solveSerially(graph, small[i], state.scratch[worker], state);
+        });
+
+        // Представитель встречается впервые на наименьшей вершине своей компоненты
+        ComponentIds result;
+        result.componentOf = DynamicArray<int>(n);
+        DynamicArray<int> idOf(-1, n);
+        for (int v = 0; v < n; ++v) {
+            int representative = state.representatives[v];
+            if (idOf[representative] == -1) idOf[representative] = result.componentCount++;
+            result.componentOf[v] = idOf[representative];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Параллельный поиск компонент в произвольном ориентированном графе.
+     *
+     * Граф копируется в формат CSR; метод, как и перегрузка для CSR, нельзя вызывать из задачи пула pool.
+     */
+    static ComponentIds findComponentIdsParallel(const Graph<T>& graph, ThreadPool& pool,
+                                                 int serialCutoff = DEFAULT_SERIAL_CUTOFF) {
+        return findComponentIdsParallel(CSRGraph<T>(graph, true), pool, serialCutoff);
+    }
+
+    /**
+     * @brief Собирает списки вершин компонент по плоской разметке.
+     *
+     * @param ids Разметка, полученная `findComponentIds`.
+     * @return ArraySequence<ArraySequence<int>> Компонента i — элемент i; вершины по возрастанию.
+     */
+    static ArraySequence<ArraySequence<int>> groupComponents(const ComponentIds& ids) {
+        ArraySequence<ArraySequence<int>> sccList;
+        for (int i = 0; i < ids.componentCount; ++i) {
+            sccList.append(ArraySequence<int>());
+        }
+        for (int v = 0; v < ids.componentOf.getSize(); ++v) {
+            sccList[ids.componentOf[v]].append(v);
+        }
+        return sccList;
+    }
+
+
+private:
+    /**
+     * @brief Итеративный алгоритм Тарьяна в варианте Пирса на подмножестве вершин.
+     *
+     * Обходятся только вершины, для которых inSet истинно; обходы начинаются с вершин
+     * startAt(0), ..., startAt(startCount - 1). Для вершин подмножества rindex должен быть
+     * обнулён; по завершении rindex[v] - (size - count) — номер компоненты в топологическом порядке.
+     *
+     * @param size Верхняя граница числа вершин подмножества.
+     * @return int Число найденных компонент count.
+     */
+    template<class StartAt, class InSet>
+    static int tarjan(const CSRGraph<T>& graph, int size, int startCount, StartAt startAt, InSet inSet,
+                      DynamicArray<int>& rindex) {
+        // 0 — не посещена; номер обхода у вершин в стеке; size - 1, size - 2, ... — номер компоненты
+        DynamicArray<int> callVertex(size);  // Стек обхода: вершина, позиция следующего ребра
+        DynamicArray<int> callEdge(size);
+        DynamicArray<bool> callRoot(size);   // и признак корня, пока не найдено ребро «вверх»
+        DynamicArray<int> pending(size);     // Стек вершин, ожидающих своей компоненты
+        int pendingSize = 0;
+        int index = 1;
+        int component = size - 1;
+
+        for (int i = 0; i < startCount; ++i) {
+            int start = startAt(i);
+            if (rindex[start] != 0) continue;
+            int depth = 0;
+            callVertex[0] = start;
+            callEdge[0] = graph.rowBegin(start);
+            callRoot[0] = true;
+            rindex[start] = index++;
+
+            while (depth >= 0) {
+                int v = callVertex[depth];
+                int& edge = callEdge[depth];
+                int end = graph.rowEnd(v);
+                bool descended = false;
+                for (; edge < end; ++edge) {
+                    int w = graph.getTarget(edge);
+                    if (!inSet(w)) continue;
+                    if (rindex[w] == 0) {
+                        rindex[w] = index++;
+                        ++depth;
+                        callVertex[depth] = w;
+                        callEdge[depth] = graph.rowBegin(w);
+                        callRoot[depth] = true;
+                        descended = true;
+                        break;
+                    }
+                    // Номера готовых компонент не меньше index, поэтому они сюда не проходят
+                    if (rindex[w] < rindex[v]) {
+                        rindex[v] = rindex[w];
+                        callRoot[depth] = false;
+                    }
+                }
+                if (descended) continue;
+
+                // Вершина v завершена
+                if (callRoot[depth]) {
+                    --index;
+                    while (pendingSize > 0 && rindex[v] <= rindex[pending[pendingSize - 1]]) {
+                        rindex[pending[--pendingSize]] = component;
+                        --index;
+                    }
+                    rindex[v] = component--;
+                } else {
+                    pending[pendingSize++] = v;
+                }
+                --depth;
+                if (depth >= 0) {
+                    // Продолжаем ребро родителя, ведущее в v
+                    int parent = callVertex[depth];
+                    if (rindex[v] < rindex[parent]) {
+                        rindex[parent] = rindex[v];
+                        callRoot[depth] = false;
+                    }
+                    ++callEdge[depth];
                 }
             }
-            finishOrder.append(v); // Добавляем вершину после обхода её соседей
-        };
+        }
+        return size - 1 - component;
+    }
+
+    // Цвет вершины, компонента которой уже найдена
+    static constexpr int DONE = -1;
 
-        // Запуск первого прохода DFS для всех непосещённых вершин
-        for(int v = 0; v < vertexCount; ++v){
-            if(!visited[v]){
-                dfs_first_pass(v);
+    // Подзадача: вершины одного цвета; компоненты не пересекают границы подзадач
+    struct Part {
+        std::vector<int> vertices;
+        int color = 0;
+    };
+
+    struct ParallelState {
+        // Цвета меняются только владельцем подзадачи, но читаются соседними обходами
+        std::unique_ptr<std::atomic<int>[]> colors;
+        DynamicArray<int> representatives;          // Вершина-представитель компоненты
+        std::vector<DynamicArray<int>> scratch;     // rindex для Тарьяна, по одному на поток
+        std::vector<std::vector<int>> next;         // Следующий уровень обхода, по одному на поток
+
+        ParallelState(int n, unsigned threads)
+                : colors(new std::atomic<int>[n]), representatives(n), scratch(threads), next(threads) {
+            for (int v = 0; v < n; ++v) {
+                colors[v].store(0, std::memory_order_relaxed);
             }
         }
+    };
 
-        // Получаем транспонированный граф (граф с инвертированными рёбрами)
-        DirectedGraph<T> transposedGraph = graph.getTranspose(graph);
+    // Рёбер меньше этого числа на уровне обхода — уровень обрабатывается без пула
+    static constexpr int PARALLEL_GRAIN = 2048;
 
-        // Сбрасываем массив посещённых вершин для второго прохода
-        for(int i = 0; i < vertexCount; ++i){
-            visited[i] = false;
+    /**
+     * @brief Параллельно отбрасывает вершины с нулевой входящей или исходящей степенью.
+     *
+     * Каждая задача обрабатывает свой диапазон вершин и сразу дообрезает вершины, чья степень
+     * обнулилась из-за неё, поэтому длинная цепочка не требует числа раундов, равного её длине.
+     */
+    static void trim(const CSRGraph<T>& graph, const CSRGraph<T>& transpose, ThreadPool& pool,
+                     ParallelState& state) {
+        const int n = graph.getVertexCount();
+        std::unique_ptr<std::atomic<int>[]> inDegree(new std::atomic<int>[n]);
+        std::unique_ptr<std::atomic<int>[]> outDegree(new std::atomic<int>[n]);
+        for (int v = 0; v < n; ++v) {
+            inDegree[v].store(transpose.rowEnd(v) - transpose.rowBegin(v), std::memory_order_relaxed);
+            outDegree[v].store(graph.rowEnd(v) - graph.rowBegin(v), std::memory_order_relaxed);
         }
 
-        ArraySequence<ArraySequence<int>> sccList; // Список сильно связанных компонент
-
-        // Второй проход DFS по транспонированному графу в порядке обратном завершения
-        for(int i = finishOrder.getLength() - 1; i >=0; --i){
-            int v = finishOrder[i];
-            if(!visited[v]){
-                ArraySequence<int> scc;
-
-                // Второй проход DFS для сбора вершин текущей компоненты
-                std::function<void(int)> dfs_second_pass = [&](int u) {
-                    visited[u] = true;
-                    scc.append(u);
-                    auto neighbors = transposedGraph.getNeighbors(u);
-                    for(int j = 0; j < neighbors.getLength(); ++j){
-                        int neighbor = neighbors[j].first;
-                        if(!visited[neighbor]){
-                            dfs_second_pass(neighbor);
+        // Вершину забирает тот, кто первым сменит её цвет с 0 на DONE
+        auto claim = [&state](int v) {
+            int expected = 0;
+            return state.colors[v].compare_exchange_strong(expected, DONE, std::memory_order_relaxed);
+        };
+        int chunks = (n + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+        pool.parallelFor(chunks, 1, [&](int chunk, unsigned) {
+            std::vector<int> stack;
+            int end = std::min(n, (chunk + 1) * PARALLEL_GRAIN);
+            for (int v = chunk * PARALLEL_GRAIN; v < end; ++v) {
+                if (inDegree[v].load(std::memory_order_relaxed) != 0 &&
+                    outDegree[v].load(std::memory_order_relaxed) != 0) continue;
+                if (!claim(v)) continue;
+                stack.push_back(v);
+                while (!stack.empty()) {
+                    int u = stack.back();
+                    stack.pop_back();
+                    state.representatives[u] = u;
+                    for (int e = graph.rowBegin(u); e < graph.rowEnd(u); ++e) {
+                        int w = graph.getTarget(e);
+                        if (inDegree[w].fetch_sub(1, std::memory_order_relaxed) == 1 && claim(w)) {
+                            stack.push_back(w);
                         }
                     }
-                };
+                    for (int e = transpose.rowBegin(u); e < transpose.rowEnd(u); ++e) {
+                        int w = transpose.getTarget(e);
+                        if (outDegree[w].fetch_sub(1, std::memory_order_relaxed) == 1 && claim(w)) {
+                            stack.push_back(w);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Обход в ширину от frontier по рёбрам direction; claim(w) решает, входит ли w в обход.
+     *
+     * Уровни с большим числом вершин делятся между потоками пула.
+     */
+    template<class Claim>
+    static void reach(const CSRGraph<T>& direction, std::vector<int> frontier, ThreadPool& pool,
+                      ParallelState& state, Claim claim) {
+        auto expand = [&](int begin, int end, std::vector<int>& next) {
+            for (int i = begin; i < end; ++i) {
+                int u = frontier[i];
+                for (int e = direction.rowBegin(u); e < direction.rowEnd(u); ++e) {
+                    int w = direction.getTarget(e);
+                    if (claim(w)) next.push_back(w);
+                }
+            }
+        };
+        while (!frontier.empty()) {
+            int size = int(frontier.size());
+            if (size < PARALLEL_GRAIN) {
+                expand(0, size, state.next[0]);
+            } else {
+                int chunks = (size + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+                pool.parallelFor(chunks, 1, [&](int chunk, unsigned worker) {
+                    expand(chunk * PARALLEL_GRAIN, std::min(size, (chunk + 1) * PARALLEL_GRAIN), state.next[worker]);
+                });
+            }
+            frontier.clear();
+            for (std::vector<int>& next : state.next) {
+                frontier.insert(frontier.end(), next.begin(), next.end());
+                next.clear();
+            }
+        }
+    }
+
+    /**
+     * @brief Выделяет компоненту опорной вершины и делит остаток подзадачи на три части.
+     */
+    static std::vector<Part> forwardBackward(const CSRGraph<T>& graph, const CSRGraph<T>& transpose,
+                                             ThreadPool& pool, ParallelState& state, const Part& part,
+                                             int& nextColor) {
+        const int color = part.color;
+        const int forward = nextColor++;
+        const int backward = nextColor++;
+        const int pivot = part.vertices[part.vertices.size() / 2];
+        std::atomic<int>* colors = state.colors.get();
+
+        // Прямой обход: color -> forward
+        colors[pivot].store(forward, std::memory_order_relaxed);
+        reach(graph, {pivot}, pool, state, [&](int w) {
+            int expected = color;
+            return colors[w].compare_exchange_strong(expected, forward, std::memory_order_relaxed);
+        });
+
+        // Обратный обход: forward -> DONE (компонента опорной вершины), color -> backward
+        colors[pivot].store(DONE, std::memory_order_relaxed);
+        state.representatives[pivot] = pivot;
+        reach(transpose, {pivot}, pool, state, [&](int w) {
+            int expected = forward;
+            if (colors[w].compare_exchange_strong(expected, DONE, std::memory_order_relaxed)) {
+                state.representatives[w] = pivot;
+                return true;
+            }
+            expected = color;
+            return colors[w].compare_exchange_strong(expected, backward, std::memory_order_relaxed);
+        });
 
-                dfs_second_pass(v);
-                sccList.append(scc); // Добавляем найденную компоненту в список
+        std::vector<Part> pieces(3);
+        pieces[0].color = forward;
+        pieces[1].color = backward;
+        pieces[2].color = color;
+        for (int v : part.vertices) {
+            int current = colors[v].load(std::memory_order_relaxed);
+            if (current == forward) {
+                pieces[0].vertices.push_back(v);
+            } else if (current == backward) {
+                pieces[1].vertices.push_back(v);
+            } else if (current == color) {
+                pieces[2].vertices.push_back(v);
             }
         }
+        std::vector<Part> result;
+        for (Part& piece : pieces) {
+            if (!piece.vertices.empty()) result.push_back(std::move(piece));
+        }
+        return result;
+    }
+
+    // Тарьян внутри подзадачи; rindex — буфер потока длины V, после работы снова обнулён
+    static void solveSerially(const CSRGraph<T>& graph, const Part& part, DynamicArray<int>& rindex,
+                              ParallelState& state) {
+        if (rindex.getSize() != graph.getVertexCount()) {
+            rindex = DynamicArray<int>(graph.getVertexCount());
+        }
+        const int size = int(part.vertices.size());
+        const int color = part.color;
+        int count = tarjan(graph, size, size, [&](int i) { return part.vertices[i]; },
+                           [&](int w) { return state.colors[w].load(std::memory_order_relaxed) == color; },
+                           rindex);
 
-        return sccList; // Возвращаем список всех сильно связанных компонент
+        std::vector<int> representativeOf(count, -1);
+        for (int v : part.vertices) {
+            int local = rindex[v] - (size - count);
+            if (representativeOf[local] == -1) representativeOf[local] = v;
+            state.representatives[v] = representativeOf[local];
+            rindex[v] = 0;
+        }
     }
 
 };
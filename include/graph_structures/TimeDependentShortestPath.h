@@ -0,0 +1,291 @@
+#ifndef TIME_DEPENDENT_SHORTEST_PATH_H
+#define TIME_DEPENDENT_SHORTEST_PATH_H
+
+#include "Graph.h"
+#include "ShortestPath.h"
+#include "../sequence/ArraySequence.h"
+#include "../sequence/DynamicArray.h"
+#include "../sequence/IndexedPriorityQueue.h"
+#include "../sequence/Pair.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Граф, рёбра которого имеют кусочно-линейные функции времени проезда.
+ *
+ * Профиль ребра задаётся точками излома (время отправления, время проезда), упорядоченными
+ * по времени отправления; между точками время проезда интерполируется линейно, до первой
+ * и после последней точки остаётся постоянным. Профили обязаны обладать свойством FIFO:
+ * выехавший позже не приезжает раньше, то есть время прибытия t + f(t) не убывает.
+ *
+ * Рёбра хранятся в формате CSR, а точки всех профилей — в двух непрерывных массивах
+ * (времена отправления отдельно от времён проезда, чтобы двоичный поиск читал только первые);
+ * точки ребра e занимают диапазон [pointOffsets[e], pointOffsets[e + 1]).
+ *
+ * @tparam T Тип времени (арифметический; для целых типов интерполяция округляется к нулю).
+ */
+template<typename T>
+class TimeDependentGraph {
+    static_assert(std::is_arithmetic<T>::value, "Time type must be numeric");
+
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+    typedef ArraySequence<Pair<T, T>> Profile; /**< Точки излома (время отправления, время проезда). */
+
+    /**
+     * @brief Граф с постоянными временами проезда, равными весам рёбер исходного графа.
+     */
+    explicit TimeDependentGraph(const Graph<T>& graph)
+            : TimeDependentGraph(graph, [](Vertex, Vertex, const T& weight) {
+                  Profile profile;
+                  profile.append(Pair<T, T>(T(0), weight));
+                  return profile;
+              }) {}
+
+    /**
+     * @brief Строит граф по топологии исходного графа и функции, задающей профиль каждого ребра.
+     *
+     * @param graph Исходный граф; его веса передаются в makeProfile.
+     * @param makeProfile Вызываемый объект Profile(from, to, weight).
+     *
+     * @throws std::invalid_argument Если профиль пуст, точки не упорядочены, время проезда
+     *                               отрицательно или нарушено свойство FIFO.
+     */
+    template<class MakeProfile>
+    TimeDependentGraph(const Graph<T>& graph, MakeProfile makeProfile)
+            : vertexCount(graph.getVertexCount()), offsets(graph.getVertexCount() + 1) {
+        std::vector<std::pair<Vertex, Profile>> row;
+        std::vector<std::pair<Vertex, Profile>> edges;
+        for (Vertex u = 0; u < vertexCount; ++u) {
+            row.clear();
+            graph.forEachNeighbor(u, [&](Vertex v, const T& weight) {
+                Profile profile = makeProfile(u, v, weight);
+                validateProfile(profile);
+                row.emplace_back(v, std::move(profile));
+            });
+            std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            offsets[u + 1] = offsets[u] + int(row.size());
+            for (auto& edge : row) {
+                edges.push_back(std::move(edge));
+            }
+        }
+
+        int edgeCount = offsets[vertexCount];
+        targets = DynamicArray<int>(edgeCount);
+        pointOffsets = DynamicArray<int>(edgeCount + 1);
+        for (int e = 0; e < edgeCount; ++e) {
+            targets[e] = edges[e].first;
+            pointOffsets[e + 1] = pointOffsets[e] + edges[e].second.getLength();
+        }
+        departures = DynamicArray<T>(pointOffsets[edgeCount]);
+        travelTimes = DynamicArray<T>(pointOffsets[edgeCount]);
+        for (int e = 0; e < edgeCount; ++e) {
+            for (int i = 0; i < edges[e].second.getLength(); ++i) {
+                departures[pointOffsets[e] + i] = edges[e].second[i].first;
+                travelTimes[pointOffsets[e] + i] = edges[e].second[i].second;
+            }
+        }
+    }
+
+    int getVertexCount() const {
+        return vertexCount;
+    }
+
+    int getEdgeCount() const {
+        return offsets[vertexCount];
+    }
+
+    /**
+     * @brief Общее число точек излома всех профилей.
+     */
+    int getBreakpointCount() const {
+        return departures.getSize();
+    }
+
+    /**
+     * @brief Время проезда по ребру from -> to при отправлении в момент departure.
+     *
+     * @throws std::invalid_argument Если ребра нет.
+     */
+    T travelTime(Vertex from, Vertex to, T departure) const {
+        int edge = findEdge(from, to);
+        if (edge == -1) {
+            throw std::invalid_argument("Edge not found");
+        }
+        return evaluate(edge, departure);
+    }
+
+    /**
+     * @brief Вызывает func(to, arrival) для каждого ребра вершины при отправлении в момент departure.
+     */
+    template<class Func>
+    void forEachArrival(Vertex vertex, T departure, Func&& func) const {
+        for (int e = offsets[vertex]; e < offsets[vertex + 1]; ++e) {
+            T time = evaluate(e, departure);
+            func(targets[e], time > std::numeric_limits<T>::max() - departure
+                             ? std::numeric_limits<T>::max() : departure + time);
+        }
+    }
+
+private:
+    int vertexCount;
+    DynamicArray<int> offsets;       // Рёбра вершины v: [offsets[v], offsets[v + 1])
+    DynamicArray<int> targets;
+    DynamicArray<int> pointOffsets;  // Точки ребра e: [pointOffsets[e], pointOffsets[e + 1])
+    DynamicArray<T> departures;
+    DynamicArray<T> travelTimes;
+
+    static void validateProfile(const Profile& profile) {
+        if (profile.getLength() == 0) {
+            throw std::invalid_argument("Travel time profile must not be empty");
+        }
+        for (int i = 0; i < profile.getLength(); ++i) {
+            if (profile[i].second < T(0)) {
+                throw std::invalid_argument("Travel time must be non-negative");
+            }
+            if (i == 0) continue;
+            if (!(profile[i - 1].first < profile[i].first)) {
+                throw std::invalid_argument("Profile departures must be strictly increasing");
+            }
+            if (profile[i].first + profile[i].second < profile[i - 1].first + profile[i - 1].second) {
+                throw std::invalid_argument("Profile violates the FIFO property");
+            }
+        }
+    }
+
+    int findEdge(Vertex from, Vertex to) const {
+        if (from < 0 || from >= vertexCount || offsets[from] == offsets[from + 1]) return -1;
+        const int* row = &targets[offsets[from]];
+        int length = offsets[from + 1] - offsets[from];
+        int found = int(std::lower_bound(row, row + length, to) - row);
+        return found < length && row[found] == to ? offsets[from] + found : -1;
+    }
+
+    T evaluate(int edge, T departure) const {
+        int first = pointOffsets[edge];
+        int last = pointOffsets[edge + 1] - 1;
+        if (!(departures[first] < departure)) return travelTimes[first];
+        if (!(departure < departures[last])) return travelTimes[last];
+
+        // Первая точка с отправлением позже departure; отрезок [segment - 1, segment]
+        const T* points = &departures[first];
+        int segment = first + int(std::upper_bound(points, points + (last - first + 1), departure) - points);
+        T d0 = departures[segment - 1];
+        T d1 = departures[segment];
+        T t0 = travelTimes[segment - 1];
+        T t1 = travelTimes[segment];
+        if constexpr (std::is_integral<T>::value) {
+            // Произведение двух интервалов не помещается в T уже для суточного профиля в секундах
+            long long delta = ((long long) t1 - t0) * ((long long) departure - d0) / ((long long) d1 - d0);
+            return T(t0 + delta);
+        } else {
+            return t0 + (t1 - t0) * (departure - d0) / (d1 - d0);
+        }
+    }
+};
+
+/**
+ * @brief Поиск путей с наиболее ранним прибытием в графе с зависящими от времени весами.
+ *
+ * Алгоритм Дейкстры, в котором меткой вершины служит время прибытия, а вес ребра
+ * вычисляется в момент отправления из его начала. Благодаря свойству FIFO ожидание
+ * в вершинах не даёт выигрыша, и найденные времена прибытия оптимальны.
+ *
+ * @tparam T Тип времени.
+ */
+template<typename T>
+class TimeDependentShortestPath {
+public:
+    typedef int Vertex; /**< Тип для обозначения вершины графа. */
+
+    /**
+     * @brief Наиболее ранние времена прибытия во все вершины при отправлении из source в момент departure.
+     *
+     * @return ArraySequence<Pair<T, Vertex>> Время прибытия (максимум типа для недостижимых вершин)
+     *         и предшественник для каждой вершины; совместимо с `ShortestPath::getPath`.
+     *
+     * @throws std::out_of_range Если исходная вершина находится вне допустимого диапазона.
+     */
+    static ArraySequence<Pair<T, Vertex>> earliestArrival(const TimeDependentGraph<T>& graph, Vertex source,
+                                                          T departure) {
+        Search search(graph, source, departure);
+        search.run(-1);
+        ArraySequence<Pair<T, Vertex>> result;
+        for (Vertex v = 0; v < graph.getVertexCount(); ++v) {
+            result.append(Pair<T, Vertex>(search.arrivals[v], search.predecessors[v]));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Самый быстрый путь между двумя вершинами при отправлении в момент departure.
+     *
+     * Поиск останавливается, как только цель извлечена из очереди.
+     *
+     * @return ShortestPath<T>::PathResult В поле distance — время в пути (прибытие минус отправление).
+     *
+     * @throws std::out_of_range Если вершины находятся вне допустимого диапазона.
+     */
+    static typename ShortestPath<T>::PathResult query(const TimeDependentGraph<T>& graph, Vertex source,
+                                                      Vertex target, T departure) {
+        if (target < 0 || target >= graph.getVertexCount()) {
+            throw std::out_of_range("Target vertex is out of range");
+        }
+        Search search(graph, source, departure);
+        typename ShortestPath<T>::PathResult result;
+        result.settled = search.run(target);
+        if (search.arrivals[target] == std::numeric_limits<T>::max()) return result;
+
+        result.found = true;
+        result.distance = search.arrivals[target] - departure;
+        for (Vertex v = target; v != -1; v = search.predecessors[v]) {
+            result.path.prepend(v);
+        }
+        return result;
+    }
+
+private:
+    struct Search {
+        const TimeDependentGraph<T>& graph;
+        std::vector<T> arrivals;
+        std::vector<Vertex> predecessors;
+        IndexedPriorityQueue<T> queue;
+
+        Search(const TimeDependentGraph<T>& graph, Vertex source, T departure)
+                : graph(graph), arrivals(graph.getVertexCount(), std::numeric_limits<T>::max()),
+                  predecessors(graph.getVertexCount(), -1), queue(graph.getVertexCount()) {
+            if (source < 0 || source >= graph.getVertexCount()) {
+                throw std::out_of_range("Source vertex is out of range");
+            }
+            arrivals[source] = departure;
+            queue.Enqueue(source, departure);
+        }
+
+        // Возвращает число извлечённых вершин; target == -1 — обойти весь граф
+        int run(Vertex target) {
+            int settled = 0;
+            while (!queue.isEmpty()) {
+                Vertex u = queue.Dequeue().first;
+                ++settled;
+                if (u == target) break;
+                graph.forEachArrival(u, arrivals[u], [&](Vertex v, T arrival) {
+                    if (!(arrival < arrivals[v])) return;
+                    arrivals[v] = arrival;
+                    predecessors[v] = u;
+                    if (queue.contains(v)) {
+                        queue.decreaseKey(v, arrival);
+                    } else {
+                        queue.Enqueue(v, arrival);
+                    }
+                });
+            }
+            return settled;
+        }
+    };
+};
+
+#endif //TIME_DEPENDENT_SHORTEST_PATH_H
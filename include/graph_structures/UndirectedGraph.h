@@ -2,7 +2,6 @@
 #define UNDIRECTEDGRAPH_H
 
 #include "Graph.h"
-#include <set>
 #include "DirectedGraph.h"
 
 /**
@@ -55,6 +54,12 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Конструктор перемещения и оператор перемещения.
+     */
+    UndirectedGraph(UndirectedGraph<T> &&graph) noexcept = default;
+    UndirectedGraph<T> &operator=(UndirectedGraph<T> &&graph) noexcept = default;
+
     /**
      * @brief Добавляет ребро между двумя вершинами с указанным весом.
      *
@@ -121,6 +126,16 @@ public:
         return directedGraph.getNeighbors(vertex);
     }
 
+    /**
+     * @brief Обходит рёбра, инцидентные вершине, без копирования списка смежности.
+     *
+     * @param vertex Вершина, соседей которой необходимо обойти.
+     * @param visitor Посетитель, вызываемый для каждой пары (сосед, вес).
+     */
+    void visitNeighbors(int vertex, typename Graph<T>::NeighborVisitor &visitor) const override {
+        directedGraph.visitNeighbors(vertex, visitor);
+    }
+
     /**
      * @brief Возвращает вес ребра между двумя вершинами.
      *
@@ -174,21 +189,14 @@ public:
      */
     ArraySequence<std::tuple<int, int, T>> getEdges() const override {
         ArraySequence<std::tuple<int, int, T>> edges;
-        std::set<std::pair<int, int>> seen; // Для избегания дублирования рёбер
-        auto adjacencyList=directedGraph.getAdjacencyList();
-        auto keys = adjacencyList.GetKeys();
-        for (int i = 0; i < keys.getLength(); ++i) {
-            int from = keys[i];
-            auto neighborDict = adjacencyList.Get(from);
-            auto neighbors = neighborDict.GetKeys();
-            for (int j = 0; j < neighbors.getLength(); ++j) {
-                int to = neighbors[j];
-                if (from < to && seen.find(std::make_pair(from, to)) == seen.end()) {
-                    T weight = neighborDict.Get(to);
+        int vertexCount = directedGraph.getVertexCount();
+        for (int from = 0; from < vertexCount; ++from) {
+            // Каждое ребро хранится в обоих направлениях, берём только from < to
+            directedGraph.forEachNeighbor(from, [&edges, from](int to, const T &weight) {
+                if (from < to) {
                     edges.append(std::make_tuple(from, to, weight));
-                    seen.emplace(from, to); // Помечаем ребро как обработанное
                 }
-            }
+            });
         }
 
         return edges;
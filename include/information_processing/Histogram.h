@@ -4,6 +4,7 @@
 #include <functional>
 #include <optional>
 #include <algorithm>
+#include <vector>
 #include "../data_structures/IDictionaryBinaryTree.h"
 
 template <typename T, typename ClassReturn, typename Class>
@@ -34,9 +35,21 @@ public:
               Criteria criteria,
               Classifier classifier)
             : criteria(criteria), classifier(classifier) {
+        // Диапазоны сортируются один раз, после чего дерево строится за O(n)
+        std::vector<Range> sortedRanges;
+        sortedRanges.reserve(ranges.getLength());
         for (int i = 0; i < ranges.getLength(); ++i) {
-            histogram.Add(ranges[i], IDictionaryBinaryTree<ClassReturn, Stats>());
+            sortedRanges.push_back(ranges[i]);
         }
+        std::sort(sortedRanges.begin(), sortedRanges.end());
+        for (size_t i = 1; i < sortedRanges.size(); ++i) {
+            if (sortedRanges[i - 1] == sortedRanges[i]) {
+                throw std::invalid_argument("Key already exists");
+            }
+        }
+        histogram.BuildFromSorted((int) sortedRanges.size(),
+                                  [&sortedRanges](int i) -> const Range& { return sortedRanges[i]; },
+                                  [](int) { return IDictionaryBinaryTree<ClassReturn, Stats>(); });
         buildHistogram(sequence);
     }
 
@@ -46,12 +59,12 @@ public:
 
 private:
     void buildHistogram(const ArraySequence<Class>& sequence) {
+        auto rangeKeys = histogram.GetKeys();
         for (int i = 0; i < sequence.getLength(); ++i) {
             const Class& item = sequence[i];
             T value = criteria(item);
             ClassReturn className = classifier(item);
 
-            auto rangeKeys = histogram.GetKeys();
             for (int j = 0; j < rangeKeys.getLength(); ++j) {
                 const auto& range = rangeKeys[j];
 
@@ -1,10 +1,13 @@
 #ifndef LAB3_SEM3_INDEX_H
 #define LAB3_SEM3_INDEX_H
 
+#include <algorithm>
 #include <functional>
 #include <stdexcept>
 #include <tuple>
 #include <optional>
+#include <utility>
+#include <vector>
 #include "../sequence/ArraySequence.h"
 #include "../data_structures/IDictionaryBinaryTree.h"
 
@@ -20,10 +23,21 @@ public:
             const ArraySequence<TValue>& data,
             std::tuple<std::function<TKeyParts(const TValue&)>...> keyExtractors)
     : keyExtractors(std::move(keyExtractors)) {
+        // Ключи сортируются один раз, после чего дерево индекса строится за O(n)
+        std::vector<std::pair<TKey, int>> keys;
+        keys.reserve(data.getLength());
         for (int i = 0; i < data.getLength(); ++i) {
-            const TValue& item = data.get(i);
-            Add(item);
+            keys.emplace_back(createCompositeKey(data.get(i)), i);
         }
+        std::sort(keys.begin(), keys.end());
+        for (size_t i = 1; i < keys.size(); ++i) {
+            if (keys[i - 1].first == keys[i].first) {
+                throw std::invalid_argument("Key already exists");
+            }
+        }
+        index.BuildFromSorted((int) keys.size(),
+                              [&keys](int i) -> const TKey& { return keys[i].first; },
+                              [&keys, &data](int i) { return data.get(keys[i].second); });
     }
 
     void Add(const TValue& value) {
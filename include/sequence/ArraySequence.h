@@ -25,6 +25,13 @@ public:
 
     // Constructor from a DynamicArray
     explicit ArraySequence(const DynamicArray<T> &array) : data(array) {}
+    explicit ArraySequence(DynamicArray<T> &&array) noexcept : data(std::move(array)) {}
+
+    // Copy and move semantics (moves only steal the underlying buffer)
+    ArraySequence(const ArraySequence<T> &other) = default;
+    ArraySequence(ArraySequence<T> &&other) noexcept = default;
+    ArraySequence<T> &operator=(const ArraySequence<T> &other) = default;
+    ArraySequence<T> &operator=(ArraySequence<T> &&other) noexcept = default;
 
     // Decomposition Methods
 
@@ -65,11 +72,12 @@ public:
             throw std::out_of_range("Invalid indices for subsequence");
         }
         int size = endIndex - startIndex + 1;
-        DynamicArray<T> da(size);
+        DynamicArray<T> da;
+        da.reserve(size);
         for (int i = 0; i < size; ++i) {
-            da[i] = get(startIndex + i);
+            da.append(data.get(startIndex + i));
         }
-        return new ArraySequence<T>(da);
+        return new ArraySequence<T>(std::move(da));
     }
 
     // Gets the current length of the sequence
@@ -81,37 +89,20 @@ public:
 
     // Appends an item to the end of the sequence
     void append(T item) override {
-        int size = data.getSize();
-        data.resize(size + 1);
-        data.set(size, item);
+        data.append(std::move(item));
     }
 
     // Prepends an item to the beginning of the sequence
     void prepend(T item) override {
-        int size = data.getSize();
-        data.resize(size + 1);
-        data.define_resize(size + 1);
-        // Shift elements to the right
-        for(int i = size -1; i >=0; --i){
-            data[i + 1] = data[i];
-        }
-        data.set(0, item);
-        data.define_set(0, true);
+        data.insertAt(0, std::move(item));
     }
 
     // Inserts an item at a specific index
     void insertAt(T item, int index) override {
-        int size = data.getSize();
-        if(index < 0 || index > size){
+        if(index < 0 || index > data.getSize()){
             throw std::out_of_range("Index out of range");
         }
-        data.resize(size + 1);
-        data.define_resize(size + 1);
-        // Shift elements to the right from index
-        for(int i = size -1; i >= index; --i){
-            data[i +1] = data[i];
-        }
-        data.set(index, item);
+        data.insertAt(index, std::move(item));
     }
 
     // Concatenates another sequence to this sequence
@@ -120,33 +111,26 @@ public:
             throw std::invalid_argument("List to concatenate is null");
         }
 
-        int newSize = getLength() + list->getLength();
-        DynamicArray<T> da(newSize);
-        // Copy existing elements
-        for (int i = 0; i < getLength(); ++i) {
-            da[i] = data.get(i);
-            da.define_set(i, true);
+        // One allocation for both halves
+        DynamicArray<T> da;
+        da.reserve(getLength() + list->getLength());
+        for (int i = 0; i < data.getSize(); ++i) {
+            da.append(data[i]);
         }
         // Copy elements from the other list
         for (int i = 0; i < list->getLength(); ++i) {
-            da[i + getLength()] = list->get(i);
-            da.define_set(i + getLength(), true);
+            da.append(list->get(i));
         }
 
-        return new ArraySequence<T>(da);
+        return new ArraySequence<T>(std::move(da));
     }
 
     // Removes an element at a specific index
     void removeAt(int index) override {
-        int size = data.getSize();
-        if(index <0 || index >= size){
+        if(index <0 || index >= data.getSize()){
             throw std::out_of_range("Index out of range in removeAt");
         }
-        for (int i = index + 1; i < size; ++i) {
-            data[i - 1] = data[i];
-        }
-        data.define_resize(size - 1);
-        data.resize(size - 1);
+        data.removeAt(index);
     }
 
     // Clears the sequence
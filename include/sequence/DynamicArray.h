@@ -1,16 +1,20 @@
 #ifndef DYNAMICARRAY_INCLUDED
 #define DYNAMICARRAY_INCLUDED
 
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 template<class T>
 class DynamicArray {
 private:
     int size;
     int capacity;  // Current capacity of the array
-    T *data;
-    bool *defined;  // Indicates if an element is defined
+    T *data;       // Raw storage: only elements [0, size) are constructed
 
     void checkIndex(int index) const {
         if (index < 0 || index >= size) {
@@ -19,29 +23,73 @@ private:
         }
     }
 
-    // Increases the capacity of the array if necessary
-    void ensureCapacity(int minCapacity) {
-        if (minCapacity > capacity) {
-            int newCapacity = (minCapacity > capacity * 2) ? minCapacity : capacity * 2;
-            T *newData = new T[newCapacity];
-            bool *newDefined = new bool[newCapacity];
+    static T *allocate(int count) {
+        return count > 0 ? std::allocator<T>().allocate(count) : nullptr;
+    }
+
+    static void deallocate(T *storage, int count) {
+        if (storage) std::allocator<T>().deallocate(storage, count);
+    }
 
-            // Copy existing data to the new array
-            for (int i = 0; i < size; ++i) {
-                newData[i] = data[i];
-                newDefined[i] = defined[i];
+    // Destroys constructed elements in [from, to)
+    static void destroy(T *storage, int from, int to) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (int i = from; i < to; ++i) {
+                storage[i].~T();
             }
+        }
+    }
 
-            // Initialize the new elements as undefined
-            for (int i = size; i < newCapacity; ++i) {
-                newDefined[i] = false;
+    // Copy-constructs count elements from source into raw storage; if a copy throws,
+    // the elements built so far are destroyed and the storage is left raw
+    static void copyConstruct(T *destination, const T *source, int count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count > 0) std::memcpy(static_cast<void *>(destination), source, sizeof(T) * count);
+        } else {
+            int i = 0;
+            try {
+                for (; i < count; ++i) {
+                    new(destination + i) T(source[i]);
+                }
+            } catch (...) {
+                destroy(destination, 0, i);
+                throw;
             }
+        }
+    }
 
-            delete[] data;
-            delete[] defined;
+    // Moves count elements into raw storage, then destroys the originals; if a copy
+    // (the fallback for throwing moves) throws, the source is left intact
+    static void relocate(T *destination, T *source, int count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count > 0) std::memcpy(static_cast<void *>(destination), source, sizeof(T) * count);
+        } else {
+            int i = 0;
+            try {
+                for (; i < count; ++i) {
+                    new(destination + i) T(std::move_if_noexcept(source[i]));
+                }
+            } catch (...) {
+                destroy(destination, 0, i);
+                throw;
+            }
+            destroy(source, 0, count);
+        }
+    }
 
+    // Increases the capacity of the array if necessary
+    void ensureCapacity(int minCapacity) {
+        if (minCapacity > capacity) {
+            int newCapacity = (minCapacity > capacity * 2) ? minCapacity : capacity * 2;
+            T *newData = allocate(newCapacity);
+            try {
+                relocate(newData, data, size);
+            } catch (...) {
+                deallocate(newData, newCapacity);
+                throw;
+            }
+            deallocate(data, capacity);
             data = newData;
-            defined = newDefined;
             capacity = newCapacity;
         }
     }
@@ -50,80 +98,106 @@ public:
     // Constructors
 
     // Constructor with items and count
-    DynamicArray(T *items, int count) : size(count), capacity(count) {
-        if (size < 0) throw std::invalid_argument("Size < 0");
-        data = new T[capacity];
-        defined = new bool[capacity];
-        for (int i = 0; i < size; ++i) {
-            data[i] = items[i];
-            defined[i] = true;
+    DynamicArray(T *items, int count) : size(0), capacity(count), data(nullptr) {
+        if (count < 0) throw std::invalid_argument("Size < 0");
+        data = allocate(capacity);
+        try {
+            copyConstruct(data, items, count);
+        } catch (...) {
+            deallocate(data, capacity);
+            throw;
         }
+        size = count;
     }
-    DynamicArray(T items, int count) : size(count), capacity(count) {
-        if (size < 0) throw std::invalid_argument("Size < 0");
-        data = new T[capacity];
-        defined = new bool[capacity];
-        for (int i = 0; i < size; ++i) {
-            data[i] = items;
-            defined[i] = true;
+    DynamicArray(T items, int count) : size(0), capacity(count), data(nullptr) {
+        if (count < 0) throw std::invalid_argument("Size < 0");
+        data = allocate(capacity);
+        try {
+            for (; size < count; ++size) {
+                new(data + size) T(items);
+            }
+        } catch (...) {
+            destroy(data, 0, size);
+            deallocate(data, capacity);
+            throw;
         }
     }
 
-    // Default constructor with optional initial count
-    explicit DynamicArray(int count = 0) : size(count), capacity(count > 0 ? count : 1) {
-        if (size < 0) throw std::invalid_argument("Count < 0");
-        data = new T[capacity];
-        defined = new bool[capacity];
-        for (int i = 0; i < size; ++i) {
-            defined[i] = false;
+    // Default constructor with optional initial count of value-initialized elements
+    explicit DynamicArray(int count = 0) : size(0), capacity(count), data(nullptr) {
+        if (count < 0) throw std::invalid_argument("Count < 0");
+        data = allocate(capacity);
+        try {
+            for (; size < count; ++size) {
+                new(data + size) T();
+            }
+        } catch (...) {
+            destroy(data, 0, size);
+            deallocate(data, capacity);
+            throw;
         }
     }
 
     // Copy constructor
-    DynamicArray(const DynamicArray<T> &dynamicArray) : size(dynamicArray.size), capacity(dynamicArray.capacity) {
-        data = new T[capacity];
-        defined = new bool[capacity];
-        for (int i = 0; i < size; ++i) {
-            data[i] = dynamicArray.data[i];
-            defined[i] = dynamicArray.defined[i];
+    DynamicArray(const DynamicArray<T> &dynamicArray)
+            : size(dynamicArray.size), capacity(dynamicArray.size), data(allocate(dynamicArray.size)) {
+        try {
+            copyConstruct(data, dynamicArray.data, size);
+        } catch (...) {
+            deallocate(data, capacity);
+            throw;
         }
     }
 
+    // Move constructor
+    DynamicArray(DynamicArray<T> &&dynamicArray) noexcept
+            : size(dynamicArray.size), capacity(dynamicArray.capacity), data(dynamicArray.data) {
+        dynamicArray.size = 0;
+        dynamicArray.capacity = 0;
+        dynamicArray.data = nullptr;
+    }
+
     // Copy assignment operator
     DynamicArray<T> &operator=(const DynamicArray<T> &dynamicArray) {
         if (this == &dynamicArray)
             return *this;
 
-        delete[] data;
-        delete[] defined;
+        DynamicArray<T> copy(dynamicArray);
+        swap(copy);
+        return *this;
+    }
 
-        size = dynamicArray.size;
-        capacity = dynamicArray.capacity;
-        data = new T[capacity];
-        defined = new bool[capacity];
-        for (int i = 0; i < size; ++i) {
-            data[i] = dynamicArray.data[i];
-            defined[i] = dynamicArray.defined[i];
+    // Move assignment operator
+    DynamicArray<T> &operator=(DynamicArray<T> &&dynamicArray) noexcept {
+        if (this != &dynamicArray) {
+            destroy(data, 0, size);
+            deallocate(data, capacity);
+            size = dynamicArray.size;
+            capacity = dynamicArray.capacity;
+            data = dynamicArray.data;
+            dynamicArray.size = 0;
+            dynamicArray.capacity = 0;
+            dynamicArray.data = nullptr;
         }
         return *this;
     }
 
     // Destructor
     ~DynamicArray() {
-        delete[] data;
-        delete[] defined;
+        destroy(data, 0, size);
+        deallocate(data, capacity);
     }
 
-    // Clears the array and resets to initial state
-    void clear() {
-        delete[] data;
-        delete[] defined;
+    void swap(DynamicArray<T> &other) noexcept {
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+        std::swap(data, other.data);
+    }
 
-        // Reset array to initial state
+    // Clears the array, keeping the allocated storage
+    void clear() {
+        destroy(data, 0, size);
         size = 0;
-        capacity = 1;
-        data = new T[capacity];
-        defined = new bool[capacity]{false};
     }
 
     // Decomposition Methods
@@ -131,18 +205,12 @@ public:
     // Gets element at index with bounds checking
     T &get(int index) {
         checkIndex(index);
-        if (!defined[index]) {
-            throw std::runtime_error("Element with index not defined");
-        }
         return data[index];
     }
 
     // Gets element at index with bounds checking (const version)
     const T &get(int index) const {
         checkIndex(index);
-        if (!defined[index]) {
-            throw std::runtime_error("Element with index not defined");
-        }
         return data[index];
     }
 
@@ -151,60 +219,84 @@ public:
         return size;
     }
 
+    // Gets the number of elements that fit without reallocation
+    int getCapacity() const {
+        return capacity;
+    }
+
     // Operation Methods
 
     // Sets the value at a specific index with bounds checking
     void set(int index, T value) {
         checkIndex(index);
-        data[index] = value;
-        defined[index] = true;
+        data[index] = std::move(value);
     }
 
     // Overloaded subscript operator (const)
-    T operator[](int index) const {
+    const T &operator[](int index) const {
         return get(index);
     }
 
     // Overloaded subscript operator (non-const)
     T &operator[](int index) {
         checkIndex(index);
-        defined[index] = true;
         return data[index];
     }
 
-    // Resizes the array to a new size, initializing new elements as undefined
+    // Reserves storage for at least newCapacity elements
+    void reserve(int newCapacity) {
+        if (newCapacity < 0) throw std::invalid_argument("Negative capacity error");
+        ensureCapacity(newCapacity);
+    }
+
+    // Resizes the array; new elements are value-initialized
     void resize(int newSize) {
         if (newSize < 0) throw std::invalid_argument("Negative size error");
+        if (newSize < size) {
+            destroy(data, newSize, size);
+            size = newSize;
+            return;
+        }
         ensureCapacity(newSize);
-        // Initialize new elements as undefined
-        for (int i = size; i < newSize; ++i) {
-            defined[i] = false;
+        for (; size < newSize; ++size) {
+            new(data + size) T();
         }
-        size = newSize;
     }
 
-    // Shifts the defined flags when resizing (used in prepend and insertAt)
-    void define_resize(int newSize) {
-        if (newSize < 0) throw std::invalid_argument("Negative size error");
-        if (newSize > size) {
-            // Shift defined flags to the right, starting from newSize-1 down to 1
-            for(int i = newSize -1; i >=1; --i){
-                defined[i] = defined[i -1];
-            }
-            // Set the first element as undefined
-            if(newSize >0)
-                defined[0] = false;
+    // Appends an element, growing the storage geometrically
+    void append(T value) {
+        ensureCapacity(size + 1);
+        new(data + size) T(std::move(value));
+        ++size;
+    }
+
+    // Inserts an element at index, shifting the tail to the right
+    void insertAt(int index, T value) {
+        if (index < 0 || index > size) {
+            throw std::out_of_range("Index out of range");
+        }
+        if (index == size) {
+            append(std::move(value));
+            return;
+        }
+        ensureCapacity(size + 1);
+        new(data + size) T(std::move(data[size - 1]));
+        for (int i = size - 1; i > index; --i) {
+            data[i] = std::move(data[i - 1]);
         }
+        data[index] = std::move(value);
+        ++size;
     }
 
-    // Sets the defined flag for a specific index
-    void define_set(int index, bool value) {
-        if (index >= 0 && index < size) {
-            defined[index] = value;
-        } else {
-            throw std::out_of_range("Index out of range in define_set");
+    // Removes the element at index, shifting the tail to the left
+    void removeAt(int index) {
+        checkIndex(index);
+        for (int i = index + 1; i < size; ++i) {
+            data[i - 1] = std::move(data[i]);
         }
+        destroy(data, size - 1, size);
+        --size;
     }
 };
 
-#endif // DYNAMICARRAY_INCLUDED
\ No newline at end of file
+#endif // DYNAMICARRAY_INCLUDED
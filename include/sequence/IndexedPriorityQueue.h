@@ -0,0 +1,196 @@
+#ifndef LAB4_SEM3_INDEXEDPRIORITYQUEUE_H
+#define LAB4_SEM3_INDEXEDPRIORITYQUEUE_H
+
+#include "DynamicArray.h"
+#include "Pair.h"
+#include <stdexcept>
+
+/**
+ * @brief Индексированная d-арная куча (очередь с минимальным приоритетом).
+ *
+ * Элементами очереди являются целые числа из диапазона [0, capacity) — например,
+ * номера вершин графа. Для каждого элемента хранится его позиция в куче, поэтому
+ * поддерживаются `contains` и `decreaseKey` за O(1) и O(log_d n) соответственно.
+ * В отличие от `PriorityQueue`, первым извлекается элемент с наименьшим приоритетом.
+ *
+ * @tparam K Тип приоритета.
+ * @tparam Arity Число потомков у узла кучи (d >= 2).
+ */
+template<typename K, int Arity = 4>
+class IndexedPriorityQueue {
+    static_assert(Arity >= 2, "Heap arity must be at least 2");
+
+private:
+    DynamicArray<int> heap;       // Элементы в порядке кучи
+    DynamicArray<K> priorities;   // Приоритет каждого элемента
+    DynamicArray<int> positions;  // Позиция элемента в heap или -1, если его нет в очереди
+
+    void checkItem(int item) const {
+        if (item < 0) {
+            throw std::out_of_range("Item must be non-negative");
+        }
+    }
+
+    void place(int position, int item) {
+        heap[position] = item;
+        positions[item] = position;
+    }
+
+    void siftUp(int position) {
+        int item = heap[position];
+        const K priority = priorities[item];
+        while (position > 0) {
+            int parent = (position - 1) / Arity;
+            if (!(priority < priorities[heap[parent]])) break;
+            place(position, heap[parent]);
+            position = parent;
+        }
+        place(position, item);
+    }
+
+    void siftDown(int position) {
+        int count = heap.getSize();
+        int item = heap[position];
+        const K priority = priorities[item];
+        while (true) {
+            int first = position * Arity + 1;
+            if (first >= count) break;
+            int last = first + Arity < count ? first + Arity : count;
+            int best = first;
+            for (int child = first + 1; child < last; ++child) {
+                if (priorities[heap[child]] < priorities[heap[best]]) {
+                    best = child;
+                }
+            }
+            if (!(priorities[heap[best]] < priority)) break;
+            place(position, heap[best]);
+            position = best;
+        }
+        place(position, item);
+    }
+
+public:
+    /**
+     * @brief Создаёт пустую очередь для элементов из [0, capacity).
+     *
+     * Ёмкость увеличивается автоматически при добавлении элемента за её пределами.
+     */
+    explicit IndexedPriorityQueue(int capacity = 0) : priorities(capacity), positions(-1, capacity) {
+        heap.reserve(capacity);
+    }
+
+    /**
+     * @brief Добавляет элемент с заданным приоритетом.
+     *
+     * @throws std::invalid_argument Если элемент уже находится в очереди.
+     */
+    void Enqueue(int item, K priority) {
+        checkItem(item);
+        if (item >= positions.getSize()) {
+            int oldSize = positions.getSize();
+            int newSize = item + 1 > 2 * oldSize ? item + 1 : 2 * oldSize;
+            priorities.resize(newSize);
+            positions.resize(newSize);
+            for (int i = oldSize; i < newSize; ++i) {
+                positions[i] = -1;
+            }
+        }
+        if (positions[item] != -1) {
+            throw std::invalid_argument("Item already in queue");
+        }
+        priorities[item] = priority;
+        heap.append(item);
+        siftUp(heap.getSize() - 1);
+    }
+
+    /**
+     * @brief Извлекает элемент с наименьшим приоритетом.
+     *
+     * @return Pair<int, K> Пара (элемент, приоритет).
+     * @throws std::out_of_range Если очередь пуста.
+     */
+    Pair<int, K> Dequeue() {
+        if (heap.getSize() == 0) {
+            throw std::out_of_range("Queue is empty");
+        }
+        int top = heap[0];
+        Pair<int, K> result(top, priorities[top]);
+        int last = heap[heap.getSize() - 1];
+        heap.resize(heap.getSize() - 1);
+        positions[top] = -1;
+        if (heap.getSize() > 0) {
+            place(0, last);
+            siftDown(0);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Возвращает элемент с наименьшим приоритетом за O(1), не извлекая его.
+     *
+     * @throws std::out_of_range Если очередь пуста.
+     */
+    Pair<int, K> PeekFirst() const {
+        if (heap.getSize() == 0) {
+            throw std::out_of_range("Queue is empty");
+        }
+        int top = heap[0];
+        return Pair<int, K>(top, priorities[top]);
+    }
+
+    /**
+     * @brief Уменьшает приоритет элемента, находящегося в очереди.
+     *
+     * @throws std::out_of_range Если элемента нет в очереди.
+     * @throws std::invalid_argument Если новый приоритет больше текущего.
+     */
+    void decreaseKey(int item, K priority) {
+        if (!contains(item)) {
+            throw std::out_of_range("Item not in queue");
+        }
+        if (priorities[item] < priority) {
+            throw std::invalid_argument("New priority is greater than current");
+        }
+        priorities[item] = priority;
+        siftUp(positions[item]);
+    }
+
+    /**
+     * @brief Проверяет, находится ли элемент в очереди.
+     */
+    bool contains(int item) const {
+        return item >= 0 && item < positions.getSize() && positions[item] != -1;
+    }
+
+    /**
+     * @brief Возвращает текущий приоритет элемента, находящегося в очереди.
+     *
+     * @throws std::out_of_range Если элемента нет в очереди.
+     */
+    K getPriority(int item) const {
+        if (!contains(item)) {
+            throw std::out_of_range("Item not in queue");
+        }
+        return priorities[item];
+    }
+
+    bool isEmpty() const {
+        return heap.getSize() == 0;
+    }
+
+    int size() const {
+        return heap.getSize();
+    }
+
+    /**
+     * @brief Очищает очередь за O(size), сохраняя выделенную память для повторного использования.
+     */
+    void clear() {
+        for (int i = 0; i < heap.getSize(); ++i) {
+            positions[heap[i]] = -1;
+        }
+        heap.clear();
+    }
+};
+
+#endif //LAB4_SEM3_INDEXEDPRIORITYQUEUE_H
@@ -88,17 +88,10 @@ public:
         if (data.getSize() == 0) {
             throw std::out_of_range("Queue is empty");
         }
-
-        auto it = data.begin();
-        for (int i = 0; i < index && it != data.end(); ++i) {
-            ++it;
-        }
-
-        if (it == data.end()) {
+        if (index < 0 || index >= data.getSize()) {
             throw std::out_of_range("Index out of range");
         }
-
-        return *it;
+        return data.select(index);
     }
 
     Pair<T, K> PeekFirst() const {